@@ -22,6 +22,47 @@
 namespace columnar
 {
 
+void MatchingBlocks_c::SetBits ( std::vector<uint64_t> && dBits )
+{
+	m_dBits = std::move(dBits);
+	UpdateFromBits();
+}
+
+
+void MatchingBlocks_c::And ( const MatchingBlocks_c & tRhs )
+{
+	m_dBits.resize ( std::min ( m_dBits.size(), tRhs.m_dBits.size() ) );
+	for ( size_t i = 0; i < m_dBits.size(); i++ )
+		m_dBits[i] &= tRhs.m_dBits[i];
+
+	UpdateFromBits();
+}
+
+
+void MatchingBlocks_c::Or ( const MatchingBlocks_c & tRhs )
+{
+	m_dBits.resize ( std::max ( m_dBits.size(), tRhs.m_dBits.size() ), 0 );
+	for ( size_t i = 0; i < tRhs.m_dBits.size(); i++ )
+		m_dBits[i] |= tRhs.m_dBits[i];
+
+	UpdateFromBits();
+}
+
+
+void MatchingBlocks_c::UpdateFromBits()
+{
+	m_dRanks.resize ( m_dBits.size() );
+	m_dBlocks.resize(0);
+
+	for ( size_t i = 0; i < m_dBits.size(); i++ )
+	{
+		m_dRanks[i] = (int)m_dBlocks.size();
+		for ( uint64_t uWord = m_dBits[i]; uWord; uWord &= uWord-1 )
+			m_dBlocks.push_back ( int ( ( i << 6 ) + util::BitScanForward(uWord) ) );
+	}
+}
+
+
 bool CheckEmptySpan ( uint32_t * pRowID, uint32_t * pRowIdStart, util::Span_T<uint32_t> & dRowIdBlock )
 {
 	if ( pRowID==pRowIdStart )
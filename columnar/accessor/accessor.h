@@ -23,20 +23,76 @@
 namespace columnar
 {
 
-// fixme: add bitmaps
+// matching subblocks (or minmax tree leaves) as a bitmap plus a list of their ids for iterating by index
 class MatchingBlocks_c
 {
 public:
 						MatchingBlocks_c() { m_dBlocks.reserve(1024); }
 
-	FORCE_INLINE void	Add ( int iBlock ) { m_dBlocks.push_back(iBlock); }
+	FORCE_INLINE void	Add ( int iBlock );
 	FORCE_INLINE int	GetBlock ( int iBlock ) const { return m_dBlocks[iBlock]; }
 	FORCE_INLINE int	GetNumBlocks() const { return (int)m_dBlocks.size(); }
 
+	FORCE_INLINE int	FindNext ( int iBlockId ) const;
+	FORCE_INLINE int	GetIndex ( int iBlockId ) const;
+
+	void				SetBits ( std::vector<uint64_t> && dBits );
+	void				And ( const MatchingBlocks_c & tRhs );
+	void				Or ( const MatchingBlocks_c & tRhs );
+
 private:
-	std::vector<int>	m_dBlocks;
+	std::vector<uint64_t>	m_dBits;	// one bit per block id
+	std::vector<int>	m_dRanks;		// number of matching blocks before each word of m_dBits
+	std::vector<int>	m_dBlocks;		// ids of matching blocks in ascending order
+
+	void				UpdateFromBits();
 };
 
+// blocks must be added in ascending order
+void MatchingBlocks_c::Add ( int iBlock )
+{
+	assert ( m_dBlocks.empty() || m_dBlocks.back()<iBlock );
+
+	int iWord = iBlock >> 6;
+	while ( (int)m_dBits.size()<=iWord )
+	{
+		m_dBits.push_back(0);
+		m_dRanks.push_back ( (int)m_dBlocks.size() );
+	}
+
+	m_dBits[iWord] |= 1ULL << ( iBlock & 63 );
+	m_dBlocks.push_back(iBlock);
+}
+
+// first matching block with id>=iBlockId; -1 if there's none
+int MatchingBlocks_c::FindNext ( int iBlockId ) const
+{
+	size_t tWord = iBlockId >> 6;
+	if ( tWord>=m_dBits.size() )
+		return -1;
+
+	uint64_t uWord = m_dBits[tWord] & ( UINT64_MAX << ( iBlockId & 63 ) );
+	while ( !uWord )
+	{
+		if ( ++tWord>=m_dBits.size() )
+			return -1;
+
+		uWord = m_dBits[tWord];
+	}
+
+	return int ( ( tWord << 6 ) + util::BitScanForward(uWord) );
+}
+
+// number of matching blocks with ids less than iBlockId (i.e. the index of that block if it matches)
+int MatchingBlocks_c::GetIndex ( int iBlockId ) const
+{
+	size_t tWord = iBlockId >> 6;
+	if ( tWord>=m_dBits.size() )
+		return GetNumBlocks();
+
+	return m_dRanks[tWord] + util::PopCount ( m_dBits[tWord] & ( ( 1ULL << ( iBlockId & 63 ) ) - 1 ) );
+}
+
 
 using SharedBlocks_c = std::shared_ptr<MatchingBlocks_c>;
 
@@ -44,6 +100,7 @@ class Analyzer_i : public common::BlockIterator_i
 {
 public:
 	virtual void	Setup ( SharedBlocks_c & pBlocks, uint32_t uTotalDocs ) = 0;
+	virtual void	SetLimits ( const AnalyzerLimits_t & tLimits ) = 0;
 };
 
 
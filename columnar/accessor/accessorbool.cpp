@@ -186,6 +186,7 @@ public:
 	int64_t		Get() final								{ return DoGet(); }
 
 	void		Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<int64_t> & dValues ) final;
+	void		Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<int64_t> & dOffsets, std::vector<uint8_t> & dData ) final { assert ( 0 && "INTERNAL ERROR: requesting batch blob from bool iterator" ); }
 
 	int			Get ( const uint8_t * & pData ) final	{ assert ( 0 && "INTERNAL ERROR: requesting blob from bool iterator" ); return 0; }
 	uint8_t *	GetPacked() final						{ assert ( 0 && "INTERNAL ERROR: requesting blob from bool iterator" ); return nullptr; }
@@ -342,7 +343,7 @@ private:
 
 template <bool HAVE_MATCHING_BLOCKS>
 Analyzer_Bool_T<HAVE_MATCHING_BLOCKS>::Analyzer_Bool_T ( const AttributeHeader_i & tHeader, FileReader_c * pReader, const Filter_t & tSettings )
-	: ANALYZER ( tHeader.GetSettings().m_iSubblockSize )
+	: ANALYZER ( tHeader, pReader )
 	, ACCESSOR ( tHeader, pReader )
 	, m_tBlockConst ( ANALYZER::m_tRowID )
 	, m_tBlockBitmap ( ANALYZER::m_tRowID )
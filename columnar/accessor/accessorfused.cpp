@@ -0,0 +1,226 @@
+// Copyright (c) 2020-2022, Manticore Software LTD (https://manticoresearch.com)
+// All rights reserved
+//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "accessorfused.h"
+#include "accessor.h"
+#include "columnar.h"
+#include "interval.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace columnar
+{
+
+using namespace util;
+using namespace common;
+
+static bool IsFusableType ( AttrType_e eType )
+{
+	switch ( eType )
+	{
+	case AttrType_e::UINT32:
+	case AttrType_e::TIMESTAMP:
+	case AttrType_e::INT64:
+	case AttrType_e::BOOLEAN:
+	case AttrType_e::FLOAT:
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+
+bool IsFilterFusable ( const Filter_t & tFilter, AttrType_e eType )
+{
+	if ( !IsFusableType(eType) )
+		return false;
+
+	Filter_t tFixed = tFilter;
+	FixupFilterSettings ( tFixed, eType );
+
+	switch ( tFixed.m_eType )
+	{
+	case FilterType_e::VALUES:		return !tFixed.m_dValues.empty() && eType!=AttrType_e::FLOAT;
+	case FilterType_e::RANGE:		return eType!=AttrType_e::FLOAT;
+	case FilterType_e::FLOATRANGE:	return eType==AttrType_e::FLOAT;
+	default:						return false;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+// evaluates a filter on fetched values and compacts the selection vector (row ids) in place
+class FusedFilter_c
+{
+public:
+			FusedFilter_c ( const Filter_t & tFilter, AttrType_e eType );
+
+	int		Apply ( uint32_t * pRowIDs, const int64_t * pValues, int iNum ) const;
+
+private:
+	Filter_t	m_tFilter;
+
+	template <typename ACCEPT>
+	FORCE_INLINE int Compact ( uint32_t * pRowIDs, const int64_t * pValues, int iNum, ACCEPT && fnAccept ) const;
+};
+
+
+FusedFilter_c::FusedFilter_c ( const Filter_t & tFilter, AttrType_e eType )
+	: m_tFilter ( tFilter )
+{
+	FixupFilterSettings ( m_tFilter, eType );
+	if ( m_tFilter.m_eType!=FilterType_e::VALUES )
+		return;
+
+	// fetched values are in the attribute's storage type, so the filter values are cast the same way the analyzers cast them
+	if ( eType==AttrType_e::UINT32 || eType==AttrType_e::TIMESTAMP )
+		for ( auto & i : m_tFilter.m_dValues )
+			i = (int64_t)(uint32_t)i;
+
+	std::sort ( m_tFilter.m_dValues.begin(), m_tFilter.m_dValues.end() );
+}
+
+template <typename ACCEPT>
+int FusedFilter_c::Compact ( uint32_t * pRowIDs, const int64_t * pValues, int iNum, ACCEPT && fnAccept ) const
+{
+	bool bExclude = m_tFilter.m_bExclude;
+	int iOut = 0;
+	for ( int i = 0; i < iNum; i++ )
+	{
+		pRowIDs[iOut] = pRowIDs[i];
+		iOut += fnAccept ( pValues[i] )!=bExclude;
+	}
+
+	return iOut;
+}
+
+
+int FusedFilter_c::Apply ( uint32_t * pRowIDs, const int64_t * pValues, int iNum ) const
+{
+	switch ( m_tFilter.m_eType )
+	{
+	case FilterType_e::VALUES:
+		if ( m_tFilter.m_dValues.size()==1 )
+		{
+			int64_t iValue = m_tFilter.m_dValues[0];
+			return Compact ( pRowIDs, pValues, iNum, [iValue]( int64_t iFetched ){ return iFetched==iValue; } );
+		}
+
+		return Compact ( pRowIDs, pValues, iNum, [this]( int64_t iFetched ){ return std::binary_search ( m_tFilter.m_dValues.begin(), m_tFilter.m_dValues.end(), iFetched ); } );
+
+	case FilterType_e::RANGE:
+		return Compact ( pRowIDs, pValues, iNum, [this]( int64_t iFetched ){ return ValueInInterval<int64_t> ( iFetched, m_tFilter ); } );
+
+	case FilterType_e::FLOATRANGE:
+		return Compact ( pRowIDs, pValues, iNum, [this]( int64_t iFetched ){ return ValueInInterval<float> ( UintToFloat ( (uint32_t)iFetched ), m_tFilter ); } );
+
+	default:
+		assert ( 0 && "Unsupported fused filter" );
+		return iNum;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+// runs the lead analyzer and evaluates the remaining filters only on rows that survived it
+class AnalyzerFused_c : public Analyzer_i
+{
+public:
+				AnalyzerFused_c ( Analyzer_i * pLead, const std::vector<FusedProbe_t> & dProbes );
+
+	void		Setup ( SharedBlocks_c & pBlocks, uint32_t uTotalDocs ) final	{ m_pLead->Setup ( pBlocks, uTotalDocs ); }
+	void		SetLimits ( const AnalyzerLimits_t & tLimits ) final			{ m_pLead->SetLimits(tLimits); m_bBounded = tLimits.IsBounded(); }
+	bool		HintRowID ( uint32_t tRowID ) final								{ return m_pLead->HintRowID(tRowID); }
+	bool		GetNextRowIdBlock ( Span_T<uint32_t> & dRowIdBlock ) final;
+	int64_t		GetNumProcessed() const final									{ return m_pLead->GetNumProcessed(); }
+	void		AddDesc ( std::vector<IteratorDesc_t> & dDesc ) const final;
+
+private:
+	struct Probe_t
+	{
+		std::unique_ptr<Iterator_i>	m_pIterator;
+		FusedFilter_c				m_tFilter;
+		std::string					m_sName;
+	};
+
+	std::unique_ptr<Analyzer_i>	m_pLead;
+	std::vector<Probe_t>		m_dProbes;
+	std::vector<uint32_t>		m_dRowIDs;
+	std::vector<int64_t>		m_dValues;
+	bool						m_bBounded = false;
+};
+
+
+AnalyzerFused_c::AnalyzerFused_c ( Analyzer_i * pLead, const std::vector<FusedProbe_t> & dProbes )
+	: m_pLead ( pLead )
+{
+	assert ( pLead );
+	for ( const auto & i : dProbes )
+		m_dProbes.push_back ( { std::unique_ptr<Iterator_i>(i.m_pIterator), FusedFilter_c ( i.m_tFilter, i.m_eType ), i.m_tFilter.m_sName } );
+}
+
+
+bool AnalyzerFused_c::GetNextRowIdBlock ( Span_T<uint32_t> & dRowIdBlock )
+{
+	Span_T<uint32_t> dLead;
+	while ( m_pLead->GetNextRowIdBlock(dLead) )
+	{
+		int iNum = (int)dLead.size();
+		m_dRowIDs.resize(iNum);
+		memcpy ( m_dRowIDs.data(), dLead.data(), iNum*sizeof(uint32_t) );
+		if ( m_dValues.size()<m_dRowIDs.size() )
+			m_dValues.resize ( m_dRowIDs.size() );
+
+		// each probe only fetches values for rows that passed all previous filters
+		for ( auto & tProbe : m_dProbes )
+		{
+			Span_T<uint32_t> dRowIDs ( m_dRowIDs.data(), iNum );
+			Span_T<int64_t> dValues ( m_dValues.data(), iNum );
+			tProbe.m_pIterator->Fetch ( dRowIDs, dValues );
+			iNum = tProbe.m_tFilter.Apply ( m_dRowIDs.data(), m_dValues.data(), iNum );
+			if ( !iNum )
+				break;
+		}
+
+		// a bounded lead has done its share of work; empty blocks are fine in this mode
+		if ( iNum || m_bBounded )
+		{
+			dRowIdBlock = Span_T<uint32_t> ( m_dRowIDs.data(), iNum );
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+void AnalyzerFused_c::AddDesc ( std::vector<IteratorDesc_t> & dDesc ) const
+{
+	m_pLead->AddDesc(dDesc);
+	for ( const auto & i : m_dProbes )
+		dDesc.push_back ( { i.m_sName, "fused" } );
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+Analyzer_i * CreateAnalyzerFused ( Analyzer_i * pLead, const std::vector<FusedProbe_t> & dProbes )
+{
+	return new AnalyzerFused_c ( pLead, dProbes );
+}
+
+} // namespace columnar
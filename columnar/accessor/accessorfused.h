@@ -0,0 +1,40 @@
+// Copyright (c) 2020-2022, Manticore Software LTD (https://manticoresearch.com)
+// All rights reserved
+//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "filter.h"
+
+namespace columnar
+{
+
+class Iterator_i;
+class Analyzer_i;
+
+// a filter that is evaluated on values fetched for rows that passed the previous filters
+struct FusedProbe_t
+{
+	Iterator_i *		m_pIterator = nullptr;
+	common::Filter_t	m_tFilter;
+	common::AttrType_e	m_eType = common::AttrType_e::NONE;
+};
+
+bool			IsFilterFusable ( const common::Filter_t & tFilter, common::AttrType_e eType );
+
+// takes ownership of the lead analyzer and of probe iterators
+Analyzer_i *	CreateAnalyzerFused ( Analyzer_i * pLead, const std::vector<FusedProbe_t> & dProbes );
+
+} // namespace columnar
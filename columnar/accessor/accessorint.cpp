@@ -19,8 +19,10 @@
 #include "accessortraits.h"
 #include "builderint.h"
 #include "interval.h"
+#include "filterkernels.h"
 #include "reader.h"
 #include "check.h"
+#include "subblockcache.h"
 
 #include <algorithm>
 #include <tuple>
@@ -56,8 +58,11 @@ public:
 
 	FORCE_INLINE void		ReadHeader ( FileReader_c & tReader );
 	FORCE_INLINE void		ReadSubblock ( int iSubblockId, int iNumValues, FileReader_c & tReader );
+	FORCE_INLINE void		ReadSubblockPacked ( int iSubblockId, FileReader_c & tReader );
 	FORCE_INLINE T			GetValue ( int iIdInSubblock );
 	FORCE_INLINE const Span_T<uint32_t> & GetValueIndexes() const { return m_tValuesRead; }
+	FORCE_INLINE Span_T<uint32_t> GetPackedValueIndexes() const { return Span_T<uint32_t> ( (uint32_t*)m_dEncoded.data(), m_dEncoded.size() ); }
+	FORCE_INLINE int		GetNumBits() const { return m_iBits; }
 	FORCE_INLINE int		GetIndexInTable ( T tValue ) const;
 	FORCE_INLINE T			GetValueFromTable ( uint8_t uIndex ) const { return m_dTableValues[uIndex]; }
 	FORCE_INLINE int		GetTableSize() const { return (int)m_dTableValues.size(); }
@@ -70,6 +75,7 @@ private:
 	int						m_iBits = 0;
 	int64_t					m_iValuesOffset = 0;
 	int						m_iSubblockId = -1;
+	bool					m_bUnpacked = false;
 	Span_T<uint32_t>		m_tValuesRead;
 	SpanResizeable_T<uint32_t> m_dTmp;
 };
@@ -99,18 +105,29 @@ void StoredBlock_Int_Table_T<T>::ReadHeader ( FileReader_c & tReader )
 
 template <typename T>
 void StoredBlock_Int_Table_T<T>::ReadSubblock ( int iSubblockId, int iNumValues, FileReader_c & tReader )
+{
+	ReadSubblockPacked ( iSubblockId, tReader );
+	if ( m_bUnpacked )
+		return;
+
+	BitUnpack ( m_dEncoded, m_dValueIndexes, m_iBits );
+	m_tValuesRead = { m_dValueIndexes.data(), (size_t)iNumValues };
+	m_bUnpacked = true;
+}
+
+// analyzers work with packed value indexes; they are unpacked only when values are fetched
+template <typename T>
+void StoredBlock_Int_Table_T<T>::ReadSubblockPacked ( int iSubblockId, FileReader_c & tReader )
 {
 	if ( m_iSubblockId==iSubblockId )
 		return;
 
 	m_iSubblockId = iSubblockId;
+	m_bUnpacked = false;
 
 	size_t uPackedSize = m_dEncoded.size()*sizeof ( m_dEncoded[0] );
 	tReader.Seek ( m_iValuesOffset + uPackedSize*iSubblockId );
 	tReader.Read ( (uint8_t*)m_dEncoded.data(), uPackedSize );
-	BitUnpack ( m_dEncoded, m_dValueIndexes, m_iBits );
-
-	m_tValuesRead = { m_dValueIndexes.data(), (size_t)iNumValues };
 }
 
 template <typename T>
@@ -140,9 +157,12 @@ public:
 	FORCE_INLINE void		ReadHeader ( FileReader_c & tReader );
 	FORCE_INLINE void		ReadSubblock_Delta ( int iSubblockId, FileReader_c & tReader );
 	FORCE_INLINE void		ReadSubblock_Generic ( int iSubblockId, FileReader_c & tReader );
+	FORCE_INLINE void		ReadSubblock_DeltaDelta ( int iSubblockId, FileReader_c & tReader );
 	FORCE_INLINE void		ReadSubblock_Hash ( int iSubblockId, FileReader_c & tReader, int iNumSubblockValues );
 	FORCE_INLINE T			GetValue ( int iIdInSubblock ) const;
-	FORCE_INLINE const Span_T<T> & GetAllValues() const { return m_dSubblockValues; }
+	FORCE_INLINE const Span_T<T> & GetAllValues() const { return m_tSubblockValues; }
+	FORCE_INLINE bool		IsSubblockSorted() const { return m_bSubblockSorted; }
+	FORCE_INLINE void		SetCacheKey ( uint64_t uAttrUID, uint32_t uBlockId ) { m_tCacheKey = { uAttrUID, uBlockId, 0, sizeof(T) }; }
 
 private:
 	std::unique_ptr<IntCodec_i>	m_pCodec;
@@ -154,6 +174,11 @@ private:
 
 	int							m_iSubblockId = -1;
 	SpanResizeable_T<T>			m_dSubblockValues;
+	Span_T<T>					m_tSubblockValues;	// points either to m_dSubblockValues or to a cached subblock
+	bool						m_bSubblockSorted = false;
+
+	SubblockCacheKey_t			m_tCacheKey;
+	CachedSubblockPtr_t			m_pCachedSubblock;
 
 	template <typename DECOMPRESS>
 	FORCE_INLINE void		ReadSubblock ( int iSubblockId, FileReader_c & tReader, DECOMPRESS && fnDecompress );
@@ -187,6 +212,14 @@ void StoredBlock_Int_PFOR_T<T>::ReadSubblock_Generic ( int iSubblockId, FileRead
 	);
 }
 
+template <typename T>
+void StoredBlock_Int_PFOR_T<T>::ReadSubblock_DeltaDelta ( int iSubblockId, FileReader_c & tReader )
+{
+	ReadSubblock ( iSubblockId, tReader, [this] ( SpanResizeable_T<T> & dValues, FileReader_c & tReader, uint32_t uTotalSize )
+		{ DecodeValues_DeltaDelta_PFOR ( dValues, tReader, *m_pCodec, m_dTmp, uTotalSize, m_bSubblockSorted ); }
+	);
+}
+
 template <typename T>
 void StoredBlock_Int_PFOR_T<T>::ReadSubblock_Hash ( int iSubblockId, FileReader_c & tReader, int iNumSubblockValues )
 {
@@ -212,14 +245,33 @@ void StoredBlock_Int_PFOR_T<T>::ReadSubblock ( int iSubblockId, FileReader_c & t
 		uSize -= uOffset;
 	}
 
+	SubblockCache_i * pCache = GetSubblockCache();
+	if ( pCache )
+	{
+		m_tCacheKey.m_uSubblockId = iSubblockId;
+		m_pCachedSubblock = pCache->Find(m_tCacheKey);
+		if ( m_pCachedSubblock )
+		{
+			m_tSubblockValues = GetCachedValues<T>(*m_pCachedSubblock);
+			m_bSubblockSorted = !!m_pCachedSubblock->m_uFlags;
+			return;
+		}
+	}
+	else
+		m_pCachedSubblock.reset();
+
 	tReader.Seek ( m_tValuesOffset+uOffset );
 	fnDecompress ( m_dSubblockValues, tReader, uSize );
+	m_tSubblockValues = m_dSubblockValues;
+
+	if ( pCache )
+		pCache->Add ( m_tCacheKey, CreateCachedSubblock ( m_tSubblockValues, m_bSubblockSorted ? 1 : 0 ) );
 }
 
 template <typename T>
 T StoredBlock_Int_PFOR_T<T>::GetValue ( int iIdInSubblock ) const
 {
-	return m_dSubblockValues[iIdInSubblock];
+	return m_tSubblockValues[iIdInSubblock];
 }
 
 template <typename T>
@@ -265,6 +317,270 @@ void StoredBlock_Int_PFOR_T<T>::ReadHashesWithNullMap ( FileReader_c & tReader,
 
 //////////////////////////////////////////////////////////////////////////
 
+template <typename T>
+class StoredBlock_Int_FOR_T
+{
+public:
+	FORCE_INLINE void		ReadHeader ( FileReader_c & tReader );
+	FORCE_INLINE void		ReadSubblock ( int iSubblockId, int iSubblockSize, int iNumValues, FileReader_c & tReader );
+	FORCE_INLINE T			GetValue ( uint32_t uIdInBlock, FileReader_c & tReader ) const;
+	FORCE_INLINE const Span_T<T> & GetAllValues() const { return m_dSubblockValues; }
+
+private:
+	T						m_tMin = 0;
+	int						m_iBits = 0;
+	int64_t					m_iValuesOffset = 0;
+	int						m_iSubblockId = -1;
+	std::vector<uint64_t>	m_dPacked;
+	SpanResizeable_T<T>		m_dSubblockValues;
+};
+
+template <typename T>
+void StoredBlock_Int_FOR_T<T>::ReadHeader ( FileReader_c & tReader )
+{
+	m_tMin = (T)tReader.Unpack_uint64();
+	m_iBits = tReader.Read_uint8();
+	m_iValuesOffset = tReader.GetPos();
+	m_iSubblockId = -1;
+}
+
+template <typename T>
+void StoredBlock_Int_FOR_T<T>::ReadSubblock ( int iSubblockId, int iSubblockSize, int iNumValues, FileReader_c & tReader )
+{
+	if ( m_iSubblockId==iSubblockId )
+		return;
+
+	m_iSubblockId = iSubblockId;
+	m_dSubblockValues.resize(iNumValues);
+
+	// subblock size is a multiple of 128, so subblocks always start at a word boundary
+	m_dPacked.resize ( ( (size_t)iNumValues*m_iBits + 63 ) >> 6 );
+	size_t tWordsPerSubblock = ( (size_t)iSubblockSize*m_iBits ) >> 6;
+	tReader.Seek ( m_iValuesOffset + tWordsPerSubblock*iSubblockId*sizeof(uint64_t) );
+	tReader.Read ( (uint8_t*)m_dPacked.data(), m_dPacked.size()*sizeof(m_dPacked[0]) );
+
+	UnpackFOR ( m_dPacked.data(), m_dSubblockValues, m_iBits, m_tMin );
+}
+
+template <typename T>
+T StoredBlock_Int_FOR_T<T>::GetValue ( uint32_t uIdInBlock, FileReader_c & tReader ) const
+{
+	if ( !m_iBits )
+		return m_tMin;
+
+	uint64_t uBit = (uint64_t)uIdInBlock*m_iBits;
+	int iShift = int ( uBit & 63 );
+	tReader.Seek ( m_iValuesOffset + ( uBit>>6 )*sizeof(uint64_t) );
+
+	uint64_t uLo = tReader.Read_uint64();
+	uint64_t uHi = iShift+m_iBits > 64 ? tReader.Read_uint64() : 0;
+	return m_tMin + (T)UnpackValueFOR ( uLo, uHi, iShift, m_iBits );
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+class StoredBlock_Float_Decimal_T
+{
+public:
+	FORCE_INLINE void		ReadHeader ( FileReader_c & tReader );
+	FORCE_INLINE void		ReadSubblock ( int iSubblockId, int iSubblockSize, int iNumValues, FileReader_c & tReader );
+	FORCE_INLINE T			GetValue ( uint32_t uIdInBlock, FileReader_c & tReader ) const;
+	FORCE_INLINE const Span_T<T> & GetAllValues() const { return m_dSubblockValues; }
+
+private:
+	int						m_iExponent = 0;
+	std::vector<uint32_t>	m_dExceptionRows;
+	std::vector<uint32_t>	m_dExceptionValues;
+	StoredBlock_Int_FOR_T<int64_t> m_tDecimals;
+	int						m_iSubblockId = -1;
+	SpanResizeable_T<T>		m_dSubblockValues;
+};
+
+template <typename T>
+void StoredBlock_Float_Decimal_T<T>::ReadHeader ( FileReader_c & tReader )
+{
+	m_iExponent = tReader.Read_uint8();
+
+	uint32_t uNumExceptions = tReader.Unpack_uint32();
+	m_dExceptionRows.resize(uNumExceptions);
+	uint32_t uRow = 0;
+	for ( auto & i : m_dExceptionRows )
+	{
+		uRow += tReader.Unpack_uint32();
+		i = uRow;
+	}
+
+	m_dExceptionValues.resize(uNumExceptions);
+	for ( auto & i : m_dExceptionValues )
+		i = tReader.Read_uint32();
+
+	m_tDecimals.ReadHeader(tReader);
+	m_iSubblockId = -1;
+}
+
+template <typename T>
+void StoredBlock_Float_Decimal_T<T>::ReadSubblock ( int iSubblockId, int iSubblockSize, int iNumValues, FileReader_c & tReader )
+{
+	if ( m_iSubblockId==iSubblockId )
+		return;
+
+	m_iSubblockId = iSubblockId;
+	m_tDecimals.ReadSubblock ( iSubblockId, iSubblockSize, iNumValues, tReader );
+
+	const auto & dDecimals = m_tDecimals.GetAllValues();
+	m_dSubblockValues.resize(iNumValues);
+	for ( int i = 0; i < iNumValues; i++ )
+		m_dSubblockValues[i] = (T)FloatToUint ( DecimalToFloat ( dDecimals[i], m_iExponent ) );
+
+	// patch the exceptions
+	uint32_t uStart = uint32_t(iSubblockId)*iSubblockSize;
+	uint32_t uEnd = uStart + iNumValues;
+	auto tFirst = std::lower_bound ( m_dExceptionRows.begin(), m_dExceptionRows.end(), uStart );
+	for ( auto tIt = tFirst; tIt!=m_dExceptionRows.end() && *tIt<uEnd; ++tIt )
+		m_dSubblockValues[*tIt-uStart] = (T)m_dExceptionValues [ tIt-m_dExceptionRows.begin() ];
+}
+
+template <typename T>
+T StoredBlock_Float_Decimal_T<T>::GetValue ( uint32_t uIdInBlock, FileReader_c & tReader ) const
+{
+	auto tFound = std::lower_bound ( m_dExceptionRows.begin(), m_dExceptionRows.end(), uIdInBlock );
+	if ( tFound!=m_dExceptionRows.end() && *tFound==uIdInBlock )
+		return (T)m_dExceptionValues [ tFound-m_dExceptionRows.begin() ];
+
+	return (T)FloatToUint ( DecimalToFloat ( m_tDecimals.GetValue ( uIdInBlock, tReader ), m_iExponent ) );
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+class StoredBlock_Int_RLE_T
+{
+public:
+							StoredBlock_Int_RLE_T ( int iSubblockSize, const std::string & sCodec32, const std::string & sCodec64 );
+
+	FORCE_INLINE void		ReadHeader ( FileReader_c & tReader );
+	FORCE_INLINE T			GetValue ( uint32_t uIdInBlock ) { return m_dRunValues [ m_tRuns.GetRun(uIdInBlock) ]; }
+	FORCE_INLINE const Span_T<T> & GetRunValues() const { return m_dRunValues; }
+	FORCE_INLINE const StoredBlock_Runs_c & GetRuns() const { return m_tRuns; }
+
+private:
+	std::unique_ptr<IntCodec_i>	m_pCodec;
+	StoredBlock_Runs_c		m_tRuns;
+	SpanResizeable_T<T>		m_dRunValues;
+	SpanResizeable_T<uint32_t> m_dTmp;
+};
+
+template <typename T>
+StoredBlock_Int_RLE_T<T>::StoredBlock_Int_RLE_T ( int iSubblockSize, const std::string & sCodec32, const std::string & sCodec64 )
+	: m_pCodec ( CreateIntCodec ( sCodec32, sCodec64 ) )
+	, m_tRuns ( iSubblockSize, sCodec32, sCodec64 )
+{}
+
+template <typename T>
+void StoredBlock_Int_RLE_T<T>::ReadHeader ( FileReader_c & tReader )
+{
+	m_tRuns.ReadHeader(tReader);
+
+	uint32_t uTotalSize = (uint32_t)tReader.Unpack_uint64();
+	DecodeValues_PFOR ( m_dRunValues, tReader, *m_pCodec, m_dTmp, uTotalSize );
+	assert ( (int)m_dRunValues.size()==m_tRuns.GetNumRuns() );
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+class StoredBlock_Int_Dict_c
+{
+public:
+	explicit				StoredBlock_Int_Dict_c ( int iSubblockSize );
+
+	FORCE_INLINE void		ReadHeader ( FileReader_c & tReader );
+	FORCE_INLINE void		ReadSubblock ( int iSubblockId, int iNumValues, FileReader_c & tReader );
+	FORCE_INLINE uint32_t	GetOrdinal ( int iIdInSubblock ) const { return m_dOrdinals[iIdInSubblock]; }
+	FORCE_INLINE const Span_T<uint32_t> & GetOrdinals() const { return m_tOrdinalsRead; }
+
+private:
+	std::vector<uint32_t>	m_dOrdinals;
+	std::vector<uint32_t>	m_dEncoded;
+	int						m_iBits = 0;
+	int64_t					m_iValuesOffset = 0;
+	int						m_iSubblockId = -1;
+	Span_T<uint32_t>		m_tOrdinalsRead;
+};
+
+
+StoredBlock_Int_Dict_c::StoredBlock_Int_Dict_c ( int iSubblockSize )
+{
+	assert ( !( iSubblockSize & 127 ) );
+	m_dOrdinals.resize(iSubblockSize);
+}
+
+
+void StoredBlock_Int_Dict_c::ReadHeader ( FileReader_c & tReader )
+{
+	m_iBits = tReader.Read_uint8();
+	m_dEncoded.resize ( ( m_dOrdinals.size() >> 5 ) * m_iBits );
+	m_iValuesOffset = tReader.GetPos();
+	m_iSubblockId = -1;
+}
+
+
+void StoredBlock_Int_Dict_c::ReadSubblock ( int iSubblockId, int iNumValues, FileReader_c & tReader )
+{
+	if ( m_iSubblockId==iSubblockId )
+		return;
+
+	m_iSubblockId = iSubblockId;
+
+	size_t uPackedSize = m_dEncoded.size()*sizeof ( m_dEncoded[0] );
+	tReader.Seek ( m_iValuesOffset + uPackedSize*iSubblockId );
+	tReader.Read ( (uint8_t*)m_dEncoded.data(), uPackedSize );
+	BitUnpack ( m_dEncoded, m_dOrdinals, m_iBits );
+
+	m_tOrdinalsRead = { m_dOrdinals.data(), (size_t)iNumValues };
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+// per-block sorted table of unique hashes + bitpacked ordinals
+template <typename T>
+class StoredBlock_Int_HashTable_T
+{
+public:
+							StoredBlock_Int_HashTable_T ( int iSubblockSize, const std::string & sCodec32, const std::string & sCodec64 );
+
+	FORCE_INLINE void		ReadHeader ( FileReader_c & tReader );
+	FORCE_INLINE void		ReadSubblock ( int iSubblockId, int iNumValues, FileReader_c & tReader ) { m_tOrdinals.ReadSubblock ( iSubblockId, iNumValues, tReader ); }
+	FORCE_INLINE T			GetValue ( int iIdInSubblock ) const { return m_dTable [ m_tOrdinals.GetOrdinal(iIdInSubblock) ]; }
+	FORCE_INLINE const Span_T<uint32_t> & GetOrdinals() const { return m_tOrdinals.GetOrdinals(); }
+	FORCE_INLINE const Span_T<T> & GetTable() const { return m_dTable; }
+
+private:
+	std::unique_ptr<IntCodec_i>	m_pCodec;
+	SpanResizeable_T<T>		m_dTable;
+	SpanResizeable_T<uint32_t> m_dTmp;
+	StoredBlock_Int_Dict_c	m_tOrdinals;
+};
+
+template <typename T>
+StoredBlock_Int_HashTable_T<T>::StoredBlock_Int_HashTable_T ( int iSubblockSize, const std::string & sCodec32, const std::string & sCodec64 )
+	: m_pCodec ( CreateIntCodec ( sCodec32, sCodec64 ) )
+	, m_tOrdinals ( iSubblockSize )
+{}
+
+template <typename T>
+void StoredBlock_Int_HashTable_T<T>::ReadHeader ( FileReader_c & tReader )
+{
+	m_dTable.resize ( tReader.Unpack_uint32() );
+
+	uint32_t uTotalSize = tReader.Unpack_uint32();
+	DecodeValues_Delta_PFOR ( m_dTable, tReader, *m_pCodec, m_dTmp, uTotalSize, false );
+
+	m_tOrdinals.ReadHeader(tReader);
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 template<typename T>
 class Accessor_INT_T : public StoredBlockTraits_t
 {
@@ -278,10 +594,17 @@ protected:
 	StoredBlock_Int_Const_T<T>		m_tBlockConst;
 	StoredBlock_Int_Table_T<T>		m_tBlockTable;
 	StoredBlock_Int_PFOR_T<T>		m_tBlockPFOR;
+	StoredBlock_Int_FOR_T<T>		m_tBlockFOR;
+	StoredBlock_Float_Decimal_T<T>	m_tBlockDecimal;
+	StoredBlock_Int_Dict_c			m_tBlockDict;
+	StoredBlock_Int_HashTable_T<T>	m_tBlockHashTable;
+	StoredBlock_Int_RLE_T<T>		m_tBlockRLE;
+	const std::vector<uint64_t> &	m_dDictionary;
 
 	int64_t (Accessor_INT_T<T>::*m_fnReadValue)() = nullptr;
 
 	IntPacking_e	m_ePacking = IntPacking_e::CONST;
+	IntHashPacking_e m_eHashPacking = IntHashPacking_e::RAW;
 
 	FORCE_INLINE void SetCurBlock ( uint32_t uBlockId );
 
@@ -290,6 +613,14 @@ protected:
 	int64_t			ReadValue_Delta();
 	int64_t			ReadValue_Generic();
 	int64_t			ReadValue_Hash();
+	int64_t			ReadValue_HashTable();
+	int64_t			ReadValue_FOR();
+	int64_t			ReadValue_Dict();
+	int64_t			ReadValue_Decimal();
+	int64_t			ReadValue_DeltaDelta();
+	int64_t			ReadValue_RLE();
+
+	FORCE_INLINE void FetchSubblock ( int iSubblockId, const uint32_t * pRowID, const uint32_t * pRowIDEnd, int64_t * pValue );
 };
 
 template<typename T>
@@ -299,6 +630,10 @@ Accessor_INT_T<T>::Accessor_INT_T ( const AttributeHeader_i & tHeader, FileReade
 	, m_pReader ( pReader )
 	, m_tBlockTable ( tHeader.GetSettings().m_iSubblockSize, tHeader.GetSettings().m_sCompressionUINT32, tHeader.GetSettings().m_sCompressionUINT64 )
 	, m_tBlockPFOR ( tHeader.GetSettings().m_sCompressionUINT32, tHeader.GetSettings().m_sCompressionUINT64 )
+	, m_tBlockDict ( tHeader.GetSettings().m_iSubblockSize )
+	, m_tBlockHashTable ( tHeader.GetSettings().m_iSubblockSize, tHeader.GetSettings().m_sCompressionUINT32, tHeader.GetSettings().m_sCompressionUINT64 )
+	, m_tBlockRLE ( tHeader.GetSettings().m_iSubblockSize, tHeader.GetSettings().m_sCompressionUINT32, tHeader.GetSettings().m_sCompressionUINT64 )
+	, m_dDictionary ( tHeader.GetDictionary() )
 {
 	assert(pReader);
 }
@@ -310,6 +645,7 @@ void Accessor_INT_T<T>::SetCurBlock ( uint32_t uBlockId )
 	m_ePacking = (IntPacking_e)m_pReader->Unpack_uint32();
 
 	m_tRequestedRowID = INVALID_ROW_ID;
+	m_tBlockPFOR.SetCacheKey ( m_tHeader.GetUID(), uBlockId );
 
 	switch ( m_ePacking )
 	{
@@ -334,10 +670,44 @@ void Accessor_INT_T<T>::SetCurBlock ( uint32_t uBlockId )
 		break;
 
 	case IntPacking_e::HASH:
-		m_fnReadValue = &Accessor_INT_T<T>::ReadValue_Hash;
+		m_eHashPacking = (IntHashPacking_e)m_pReader->Read_uint8();
+		if ( m_eHashPacking==IntHashPacking_e::TABLE )
+		{
+			m_fnReadValue = &Accessor_INT_T<T>::ReadValue_HashTable;
+			m_tBlockHashTable.ReadHeader ( *m_pReader );
+		}
+		else
+		{
+			m_fnReadValue = &Accessor_INT_T<T>::ReadValue_Hash;
+			m_tBlockPFOR.ReadHeader ( *m_pReader );
+		}
+		break;
+
+	case IntPacking_e::FOR:
+		m_fnReadValue = &Accessor_INT_T<T>::ReadValue_FOR;
+		m_tBlockFOR.ReadHeader ( *m_pReader );
+		break;
+
+	case IntPacking_e::DICT:
+		m_fnReadValue = &Accessor_INT_T<T>::ReadValue_Dict;
+		m_tBlockDict.ReadHeader ( *m_pReader );
+		break;
+
+	case IntPacking_e::DECIMAL:
+		m_fnReadValue = &Accessor_INT_T<T>::ReadValue_Decimal;
+		m_tBlockDecimal.ReadHeader ( *m_pReader );
+		break;
+
+	case IntPacking_e::DELTA_DELTA:
+		m_fnReadValue = &Accessor_INT_T<T>::ReadValue_DeltaDelta;
 		m_tBlockPFOR.ReadHeader ( *m_pReader );
 		break;
 
+	case IntPacking_e::RLE:
+		m_fnReadValue = &Accessor_INT_T<T>::ReadValue_RLE;
+		m_tBlockRLE.ReadHeader ( *m_pReader );
+		break;
+
 	default:
 		assert ( 0 && "Packing not implemented yet" );
 	}
@@ -376,6 +746,20 @@ int64_t Accessor_INT_T<T>::ReadValue_Generic()
 	return m_tBlockPFOR.GetValue ( GetValueIdInSubblock(uIdInBlock) );
 }
 
+template<typename T>
+int64_t Accessor_INT_T<T>::ReadValue_DeltaDelta()
+{
+	uint32_t uIdInBlock = m_tRequestedRowID - m_tStartBlockRowId;
+	m_tBlockPFOR.ReadSubblock_DeltaDelta ( GetSubblockId(uIdInBlock), *m_pReader );
+	return m_tBlockPFOR.GetValue ( GetValueIdInSubblock(uIdInBlock) );
+}
+
+template<typename T>
+int64_t Accessor_INT_T<T>::ReadValue_RLE()
+{
+	return m_tBlockRLE.GetValue ( m_tRequestedRowID - m_tStartBlockRowId );
+}
+
 template<typename T>
 int64_t Accessor_INT_T<T>::ReadValue_Hash()
 {
@@ -385,6 +769,151 @@ int64_t Accessor_INT_T<T>::ReadValue_Hash()
 	return m_tBlockPFOR.GetValue ( GetValueIdInSubblock(uIdInBlock) );
 }
 
+template<typename T>
+int64_t Accessor_INT_T<T>::ReadValue_HashTable()
+{
+	uint32_t uIdInBlock = m_tRequestedRowID - m_tStartBlockRowId;
+	int iSubblockId = GetSubblockId(uIdInBlock);
+	m_tBlockHashTable.ReadSubblock ( iSubblockId, StoredBlockTraits_t::GetNumSubblockValues(iSubblockId), *m_pReader );
+	return m_tBlockHashTable.GetValue ( GetValueIdInSubblock(uIdInBlock) );
+}
+
+template<typename T>
+int64_t Accessor_INT_T<T>::ReadValue_FOR()
+{
+	// no need to decode the whole subblock, just fetch the value
+	return m_tBlockFOR.GetValue ( m_tRequestedRowID - m_tStartBlockRowId, *m_pReader );
+}
+
+template<typename T>
+int64_t Accessor_INT_T<T>::ReadValue_Dict()
+{
+	uint32_t uIdInBlock = m_tRequestedRowID - m_tStartBlockRowId;
+	int iSubblockId = GetSubblockId(uIdInBlock);
+	m_tBlockDict.ReadSubblock ( iSubblockId, StoredBlockTraits_t::GetNumSubblockValues(iSubblockId), *m_pReader );
+
+	uint32_t uOrdinal = m_tBlockDict.GetOrdinal ( GetValueIdInSubblock(uIdInBlock) );
+	assert ( uOrdinal<m_dDictionary.size() );
+	return (T)m_dDictionary[uOrdinal];
+}
+
+template<typename T>
+int64_t Accessor_INT_T<T>::ReadValue_Decimal()
+{
+	return m_tBlockDecimal.GetValue ( m_tRequestedRowID - m_tStartBlockRowId, *m_pReader );
+}
+
+// gathers values of rowids that belong to the same (already decoded) subblock
+template <typename T>
+FORCE_INLINE void GatherValues ( const T * pValues, uint32_t tSubblockStart, const uint32_t * pRowID, const uint32_t * pRowIDEnd, int64_t * pValue )
+{
+	while ( pRowID<pRowIDEnd )
+		*pValue++ = pValues [ *pRowID++ - tSubblockStart ];
+}
+
+// fetches values of rowids from one subblock of the current block; decodes the subblock once
+template<typename T>
+void Accessor_INT_T<T>::FetchSubblock ( int iSubblockId, const uint32_t * pRowID, const uint32_t * pRowIDEnd, int64_t * pValue )
+{
+	// per-value access is cheaper than unpacking the whole subblock when there are only a few rows
+	const int SPARSE_FETCH_RATIO = 32;
+
+	int iNumValues = StoredBlockTraits_t::GetNumSubblockValues(iSubblockId);
+	uint32_t tSubblockStart = m_tStartBlockRowId + StoredBlockTraits_t::SubblockId2RowId(iSubblockId);
+	bool bSparse = int ( pRowIDEnd-pRowID )*SPARSE_FETCH_RATIO < iNumValues;
+
+	switch ( m_ePacking )
+	{
+	case IntPacking_e::CONST:
+		std::fill ( pValue, pValue + ( pRowIDEnd-pRowID ), (int64_t)m_tBlockConst.GetValue() );
+		break;
+
+	case IntPacking_e::TABLE:
+	{
+		m_tBlockTable.ReadSubblock ( iSubblockId, iNumValues, *m_pReader );
+		const uint32_t * pIndexes = m_tBlockTable.GetValueIndexes().data();
+		while ( pRowID<pRowIDEnd )
+			*pValue++ = m_tBlockTable.GetValueFromTable ( (uint8_t)pIndexes [ *pRowID++ - tSubblockStart ] );
+	}
+	break;
+
+	case IntPacking_e::DELTA:
+		m_tBlockPFOR.ReadSubblock_Delta ( iSubblockId, *m_pReader );
+		GatherValues ( m_tBlockPFOR.GetAllValues().data(), tSubblockStart, pRowID, pRowIDEnd, pValue );
+		break;
+
+	case IntPacking_e::GENERIC:
+		m_tBlockPFOR.ReadSubblock_Generic ( iSubblockId, *m_pReader );
+		GatherValues ( m_tBlockPFOR.GetAllValues().data(), tSubblockStart, pRowID, pRowIDEnd, pValue );
+		break;
+
+	case IntPacking_e::DELTA_DELTA:
+		m_tBlockPFOR.ReadSubblock_DeltaDelta ( iSubblockId, *m_pReader );
+		GatherValues ( m_tBlockPFOR.GetAllValues().data(), tSubblockStart, pRowID, pRowIDEnd, pValue );
+		break;
+
+	case IntPacking_e::HASH:
+		if ( m_eHashPacking==IntHashPacking_e::TABLE )
+		{
+			m_tBlockHashTable.ReadSubblock ( iSubblockId, iNumValues, *m_pReader );
+			const uint32_t * pOrdinals = m_tBlockHashTable.GetOrdinals().data();
+			const T * pTable = m_tBlockHashTable.GetTable().data();
+			while ( pRowID<pRowIDEnd )
+				*pValue++ = pTable [ pOrdinals [ *pRowID++ - tSubblockStart ] ];
+		}
+		else
+		{
+			m_tBlockPFOR.ReadSubblock_Hash ( iSubblockId, *m_pReader, iNumValues );
+			GatherValues ( m_tBlockPFOR.GetAllValues().data(), tSubblockStart, pRowID, pRowIDEnd, pValue );
+		}
+		break;
+
+	case IntPacking_e::FOR:
+		if ( bSparse )
+		{
+			while ( pRowID<pRowIDEnd )
+				*pValue++ = m_tBlockFOR.GetValue ( *pRowID++ - m_tStartBlockRowId, *m_pReader );
+		}
+		else
+		{
+			m_tBlockFOR.ReadSubblock ( iSubblockId, m_iSubblockSize, iNumValues, *m_pReader );
+			GatherValues ( m_tBlockFOR.GetAllValues().data(), tSubblockStart, pRowID, pRowIDEnd, pValue );
+		}
+		break;
+
+	case IntPacking_e::DICT:
+	{
+		m_tBlockDict.ReadSubblock ( iSubblockId, iNumValues, *m_pReader );
+		const uint32_t * pOrdinals = m_tBlockDict.GetOrdinals().data();
+		const uint64_t * pDictionary = m_dDictionary.data();
+		while ( pRowID<pRowIDEnd )
+			*pValue++ = (T)pDictionary [ pOrdinals [ *pRowID++ - tSubblockStart ] ];
+	}
+	break;
+
+	case IntPacking_e::DECIMAL:
+		if ( bSparse )
+		{
+			while ( pRowID<pRowIDEnd )
+				*pValue++ = m_tBlockDecimal.GetValue ( *pRowID++ - m_tStartBlockRowId, *m_pReader );
+		}
+		else
+		{
+			m_tBlockDecimal.ReadSubblock ( iSubblockId, m_iSubblockSize, iNumValues, *m_pReader );
+			GatherValues ( m_tBlockDecimal.GetAllValues().data(), tSubblockStart, pRowID, pRowIDEnd, pValue );
+		}
+		break;
+
+	case IntPacking_e::RLE:
+		while ( pRowID<pRowIDEnd )
+			*pValue++ = m_tBlockRLE.GetValue ( *pRowID++ - m_tStartBlockRowId );
+		break;
+
+	default:
+		assert ( 0 && "Packing not implemented yet" );
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 template<typename T>
@@ -398,6 +927,7 @@ public:
 	int64_t		Get() final								{ return DoGet(); }
 
 	void		Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<int64_t> & dValues ) final;
+	void		Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<int64_t> & dOffsets, std::vector<uint8_t> & dData ) final { assert ( 0 && "INTERNAL ERROR: requesting batch blob from int iterator" ); }
 
 	int			Get ( const uint8_t * & pData ) final	{ assert ( 0 && "INTERNAL ERROR: requesting blob from int iterator" ); return 0; }
 	uint8_t *	GetPacked() final						{ assert ( 0 && "INTERNAL ERROR: requesting blob from int iterator" ); return nullptr; }
@@ -413,13 +943,23 @@ private:
 template<typename T>
 void Iterator_INT_T<T>::Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<int64_t> & dValues )
 {
-	uint32_t * pRowID = dRowIDs.begin();
-	uint32_t * pRowIDEnd = dRowIDs.end();
+	assert ( dValues.size()>=dRowIDs.size() );
+
+	const uint32_t * pRowID = dRowIDs.begin();
+	const uint32_t * pRowIDEnd = dRowIDs.end();
 	int64_t * pValue = dValues.begin();
 	while ( pRowID<pRowIDEnd )
 	{
-		DoAdvance ( *pRowID++ );
-		*pValue++ = DoGet();
+		DoAdvance(*pRowID);
+
+		// consecutive rowids from the same subblock are fetched in one go
+		int iSubblockId = 0;
+		const uint32_t * pSubblockEnd = BASE::GetSubblockRunEnd ( pRowID, pRowIDEnd, iSubblockId );
+		BASE::FetchSubblock ( iSubblockId, pRowID, pSubblockEnd, pValue );
+		BASE::m_tRequestedRowID = *(pSubblockEnd-1);
+
+		pValue += pSubblockEnd-pRowID;
+		pRowID = pSubblockEnd;
 	}
 }
 
@@ -545,227 +1085,328 @@ class AnalyzerBlock_Int_Table_c : public AnalyzerBlock_c
 	using AnalyzerBlock_c::AnalyzerBlock_c;
 
 public:
-	template <bool EQ> FORCE_INLINE int	ProcessSubblock_SingleValue ( uint32_t * & pRowID, const Span_T<uint32_t> & dValueIndexes );
-	template <bool EQ> FORCE_INLINE int	ProcessSubblock_ValuesLinear ( uint32_t * & pRowID, const Span_T<uint32_t> & dValueIndexes );
-	template <bool EQ> FORCE_INLINE int	ProcessSubblock_ValuesBinary ( uint32_t * & pRowID, const Span_T<uint32_t> & dValueIndexes );
-	FORCE_INLINE int	ProcessSubblock_Range ( uint32_t * & pRowID, const Span_T<uint32_t> & dValueIndexes );
+	FORCE_INLINE int	ProcessSubblock ( uint32_t * & pRowID, const Span_T<uint32_t> & dPacked, int iBits, int iNumValues );
 
 	template <typename T, typename RANGE_EVAL>
 	FORCE_INLINE bool	SetupNextBlock ( const StoredBlock_Int_Table_T<T> & tBlock, bool bEq );
 
 private:
-	int							m_iTableValueId = -1;
-	std::vector<uint8_t>		m_dTableValues;
-	std::array<bool,UCHAR_MAX>	m_dRangeMap;
+	// the filter is resolved to table ordinals once per block; subblocks are then filtered without unpacking the ordinals
+	enum class OrdinalMatch_e
+	{
+		ALL,
+		VALUE,
+		RANGE,
+		SET
+	};
+
+	using OrdinalMap_t = std::array<bool,UCHAR_MAX+1>;
+
+	OrdinalMatch_e				m_eMatch = OrdinalMatch_e::ALL;
+	uint32_t					m_uOrdinal = 0;
+	bool						m_bEq = true;
+	uint32_t					m_uMinOrdinal = 0;
+	uint32_t					m_uMaxOrdinal = 0;
+	std::array<uint64_t,4>		m_dOrdinalSet;
+
+	bool				SetupOrdinals ( const OrdinalMap_t & dMatching, int iTableSize );
 };
 
-template <bool EQ>
-int AnalyzerBlock_Int_Table_c::ProcessSubblock_SingleValue ( uint32_t * & pRowID, const Span_T<uint32_t> & dValueIndexes )
-{
-	uint32_t tRowID = m_tRowID;
 
-	// FIXME! use SSE here
-	if ( !EQ && m_iTableValueId==-1 ) // accept all values
+int AnalyzerBlock_Int_Table_c::ProcessSubblock ( uint32_t * & pRowID, const Span_T<uint32_t> & dPacked, int iBits, int iNumValues )
+{
+	switch ( m_eMatch )
 	{
-		uint32_t * pRowIDMax = pRowID + dValueIndexes.size();
-		while ( pRowID < pRowIDMax )
-			*pRowID++ = tRowID++;
+	case OrdinalMatch_e::VALUE:	pRowID = FilterPackedOrdinals_Value ( dPacked.data(), iBits, iNumValues, m_uOrdinal, m_bEq, m_tRowID, pRowID ); break;
+	case OrdinalMatch_e::RANGE:	pRowID = FilterPackedOrdinals_Range ( dPacked.data(), iBits, iNumValues, m_uMinOrdinal, m_uMaxOrdinal, m_tRowID, pRowID ); break;
+	case OrdinalMatch_e::SET:	pRowID = FilterPackedOrdinals_Set ( dPacked.data(), iBits, iNumValues, m_dOrdinalSet.data(), m_tRowID, pRowID ); break;
+	default:
+		for ( int i = 0; i < iNumValues; i++ )
+			*pRowID++ = m_tRowID+i;
+		break;
+	}
+
+	m_tRowID += iNumValues;
+	return iNumValues;
+}
+
+// matching ordinals of sorted integer tables are usually contiguous; float and signed values may be split in two runs
+bool AnalyzerBlock_Int_Table_c::SetupOrdinals ( const OrdinalMap_t & dMatching, int iTableSize )
+{
+	int iFirst = -1;
+	int iLast = -1;
+	int iNumMatching = 0;
+	for ( int i = 0; i < iTableSize; i++ )
+		if ( dMatching[i] )
+		{
+			if ( iFirst<0 )
+				iFirst = i;
+
+			iLast = i;
+			iNumMatching++;
+		}
 
-		return (int)dValueIndexes.size();
+	if ( !iNumMatching )
+		return false;
+
+	if ( iNumMatching==iTableSize )
+		m_eMatch = OrdinalMatch_e::ALL;
+	else if ( iLast-iFirst+1==iNumMatching )
+	{
+		m_eMatch = OrdinalMatch_e::RANGE;
+		m_uMinOrdinal = iFirst;
+		m_uMaxOrdinal = iLast;
+	}
+	else
+	{
+		m_eMatch = OrdinalMatch_e::SET;
+		m_dOrdinalSet.fill(0);
+		for ( int i = 0; i < iTableSize; i++ )
+			if ( dMatching[i] )
+				m_dOrdinalSet[i>>6] |= 1ULL << ( i & 63 );
 	}
 
-	assert ( m_iTableValueId>=0 );
+	return true;
+}
+
+template<typename T, typename RANGE_EVAL>
+bool AnalyzerBlock_Int_Table_c::SetupNextBlock ( const StoredBlock_Int_Table_T<T> & tBlock, bool bEq )
+{
+	int iTableSize = tBlock.GetTableSize();
+	OrdinalMap_t dMatching;
 
-	for ( auto i : dValueIndexes )
+	switch ( m_eType )
 	{
-		if ( ( i==(uint32_t)m_iTableValueId ) ^ (!EQ) )
-			*pRowID++ = tRowID;
+	case FilterType_e::VALUES:
+		if ( m_dValues.size()==1 )
+		{
+			int iOrdinal = tBlock.GetIndexInTable ( (T)m_tValue );
+			if ( iOrdinal==-1 )
+			{
+				m_eMatch = OrdinalMatch_e::ALL;
+				return !bEq;
+			}
 
-		tRowID++;
-	}
+			m_eMatch = OrdinalMatch_e::VALUE;
+			m_uOrdinal = iOrdinal;
+			m_bEq = bEq;
+			return true;
+		}
 
-	m_tRowID = tRowID;
-	return (int)dValueIndexes.size();
+		dMatching.fill(false);
+		for ( auto i : m_dValues )
+		{
+			int iOrdinal = tBlock.GetIndexInTable ( (T)i );
+			if ( iOrdinal!=-1 )
+				dMatching[iOrdinal] = true;
+		}
+
+		if ( !bEq )
+			for ( int i = 0; i < iTableSize; i++ )
+				dMatching[i] = !dMatching[i];
+
+		return SetupOrdinals ( dMatching, iTableSize );
+
+	case FilterType_e::RANGE:
+		for ( int i = 0; i < iTableSize; i++ )
+			dMatching[i] = RANGE_EVAL::Eval ( tBlock.GetValueFromTable(i), (T)m_iMinValue, (T)m_iMaxValue );
+
+		return SetupOrdinals ( dMatching, iTableSize );
+
+	case FilterType_e::FLOATRANGE:
+		for ( int i = 0; i < iTableSize; i++ )
+			dMatching[i] = RANGE_EVAL::Eval ( UintToFloat ( (uint32_t)tBlock.GetValueFromTable(i) ), m_fMinValue, m_fMaxValue );
+
+		return SetupOrdinals ( dMatching, iTableSize );
+
+	default:
+		m_eMatch = OrdinalMatch_e::ALL;
+		return true;
+	}
 }
 
-template <bool EQ>
-int AnalyzerBlock_Int_Table_c::ProcessSubblock_ValuesLinear ( uint32_t * & pRowID, const Span_T<uint32_t> & dValueIndexes )
+//////////////////////////////////////////////////////////////////////////
+
+class AnalyzerBlock_Int_Dict_c : public AnalyzerBlock_c
 {
-	uint32_t tRowID = m_tRowID;
+	using AnalyzerBlock_c::AnalyzerBlock_c;
+
+public:
+	void				Setup ( const Filter_t & tSettings );
 
-	// FIXME! use SSE here
-	if ( !EQ && m_dTableValues.empty() ) // accept all values
-	{
-		uint32_t * pRowIDMax = pRowID + dValueIndexes.size();
-		while ( pRowID < pRowIDMax )
-			*pRowID++ = tRowID++;
+	template <typename T, typename RANGE_EVAL, typename DICT>
+	void				SetupDictionary ( const DICT & dDictionary, bool bEq );
+	FORCE_INLINE bool	HaveMatches() const { return m_bAnyMatch; }
+	FORCE_INLINE int	ProcessSubblock ( uint32_t * & pRowID, const Span_T<uint32_t> & dOrdinals );
+	FORCE_INLINE int	ProcessSubblock_Runs ( uint32_t * & pRowID, const StoredBlock_Runs_c & tRuns, int iSubblockId, int iNumValues ) { return tRuns.ProcessSubblock ( pRowID, m_tRowID, iSubblockId, iNumValues, m_dMatches ); }
 
-		return (int)dValueIndexes.size();
-	}
+private:
+	std::vector<uint8_t>	m_dMatches;
+	std::vector<int64_t>	m_dSortedValues;	// hash tables and RLE runs are set up per block; values are sorted once
+	bool					m_bAnyMatch = false;
+};
 
-	for ( auto i : dValueIndexes )
-	{
-		if ( EQ )
-		{
-			for ( auto j : m_dTableValues )
-				if ( i==(uint32_t)j )
-				{
-					*pRowID++ = tRowID;
-					break;
-				}
-		}
-		else
-		{
-			bool bAnyEqual = false;
-			for ( auto j : m_dTableValues )
-				if ( i==(uint32_t)j )
-				{
-					bAnyEqual = true;
-					break;
-				}
-
-			if ( !bAnyEqual )
-				*pRowID++ = tRowID;
-		}
 
-		tRowID++;
-	}
+void AnalyzerBlock_Int_Dict_c::Setup ( const Filter_t & tSettings )
+{
+	AnalyzerBlock_c::Setup(tSettings);
 
-	m_tRowID = tRowID;
-	return (int)dValueIndexes.size();
+	m_dSortedValues = m_dValues;
+	std::sort ( m_dSortedValues.begin(), m_dSortedValues.end() );
 }
 
-template <bool EQ>
-int AnalyzerBlock_Int_Table_c::ProcessSubblock_ValuesBinary ( uint32_t * & pRowID, const Span_T<uint32_t> & dValueIndexes )
+// the filter is evaluated against the dictionary only once; blocks then just scan ordinals
+template <typename T, typename RANGE_EVAL, typename DICT>
+void AnalyzerBlock_Int_Dict_c::SetupDictionary ( const DICT & dDictionary, bool bEq )
 {
-	uint32_t tRowID = m_tRowID;
-
-	// FIXME! use SSE here
-	if ( !EQ && m_dTableValues.empty() ) // accept all values
+	m_dMatches.resize ( dDictionary.size() );
+	m_bAnyMatch = false;
+	for ( size_t i = 0; i < dDictionary.size(); i++ )
 	{
-		uint32_t * pRowIDMax = pRowID + dValueIndexes.size();
-		while ( pRowID < pRowIDMax )
-			*pRowID++ = tRowID++;
+		int64_t tValue = (T)dDictionary[i];
+		bool bMatch = false;
+		switch ( m_eType )
+		{
+		case FilterType_e::VALUES:
+			bMatch = std::binary_search ( m_dSortedValues.begin(), m_dSortedValues.end(), tValue ) ^ (!bEq);
+			break;
 
-		return (int)dValueIndexes.size();
-	}
+		case FilterType_e::RANGE:
+			bMatch = RANGE_EVAL::Eval ( tValue, m_iMinValue, m_iMaxValue );
+			break;
 
-	for ( auto i : dValueIndexes )
-	{
-		bool bAnyEqual = std::binary_search ( m_dTableValues.cbegin(), m_dTableValues.cend(), (uint8_t)i );
-		if ( bAnyEqual ^ (!EQ) )
-			*pRowID++ = tRowID;
+		case FilterType_e::FLOATRANGE:
+			bMatch = RANGE_EVAL::Eval ( UintToFloat ( (uint32_t)tValue ), m_fMinValue, m_fMaxValue );
+			break;
 
-		tRowID++;
-	}
+		default:
+			break;
+		}
 
-	m_tRowID = tRowID;
-	return (int)dValueIndexes.size();
+		m_dMatches[i] = bMatch ? 1 : 0;
+		m_bAnyMatch |= bMatch;
+	}
 }
 
-int AnalyzerBlock_Int_Table_c::ProcessSubblock_Range ( uint32_t * & pRowID, const Span_T<uint32_t> & dValueIndexes )
+
+int AnalyzerBlock_Int_Dict_c::ProcessSubblock ( uint32_t * & pRowID, const Span_T<uint32_t> & dOrdinals )
 {
 	uint32_t tRowID = m_tRowID;
+	const uint8_t * pMatches = m_dMatches.data();
 
-	for ( auto i : dValueIndexes )
+	for ( auto i : dOrdinals )
 	{
-		if ( m_dRangeMap[i] )
+		if ( pMatches[i] )
 			*pRowID++ = tRowID;
 
 		tRowID++;
 	}
 
 	m_tRowID = tRowID;
-	return (int)dValueIndexes.size();
+	return (int)dOrdinals.size();
 }
 
-template<typename T, typename RANGE_EVAL>
-bool AnalyzerBlock_Int_Table_c::SetupNextBlock ( const StoredBlock_Int_Table_T<T> & tBlock, bool bEq )
-{
-	switch ( m_eType )
-	{
-	case FilterType_e::VALUES:
-		if ( m_dValues.size()==1 )
-		{
-			m_iTableValueId = tBlock.GetIndexInTable ( (T)m_tValue );
-			if ( bEq && m_iTableValueId==-1 )
-				return false;
-		}
-		else
-		{
-			m_dTableValues.resize(0);
-			for ( auto i : m_dValues )
-			{
-				int iValue = tBlock.GetIndexInTable ( (T)i );
-				if ( iValue!=-1 )
-					m_dTableValues.push_back ( (uint8_t)iValue );
-			}
+//////////////////////////////////////////////////////////////////////////
 
-			if ( bEq && m_dTableValues.empty() )
-				return false;
+// only 32-bit values have SIMD kernels; 64-bit values use the scalar loops
+static FORCE_INLINE bool SimdSingleValue ( const uint64_t * pValues, int iNum, int64_t iValue, bool bEq, uint32_t & tRowID, uint32_t * & pRowID ) { return false; }
+static FORCE_INLINE bool SimdSingleValue ( const uint32_t * pValues, int iNum, int64_t iValue, bool bEq, uint32_t & tRowID, uint32_t * & pRowID )
+{
+	pRowID = GetFilterKernels().m_fnSingleValue ( pValues, iNum, (uint32_t)iValue, bEq, tRowID, pRowID );
+	tRowID += iNum;
+	return true;
+}
 
-			std::sort ( m_dTableValues.begin(), m_dTableValues.end() );
-		}
-		break;
+static FORCE_INLINE bool SimdValues ( const uint64_t * pValues, int iNum, const std::vector<uint32_t> & dValues, uint32_t & tRowID, uint32_t * & pRowID ) { return false; }
+static FORCE_INLINE bool SimdValues ( const uint32_t * pValues, int iNum, const std::vector<uint32_t> & dValues, uint32_t & tRowID, uint32_t * & pRowID )
+{
+	pRowID = GetFilterKernels().m_fnValues ( pValues, iNum, dValues.data(), (int)dValues.size(), tRowID, pRowID );
+	tRowID += iNum;
+	return true;
+}
 
-	case FilterType_e::RANGE:
-		{
-			bool bAnyInRange = false;
-			for ( int i = 0; i < tBlock.GetTableSize(); i++ )
-			{
-				m_dRangeMap[i] = RANGE_EVAL::Eval ( tBlock.GetValueFromTable(i), (T)m_iMinValue, (T)m_iMaxValue );
-				bAnyInRange |= m_dRangeMap[i];
-			}
+// converts the filter to a closed range of uint32 values; returns false if it is empty
+static bool GetUint32Range ( const Filter_t & tFilter, uint32_t & uMin, uint32_t & uMax )
+{
+	uint32_t tMin = (uint32_t)tFilter.m_iMinValue;
+	uint32_t tMax = (uint32_t)tFilter.m_iMaxValue;
 
-			if ( !bAnyInRange )
-				return false;
-		}
-		break;
+	// same as ValueInInterval: left unbounded wins over right unbounded
+	uMin = 0;
+	if ( !tFilter.m_bLeftUnbounded )
+	{
+		if ( tFilter.m_bLeftClosed )
+			uMin = tMin;
+		else if ( tMin==UINT32_MAX )
+			return false;
+		else
+			uMin = tMin+1;
+	}
 
-	case FilterType_e::FLOATRANGE:
-		{
-			bool bAnyInRange = false;
-			for ( int i = 0; i < tBlock.GetTableSize(); i++ )
-			{
-				m_dRangeMap[i] = RANGE_EVAL::Eval ( UintToFloat ( (uint32_t)tBlock.GetValueFromTable(i) ), m_fMinValue, m_fMaxValue );
-				bAnyInRange |= m_dRangeMap[i];
-			}
+	uMax = UINT32_MAX;
+	if ( tFilter.m_bLeftUnbounded || !tFilter.m_bRightUnbounded )
+	{
+		if ( tFilter.m_bRightClosed )
+			uMax = tMax;
+		else if ( !tMax )
+			return false;
+		else
+			uMax = tMax-1;
+	}
 
-			if ( !bAnyInRange )
-				return false;
-		}
-		break;
+	return uMin<=uMax;
+}
 
-	default:
-		break;
-	}
+static FORCE_INLINE bool SimdRange ( const uint64_t * pValues, int iNum, const Filter_t & tFilter, uint32_t & tRowID, uint32_t * & pRowID ) { return false; }
+static FORCE_INLINE bool SimdRange ( const uint32_t * pValues, int iNum, const Filter_t & tFilter, uint32_t & tRowID, uint32_t * & pRowID )
+{
+	uint32_t uMin, uMax;
+	if ( GetUint32Range ( tFilter, uMin, uMax ) )
+		pRowID = GetFilterKernels().m_fnRange ( pValues, iNum, uMin, uMax, tRowID, pRowID );
 
+	tRowID += iNum;
 	return true;
 }
 
-//////////////////////////////////////////////////////////////////////////
-
 template<typename VALUES, typename ACCESSOR_VALUES>
 class AnalyzerBlock_Int_Values_T : public AnalyzerBlock_c
 {
 	using AnalyzerBlock_c::AnalyzerBlock_c;
 
 public:
+	void		Setup ( const Filter_t & tSettings );
+
 	template <bool EQ> FORCE_INLINE int	ProcessSubblock_SingleValue ( uint32_t * & pRowID, const Span_T<ACCESSOR_VALUES> & dValues );
 	template <bool EQ> FORCE_INLINE int	ProcessSubblock_ValuesLinear ( uint32_t * & pRowID, const Span_T<ACCESSOR_VALUES> & dValues );
 	template <bool EQ> FORCE_INLINE int	ProcessSubblock_ValuesBinary ( uint32_t * & pRowID, const Span_T<ACCESSOR_VALUES> & dValues );
 
 	template<typename RANGE_EVAL> FORCE_INLINE int	ProcessSubblock_Range ( uint32_t * & pRowID, const Span_T<ACCESSOR_VALUES> & dValues );
 	template<typename RANGE_EVAL> FORCE_INLINE int	ProcessSubblock_FloatRange ( uint32_t * & pRowID, const Span_T<ACCESSOR_VALUES> & dValues );
+	template<typename RANGE_EVAL, bool ASC=true> FORCE_INLINE int	ProcessSubblock_SortedRange ( uint32_t * & pRowID, const Span_T<ACCESSOR_VALUES> & dValues );
+	template<typename RANGE_EVAL> FORCE_INLINE int	ProcessSubblock_MonotonicRange ( uint32_t * & pRowID, const Span_T<ACCESSOR_VALUES> & dValues );
+
+private:
+	std::vector<uint32_t>	m_dValues32;	// filter values for the SIMD kernels
 };
 
+template<typename VALUES, typename ACCESSOR_VALUES>
+void AnalyzerBlock_Int_Values_T<VALUES,ACCESSOR_VALUES>::Setup ( const Filter_t & tSettings )
+{
+	AnalyzerBlock_c::Setup(tSettings);
+
+	m_dValues32.resize(0);
+	for ( auto i : m_dValues )
+		m_dValues32.push_back ( (uint32_t)i );
+}
+
 template<typename VALUES, typename ACCESSOR_VALUES>
 template <bool EQ>
 int AnalyzerBlock_Int_Values_T<VALUES,ACCESSOR_VALUES>::ProcessSubblock_SingleValue ( uint32_t * & pRowID, const Span_T<ACCESSOR_VALUES> & dValues )
 {
-	uint32_t tRowID = m_tRowID;
+	if ( SimdSingleValue ( dValues.data(), (int)dValues.size(), m_tValue, EQ, m_tRowID, pRowID ) )
+		return (int)dValues.size();
 
-	// FIXME! use SSE here
+	uint32_t tRowID = m_tRowID;
 	for ( auto & i : dValues )
 	{
 		if ( ( i==(ACCESSOR_VALUES)m_tValue ) ^ (!EQ) )
@@ -782,9 +1423,10 @@ template<typename VALUES, typename ACCESSOR_VALUES>
 template <bool EQ>
 int AnalyzerBlock_Int_Values_T<VALUES,ACCESSOR_VALUES>::ProcessSubblock_ValuesLinear ( uint32_t * & pRowID, const Span_T<ACCESSOR_VALUES> & dValues )
 {
-	uint32_t tRowID = m_tRowID;
+	if ( EQ && SimdValues ( dValues.data(), (int)dValues.size(), m_dValues32, m_tRowID, pRowID ) )
+		return (int)dValues.size();
 
-	// FIXME! use SSE here
+	uint32_t tRowID = m_tRowID;
 	for ( auto i : dValues )
 	{
 		for ( auto j : m_dValues )
@@ -823,6 +1465,9 @@ template<typename VALUES, typename ACCESSOR_VALUES>
 template<typename RANGE_EVAL>
 int AnalyzerBlock_Int_Values_T<VALUES,ACCESSOR_VALUES>::ProcessSubblock_Range ( uint32_t * & pRowID, const Span_T<ACCESSOR_VALUES> & dValues )
 {
+	if ( SimdRange ( dValues.data(), (int)dValues.size(), *this, m_tRowID, pRowID ) )
+		return (int)dValues.size();
+
 	uint32_t tRowID = m_tRowID;
 
 	for ( auto i : dValues )
@@ -841,20 +1486,84 @@ template<>
 template<typename RANGE_EVAL>
 int AnalyzerBlock_Int_Values_T<float,uint32_t>::ProcessSubblock_Range ( uint32_t * & pRowID, const Span_T<uint32_t> & dValues )
 {
-	uint32_t tRowID = m_tRowID;
-
-	for ( auto i : dValues )
+	// same as ValueInInterval: left unbounded wins over right unbounded
+	FloatRange_t tRange { m_fMinValue, m_fMaxValue, m_bLeftClosed, m_bRightClosed };
+	if ( m_bLeftUnbounded )
 	{
-		if ( RANGE_EVAL::Eval ( UintToFloat(i), m_fMinValue, m_fMaxValue ) )
-			*pRowID++ = tRowID;
+		tRange.m_fMin = -std::numeric_limits<float>::infinity();
+		tRange.m_bLeftClosed = true;
+	}
+	else if ( m_bRightUnbounded )
+	{
+		tRange.m_fMax = std::numeric_limits<float>::infinity();
+		tRange.m_bRightClosed = true;
+	}
 
-		tRowID++;
+	pRowID = GetFilterKernels().m_fnFloatRange ( dValues.data(), (int)dValues.size(), tRange, m_tRowID, pRowID );
+	m_tRowID += (uint32_t)dValues.size();
+	return (int)dValues.size();
+}
+
+template<typename VALUES, typename ACCESSOR_VALUES>
+template<typename RANGE_EVAL, bool ASC>
+int AnalyzerBlock_Int_Values_T<VALUES,ACCESSOR_VALUES>::ProcessSubblock_SortedRange ( uint32_t * & pRowID, const Span_T<ACCESSOR_VALUES> & dValues )
+{
+	// matching values are contiguous in a sorted subblock; no need to check them one by one
+	VALUES tMin = (VALUES)m_iMinValue;
+	VALUES tMax = (VALUES)m_iMaxValue;
+	const ACCESSOR_VALUES * pStart;
+	const ACCESSOR_VALUES * pEnd;
+	if ( ASC )
+	{
+		pStart = std::partition_point ( dValues.begin(), dValues.end(), [tMin]( ACCESSOR_VALUES tValue ){ return RANGE_EVAL::IsBelow ( (VALUES)tValue, tMin ); } );
+		pEnd = std::partition_point ( pStart, (const ACCESSOR_VALUES*)dValues.end(), [tMax]( ACCESSOR_VALUES tValue ){ return !RANGE_EVAL::IsAbove ( (VALUES)tValue, tMax ); } );
+	}
+	else
+	{
+		pStart = std::partition_point ( dValues.begin(), dValues.end(), [tMax]( ACCESSOR_VALUES tValue ){ return RANGE_EVAL::IsAbove ( (VALUES)tValue, tMax ); } );
+		pEnd = std::partition_point ( pStart, (const ACCESSOR_VALUES*)dValues.end(), [tMin]( ACCESSOR_VALUES tValue ){ return !RANGE_EVAL::IsBelow ( (VALUES)tValue, tMin ); } );
 	}
 
-	m_tRowID = tRowID;
+	uint32_t tRowID = m_tRowID + uint32_t ( pStart-dValues.begin() );
+	uint32_t tEndRowID = m_tRowID + uint32_t ( pEnd-dValues.begin() );
+	while ( tRowID < tEndRowID )
+		*pRowID++ = tRowID++;
+
+	m_tRowID += (uint32_t)dValues.size();
 	return (int)dValues.size();
 }
 
+template<typename VALUES, typename ACCESSOR_VALUES>
+template<typename RANGE_EVAL>
+int AnalyzerBlock_Int_Values_T<VALUES,ACCESSOR_VALUES>::ProcessSubblock_MonotonicRange ( uint32_t * & pRowID, const Span_T<ACCESSOR_VALUES> & dValues )
+{
+	// DELTA blocks are monotonic in the stored (unsigned) order; signed values are sorted only if the subblock doesn't cross zero
+	ACCESSOR_VALUES tFirst = dValues.front();
+	ACCESSOR_VALUES tLast = dValues.back();
+	bool bAsc = tFirst<=tLast;
+	if ( bAsc!=( (VALUES)tFirst<=(VALUES)tLast ) && tFirst!=tLast )
+		return ProcessSubblock_Range<RANGE_EVAL> ( pRowID, dValues );
+
+	if ( bAsc )
+		return ProcessSubblock_SortedRange<RANGE_EVAL,true> ( pRowID, dValues );
+
+	return ProcessSubblock_SortedRange<RANGE_EVAL,false> ( pRowID, dValues );
+}
+
+template<>
+template<typename RANGE_EVAL, bool ASC>
+int AnalyzerBlock_Int_Values_T<float,uint32_t>::ProcessSubblock_SortedRange ( uint32_t * & pRowID, const Span_T<uint32_t> & dValues )
+{
+	return ProcessSubblock_Range<RANGE_EVAL> ( pRowID, dValues );
+}
+
+template<>
+template<typename RANGE_EVAL>
+int AnalyzerBlock_Int_Values_T<float,uint32_t>::ProcessSubblock_MonotonicRange ( uint32_t * & pRowID, const Span_T<uint32_t> & dValues )
+{
+	return ProcessSubblock_Range<RANGE_EVAL> ( pRowID, dValues );
+}
+
 
 // a mega-class of all integer analyzers
 // splitting it into a class hierarchy would yield cleaner code
@@ -874,6 +1583,9 @@ public:
 private:
 	AnalyzerBlock_Int_Const_c	m_tBlockConst;
 	AnalyzerBlock_Int_Table_c	m_tBlockTable;
+	AnalyzerBlock_Int_Dict_c	m_tBlockDict;
+	AnalyzerBlock_Int_Dict_c	m_tBlockHashTable;
+	AnalyzerBlock_Int_Dict_c	m_tBlockRLE;
 	AnalyzerBlock_Int_Values_T<VALUES, ACCESSOR_VALUES> m_tBlockValues;
 
 	Filter_t 			m_tSettings;
@@ -890,6 +1602,14 @@ private:
 	void				SetupPackingFuncs();
 
 	int					ProcessSubblockConst ( uint32_t * & pRowID, int iSubblockIdInBlock );
+	int					ProcessSubblockDict ( uint32_t * & pRowID, int iSubblockIdInBlock );
+	int					ProcessSubblockHashTable ( uint32_t * & pRowID, int iSubblockIdInBlock );
+	int					ProcessSubblockRLE ( uint32_t * & pRowID, int iSubblockIdInBlock );
+
+	template <bool EQ>	int	ProcessSubblockHash_SingleValue ( uint32_t * & pRowID, int iSubblockIdInBlock );
+	template <bool EQ, bool LINEAR>	int	ProcessSubblockHash_Values ( uint32_t * & pRowID, int iSubblockIdInBlock );
+	int					ProcessSubblockHash_Range ( uint32_t * & pRowID, int iSubblockIdInBlock );
+	FORCE_INLINE void	ReadSubblockHash ( int iSubblockIdInBlock );
 
 	template <bool EQ>	int	ProcessSubblockGeneric_SingleValue ( uint32_t * & pRowID, int iSubblockIdInBlock );
 	template <bool EQ, bool LINEAR>	int	ProcessSubblockGeneric_Values ( uint32_t * & pRowID, int iSubblockIdInBlock );
@@ -899,19 +1619,36 @@ private:
 	template <bool EQ, bool LINEAR>	int	ProcessSubblockDelta_Values ( uint32_t * & pRowID, int iSubblockIdInBlock );
 	int					ProcessSubblockDelta_Range ( uint32_t * & pRowID, int iSubblockIdInBlock );
 
-	template <bool EQ>	int	ProcessSubblockTable_SingleValue ( uint32_t * & pRowID, int iSubblockIdInBlock );
-	template <bool EQ, bool LINEAR>	int	ProcessSubblockTable_Values ( uint32_t * & pRowID, int iSubblockIdInBlock );
-	int					ProcessSubblockTable_Range ( uint32_t * & pRowID, int iSubblockIdInBlock );
+	int					ProcessSubblockTable ( uint32_t * & pRowID, int iSubblockIdInBlock );
+
+	template <bool EQ>	int	ProcessSubblockFOR_SingleValue ( uint32_t * & pRowID, int iSubblockIdInBlock );
+	template <bool EQ, bool LINEAR>	int	ProcessSubblockFOR_Values ( uint32_t * & pRowID, int iSubblockIdInBlock );
+	int					ProcessSubblockFOR_Range ( uint32_t * & pRowID, int iSubblockIdInBlock );
+
+	FORCE_INLINE void	ReadSubblockFOR ( int iSubblockIdInBlock );
+
+	template <bool EQ>	int	ProcessSubblockDecimal_SingleValue ( uint32_t * & pRowID, int iSubblockIdInBlock );
+	template <bool EQ, bool LINEAR>	int	ProcessSubblockDecimal_Values ( uint32_t * & pRowID, int iSubblockIdInBlock );
+	int					ProcessSubblockDecimal_Range ( uint32_t * & pRowID, int iSubblockIdInBlock );
+
+	FORCE_INLINE void	ReadSubblockDecimal ( int iSubblockIdInBlock );
+
+	template <bool EQ>	int	ProcessSubblockDeltaDelta_SingleValue ( uint32_t * & pRowID, int iSubblockIdInBlock );
+	template <bool EQ, bool LINEAR>	int	ProcessSubblockDeltaDelta_Values ( uint32_t * & pRowID, int iSubblockIdInBlock );
+	int					ProcessSubblockDeltaDelta_Range ( uint32_t * & pRowID, int iSubblockIdInBlock );
 
 	bool				MoveToBlock ( int iNextBlock ) final;
 };
 
 template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL>
 Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::Analyzer_INT_T ( const AttributeHeader_i & tHeader, FileReader_c * pReader, const Filter_t & tSettings )
-	: ANALYZER ( tHeader.GetSettings().m_iSubblockSize )
+	: ANALYZER ( tHeader, pReader )
 	, ACCESSOR ( tHeader, pReader )
 	, m_tBlockConst ( m_tRowID )
 	, m_tBlockTable ( m_tRowID )
+	, m_tBlockDict ( m_tRowID )
+	, m_tBlockHashTable ( m_tRowID )
+	, m_tBlockRLE ( m_tRowID )
 	, m_tBlockValues (m_tRowID )
 	, m_tSettings ( tSettings )
 {
@@ -921,7 +1658,14 @@ Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::Analyzer_INT_T ( const Attrib
 
 	m_tBlockConst.Setup(m_tSettings);
 	m_tBlockTable.Setup(m_tSettings);
+	m_tBlockDict.Setup(m_tSettings);
+	m_tBlockHashTable.Setup(m_tSettings);
+	m_tBlockRLE.Setup(m_tSettings);
 	m_tBlockValues.Setup(m_tSettings);
+	ANALYZER::SetupFullSubblocks ( tHeader, m_tSettings );
+
+	if ( !ACCESSOR::m_dDictionary.empty() )
+		m_tBlockDict.SetupDictionary<ACCESSOR_VALUES,RANGE_EVAL> ( ACCESSOR::m_dDictionary, !m_tSettings.m_bExclude );
 
 	SetupPackingFuncs();
 }
@@ -932,15 +1676,23 @@ void Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::SetupPackingFuncs_Single
 	auto & dFuncs = m_dProcessingFuncs;
 	if ( m_tSettings.m_bExclude )
 	{
-		dFuncs [ to_underlying ( IntPacking_e::TABLE ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockTable_SingleValue<false>;
+		dFuncs [ to_underlying ( IntPacking_e::TABLE ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockTable;
 		dFuncs [ to_underlying ( IntPacking_e::DELTA ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDelta_SingleValue<false>;
 		dFuncs [ to_underlying ( IntPacking_e::GENERIC )]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockGeneric_SingleValue<false>;
+		dFuncs [ to_underlying ( IntPacking_e::FOR ) ]		= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockFOR_SingleValue<false>;
+		dFuncs [ to_underlying ( IntPacking_e::DECIMAL ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDecimal_SingleValue<false>;
+		dFuncs [ to_underlying ( IntPacking_e::DELTA_DELTA ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDeltaDelta_SingleValue<false>;
+		dFuncs [ to_underlying ( IntPacking_e::HASH ) ]		= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockHash_SingleValue<false>;
 	}
 	else
 	{
-		dFuncs [ to_underlying ( IntPacking_e::TABLE ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockTable_SingleValue<true>;
+		dFuncs [ to_underlying ( IntPacking_e::TABLE ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockTable;
 		dFuncs [ to_underlying ( IntPacking_e::DELTA ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDelta_SingleValue<true>;
 		dFuncs [ to_underlying ( IntPacking_e::GENERIC )]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockGeneric_SingleValue<true>;
+		dFuncs [ to_underlying ( IntPacking_e::FOR ) ]		= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockFOR_SingleValue<true>;
+		dFuncs [ to_underlying ( IntPacking_e::DECIMAL ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDecimal_SingleValue<true>;
+		dFuncs [ to_underlying ( IntPacking_e::DELTA_DELTA ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDeltaDelta_SingleValue<true>;
+		dFuncs [ to_underlying ( IntPacking_e::HASH ) ]		= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockHash_SingleValue<true>;
 	}
 }
 
@@ -950,15 +1702,23 @@ void Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::SetupPackingFuncs_Values
 	auto & dFuncs = m_dProcessingFuncs;
 	if ( m_tSettings.m_bExclude )
 	{
-		dFuncs [ to_underlying ( IntPacking_e::TABLE ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockTable_Values<false,true>;
+		dFuncs [ to_underlying ( IntPacking_e::TABLE ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockTable;
 		dFuncs [ to_underlying ( IntPacking_e::DELTA ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDelta_Values<false,true>;
 		dFuncs [ to_underlying ( IntPacking_e::GENERIC ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockGeneric_Values<false,true>;
+		dFuncs [ to_underlying ( IntPacking_e::FOR ) ]		= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockFOR_Values<false,true>;
+		dFuncs [ to_underlying ( IntPacking_e::DECIMAL ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDecimal_Values<false,true>;
+		dFuncs [ to_underlying ( IntPacking_e::DELTA_DELTA ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDeltaDelta_Values<false,true>;
+		dFuncs [ to_underlying ( IntPacking_e::HASH ) ]		= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockHash_Values<false,true>;
 	}
 	else
 	{
-		dFuncs [ to_underlying ( IntPacking_e::TABLE ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockTable_Values<true,true>;
+		dFuncs [ to_underlying ( IntPacking_e::TABLE ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockTable;
 		dFuncs [ to_underlying ( IntPacking_e::DELTA ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDelta_Values<true,true>;
 		dFuncs [ to_underlying ( IntPacking_e::GENERIC ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockGeneric_Values<true,true>;
+		dFuncs [ to_underlying ( IntPacking_e::FOR ) ]		= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockFOR_Values<true,true>;
+		dFuncs [ to_underlying ( IntPacking_e::DECIMAL ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDecimal_Values<true,true>;
+		dFuncs [ to_underlying ( IntPacking_e::DELTA_DELTA ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDeltaDelta_Values<true,true>;
+		dFuncs [ to_underlying ( IntPacking_e::HASH ) ]		= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockHash_Values<true,true>;
 	}
 }
 
@@ -968,15 +1728,23 @@ void Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::SetupPackingFuncs_Values
 	auto & dFuncs = m_dProcessingFuncs;
 	if ( m_tSettings.m_bExclude )
 	{
-		dFuncs [ to_underlying ( IntPacking_e::TABLE ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockTable_Values<false,false>;
+		dFuncs [ to_underlying ( IntPacking_e::TABLE ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockTable;
 		dFuncs [ to_underlying ( IntPacking_e::DELTA ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDelta_Values<false,false>;
 		dFuncs [ to_underlying ( IntPacking_e::GENERIC ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockGeneric_Values<false,false>;
+		dFuncs [ to_underlying ( IntPacking_e::FOR ) ]		= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockFOR_Values<false,false>;
+		dFuncs [ to_underlying ( IntPacking_e::DECIMAL ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDecimal_Values<false,false>;
+		dFuncs [ to_underlying ( IntPacking_e::DELTA_DELTA ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDeltaDelta_Values<false,false>;
+		dFuncs [ to_underlying ( IntPacking_e::HASH ) ]		= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockHash_Values<false,false>;
 	}
 	else
 	{
-		dFuncs [ to_underlying ( IntPacking_e::TABLE ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockTable_Values<true,false>;
+		dFuncs [ to_underlying ( IntPacking_e::TABLE ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockTable;
 		dFuncs [ to_underlying ( IntPacking_e::DELTA ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDelta_Values<true,false>;
 		dFuncs [ to_underlying ( IntPacking_e::GENERIC ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockGeneric_Values<true,false>;
+		dFuncs [ to_underlying ( IntPacking_e::FOR ) ]		= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockFOR_Values<true,false>;
+		dFuncs [ to_underlying ( IntPacking_e::DECIMAL ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDecimal_Values<true,false>;
+		dFuncs [ to_underlying ( IntPacking_e::DELTA_DELTA ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDeltaDelta_Values<true,false>;
+		dFuncs [ to_underlying ( IntPacking_e::HASH ) ]		= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockHash_Values<true,false>;
 	}
 }
 
@@ -984,9 +1752,13 @@ template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL>
 void Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::SetupPackingFuncs_Range()
 {
 	auto & dFuncs = m_dProcessingFuncs;
-	dFuncs [ to_underlying ( IntPacking_e::TABLE ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockTable_Range;
+	dFuncs [ to_underlying ( IntPacking_e::TABLE ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockTable;
 	dFuncs [ to_underlying ( IntPacking_e::DELTA ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDelta_Range;
 	dFuncs [ to_underlying ( IntPacking_e::GENERIC ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockGeneric_Range;
+	dFuncs [ to_underlying ( IntPacking_e::FOR ) ]		= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockFOR_Range;
+	dFuncs [ to_underlying ( IntPacking_e::DECIMAL ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDecimal_Range;
+	dFuncs [ to_underlying ( IntPacking_e::DELTA_DELTA ) ]	= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDeltaDelta_Range;
+	dFuncs [ to_underlying ( IntPacking_e::HASH ) ]		= &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockHash_Range;
 }
 
 template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL>
@@ -1001,6 +1773,12 @@ void Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::SetupPackingFuncs()
 	// doesn't depend on filter type; just fills result with rowids
 	dFuncs [ to_underlying ( IntPacking_e::CONST ) ] = &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockConst;
 
+	// filter was already evaluated against the dictionary
+	dFuncs [ to_underlying ( IntPacking_e::DICT ) ] = &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDict;
+
+	// filter is evaluated against run values once per block
+	dFuncs [ to_underlying ( IntPacking_e::RLE ) ] = &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockRLE;
+
 	switch ( m_tSettings.m_eType )
 	{
 	case FilterType_e::VALUES:
@@ -1029,6 +1807,13 @@ int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockConst ( ui
 	return m_tBlockConst.ProcessSubblock ( pRowID, StoredBlockTraits_t::GetNumSubblockValues(iSubblockIdInBlock) );
 }
 
+template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL>
+int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDict ( uint32_t * & pRowID, int iSubblockIdInBlock )
+{
+	ACCESSOR::m_tBlockDict.ReadSubblock ( iSubblockIdInBlock, StoredBlockTraits_t::GetNumSubblockValues(iSubblockIdInBlock), *ACCESSOR::m_pReader );
+	return m_tBlockDict.ProcessSubblock ( pRowID, ACCESSOR::m_tBlockDict.GetOrdinals() );
+}
+
 template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL>
 template <bool EQ>
 int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockGeneric_SingleValue ( uint32_t * & pRowID, int iSubblockIdInBlock )
@@ -1080,34 +1865,156 @@ template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL>
 int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDelta_Range ( uint32_t * & pRowID, int iSubblockIdInBlock )
 {
 	ACCESSOR::m_tBlockPFOR.ReadSubblock_Delta ( iSubblockIdInBlock, *ACCESSOR::m_pReader );
+	return m_tBlockValues.template ProcessSubblock_MonotonicRange<RANGE_EVAL> ( pRowID, ACCESSOR::m_tBlockPFOR.GetAllValues() );
+}
+
+template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL>
+int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockTable ( uint32_t * & pRowID, int iSubblockIdInBlock )
+{
+	ACCESSOR::m_tBlockTable.ReadSubblockPacked ( iSubblockIdInBlock, *ACCESSOR::m_pReader );
+	return m_tBlockTable.ProcessSubblock ( pRowID, ACCESSOR::m_tBlockTable.GetPackedValueIndexes(), ACCESSOR::m_tBlockTable.GetNumBits(), StoredBlockTraits_t::GetNumSubblockValues(iSubblockIdInBlock) );
+}
+
+template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL>
+int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockHashTable ( uint32_t * & pRowID, int iSubblockIdInBlock )
+{
+	ACCESSOR::m_tBlockHashTable.ReadSubblock ( iSubblockIdInBlock, StoredBlockTraits_t::GetNumSubblockValues(iSubblockIdInBlock), *ACCESSOR::m_pReader );
+	return m_tBlockHashTable.ProcessSubblock ( pRowID, ACCESSOR::m_tBlockHashTable.GetOrdinals() );
+}
+
+template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL>
+int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockRLE ( uint32_t * & pRowID, int iSubblockIdInBlock )
+{
+	return m_tBlockRLE.ProcessSubblock_Runs ( pRowID, ACCESSOR::m_tBlockRLE.GetRuns(), iSubblockIdInBlock, StoredBlockTraits_t::GetNumSubblockValues(iSubblockIdInBlock) );
+}
+
+template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL>
+void Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ReadSubblockHash ( int iSubblockIdInBlock )
+{
+	ACCESSOR::m_tBlockPFOR.ReadSubblock_Hash ( iSubblockIdInBlock, *ACCESSOR::m_pReader, StoredBlockTraits_t::GetNumSubblockValues(iSubblockIdInBlock) );
+}
+
+template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL>
+template <bool EQ>
+int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockHash_SingleValue ( uint32_t * & pRowID, int iSubblockIdInBlock )
+{
+	ReadSubblockHash(iSubblockIdInBlock);
+	return m_tBlockValues.template ProcessSubblock_SingleValue<EQ> ( pRowID, ACCESSOR::m_tBlockPFOR.GetAllValues() );
+}
+
+template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL>
+template <bool EQ, bool LINEAR>
+int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockHash_Values ( uint32_t * & pRowID, int iSubblockIdInBlock )
+{
+	ReadSubblockHash(iSubblockIdInBlock);
+
+	if ( LINEAR )
+		return m_tBlockValues.template ProcessSubblock_ValuesLinear<EQ> ( pRowID, ACCESSOR::m_tBlockPFOR.GetAllValues() );
+
+	return m_tBlockValues.template ProcessSubblock_ValuesBinary<EQ> ( pRowID, ACCESSOR::m_tBlockPFOR.GetAllValues() );
+}
+
+template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL>
+int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockHash_Range ( uint32_t * & pRowID, int iSubblockIdInBlock )
+{
+	ReadSubblockHash(iSubblockIdInBlock);
 	return m_tBlockValues.template ProcessSubblock_Range<RANGE_EVAL> ( pRowID, ACCESSOR::m_tBlockPFOR.GetAllValues() );
 }
 
+template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL>
+void Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ReadSubblockFOR ( int iSubblockIdInBlock )
+{
+	ACCESSOR::m_tBlockFOR.ReadSubblock ( iSubblockIdInBlock, ACCESSOR::m_tHeader.GetSettings().m_iSubblockSize, StoredBlockTraits_t::GetNumSubblockValues(iSubblockIdInBlock), *ACCESSOR::m_pReader );
+}
+
+template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL>
+template <bool EQ>
+int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockFOR_SingleValue ( uint32_t * & pRowID, int iSubblockIdInBlock )
+{
+	ReadSubblockFOR(iSubblockIdInBlock);
+	return m_tBlockValues.template ProcessSubblock_SingleValue<EQ> ( pRowID, ACCESSOR::m_tBlockFOR.GetAllValues() );
+}
+
+template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL>
+template <bool EQ, bool LINEAR>
+int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockFOR_Values ( uint32_t * & pRowID, int iSubblockIdInBlock )
+{
+	ReadSubblockFOR(iSubblockIdInBlock);
+
+	if ( LINEAR )
+		return m_tBlockValues.template ProcessSubblock_ValuesLinear<EQ> ( pRowID, ACCESSOR::m_tBlockFOR.GetAllValues() );
+
+	return m_tBlockValues.template ProcessSubblock_ValuesBinary<EQ> ( pRowID, ACCESSOR::m_tBlockFOR.GetAllValues() );
+}
+
+template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL>
+int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockFOR_Range ( uint32_t * & pRowID, int iSubblockIdInBlock )
+{
+	ReadSubblockFOR(iSubblockIdInBlock);
+	return m_tBlockValues.template ProcessSubblock_Range<RANGE_EVAL> ( pRowID, ACCESSOR::m_tBlockFOR.GetAllValues() );
+}
+
+template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL>
+void Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ReadSubblockDecimal ( int iSubblockIdInBlock )
+{
+	ACCESSOR::m_tBlockDecimal.ReadSubblock ( iSubblockIdInBlock, ACCESSOR::m_tHeader.GetSettings().m_iSubblockSize, StoredBlockTraits_t::GetNumSubblockValues(iSubblockIdInBlock), *ACCESSOR::m_pReader );
+}
+
+template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL>
+template <bool EQ>
+int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDecimal_SingleValue ( uint32_t * & pRowID, int iSubblockIdInBlock )
+{
+	ReadSubblockDecimal(iSubblockIdInBlock);
+	return m_tBlockValues.template ProcessSubblock_SingleValue<EQ> ( pRowID, ACCESSOR::m_tBlockDecimal.GetAllValues() );
+}
+
+template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL>
+template <bool EQ, bool LINEAR>
+int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDecimal_Values ( uint32_t * & pRowID, int iSubblockIdInBlock )
+{
+	ReadSubblockDecimal(iSubblockIdInBlock);
+
+	if ( LINEAR )
+		return m_tBlockValues.template ProcessSubblock_ValuesLinear<EQ> ( pRowID, ACCESSOR::m_tBlockDecimal.GetAllValues() );
+
+	return m_tBlockValues.template ProcessSubblock_ValuesBinary<EQ> ( pRowID, ACCESSOR::m_tBlockDecimal.GetAllValues() );
+}
+
+template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL>
+int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDecimal_Range ( uint32_t * & pRowID, int iSubblockIdInBlock )
+{
+	ReadSubblockDecimal(iSubblockIdInBlock);
+	return m_tBlockValues.template ProcessSubblock_Range<RANGE_EVAL> ( pRowID, ACCESSOR::m_tBlockDecimal.GetAllValues() );
+}
+
 template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL>
 template <bool EQ>
-int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockTable_SingleValue ( uint32_t * & pRowID, int iSubblockIdInBlock )
+int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDeltaDelta_SingleValue ( uint32_t * & pRowID, int iSubblockIdInBlock )
 {
-	ACCESSOR::m_tBlockTable.ReadSubblock ( iSubblockIdInBlock, StoredBlockTraits_t::GetNumSubblockValues(iSubblockIdInBlock), *ACCESSOR::m_pReader );
-	return m_tBlockTable.template ProcessSubblock_SingleValue<EQ> ( pRowID, ACCESSOR::m_tBlockTable.GetValueIndexes() );
+	ACCESSOR::m_tBlockPFOR.ReadSubblock_DeltaDelta ( iSubblockIdInBlock, *ACCESSOR::m_pReader );
+	return m_tBlockValues.template ProcessSubblock_SingleValue<EQ> ( pRowID, ACCESSOR::m_tBlockPFOR.GetAllValues() );
 }
 
 template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL>
 template <bool EQ, bool LINEAR>
-int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockTable_Values ( uint32_t * & pRowID, int iSubblockIdInBlock )
+int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDeltaDelta_Values ( uint32_t * & pRowID, int iSubblockIdInBlock )
 {
-	ACCESSOR::m_tBlockTable.ReadSubblock ( iSubblockIdInBlock, StoredBlockTraits_t::GetNumSubblockValues(iSubblockIdInBlock), *ACCESSOR::m_pReader );
+	ACCESSOR::m_tBlockPFOR.ReadSubblock_DeltaDelta ( iSubblockIdInBlock, *ACCESSOR::m_pReader );
 
 	if ( LINEAR )
-		return m_tBlockTable.template ProcessSubblock_ValuesLinear<EQ> ( pRowID, ACCESSOR::m_tBlockTable.GetValueIndexes() );
+		return m_tBlockValues.template ProcessSubblock_ValuesLinear<EQ> ( pRowID, ACCESSOR::m_tBlockPFOR.GetAllValues() );
 
-	return m_tBlockTable.template ProcessSubblock_ValuesBinary<EQ> ( pRowID, ACCESSOR::m_tBlockTable.GetValueIndexes() );
+	return m_tBlockValues.template ProcessSubblock_ValuesBinary<EQ> ( pRowID, ACCESSOR::m_tBlockPFOR.GetAllValues() );
 }
 
 template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL>
-int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockTable_Range ( uint32_t * & pRowID, int iSubblockIdInBlock )
+int Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockDeltaDelta_Range ( uint32_t * & pRowID, int iSubblockIdInBlock )
 {
-	ACCESSOR::m_tBlockTable.ReadSubblock ( iSubblockIdInBlock, StoredBlockTraits_t::GetNumSubblockValues(iSubblockIdInBlock), *ACCESSOR::m_pReader );
-	return m_tBlockTable.ProcessSubblock_Range ( pRowID, ACCESSOR::m_tBlockTable.GetValueIndexes() );
+	ACCESSOR::m_tBlockPFOR.ReadSubblock_DeltaDelta ( iSubblockIdInBlock, *ACCESSOR::m_pReader );
+	if ( ACCESSOR::m_tBlockPFOR.IsSubblockSorted() )
+		return m_tBlockValues.template ProcessSubblock_SortedRange<RANGE_EVAL> ( pRowID, ACCESSOR::m_tBlockPFOR.GetAllValues() );
+
+	return m_tBlockValues.template ProcessSubblock_Range<RANGE_EVAL> ( pRowID, ACCESSOR::m_tBlockPFOR.GetAllValues() );
 }
 
 template<typename VALUES, typename ACCESSOR_VALUES, typename RANGE_EVAL>
@@ -1124,10 +2031,26 @@ bool Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::MoveToBlock ( int iNextB
 		m_iCurBlockId = iNextBlock;
 		ACCESSOR::SetCurBlock(m_iCurBlockId);
 
-		if ( ACCESSOR::m_ePacking!=IntPacking_e::CONST && ACCESSOR::m_ePacking!=IntPacking_e::TABLE )
+		if ( ACCESSOR::m_ePacking==IntPacking_e::DICT )
+		{
+			if ( m_tBlockDict.HaveMatches() )
+				break;
+		}
+		else if ( ACCESSOR::m_ePacking==IntPacking_e::HASH && ACCESSOR::m_eHashPacking==IntHashPacking_e::TABLE )
+		{
+			m_tBlockHashTable.SetupDictionary<ACCESSOR_VALUES,RANGE_EVAL> ( ACCESSOR::m_tBlockHashTable.GetTable(), !m_tSettings.m_bExclude );
+			if ( m_tBlockHashTable.HaveMatches() )
+				break;
+		}
+		else if ( ACCESSOR::m_ePacking==IntPacking_e::RLE )
+		{
+			m_tBlockRLE.SetupDictionary<ACCESSOR_VALUES,RANGE_EVAL> ( ACCESSOR::m_tBlockRLE.GetRunValues(), !m_tSettings.m_bExclude );
+			if ( m_tBlockRLE.HaveMatches() )
+				break;
+		}
+		else if ( ACCESSOR::m_ePacking!=IntPacking_e::CONST && ACCESSOR::m_ePacking!=IntPacking_e::TABLE )
 			break;
-
-		if ( ACCESSOR::m_ePacking==IntPacking_e::CONST )
+		else if ( ACCESSOR::m_ePacking==IntPacking_e::CONST )
 		{
 			if ( m_tBlockConst.SetupNextBlock<ACCESSOR_VALUES,RANGE_EVAL> ( ACCESSOR::m_tBlockConst, !m_tSettings.m_bExclude ) )
 				break;
@@ -1142,7 +2065,11 @@ bool Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::MoveToBlock ( int iNextB
 			return false;
 	}
 
-	m_fnProcessSubblock = m_dProcessingFuncs [ to_underlying ( ACCESSOR::m_ePacking ) ];
+	if ( ACCESSOR::m_ePacking==IntPacking_e::HASH && ACCESSOR::m_eHashPacking==IntHashPacking_e::TABLE )
+		m_fnProcessSubblock = &Analyzer_INT_T<VALUES,ACCESSOR_VALUES,RANGE_EVAL>::ProcessSubblockHashTable;
+	else
+		m_fnProcessSubblock = m_dProcessingFuncs [ to_underlying ( ACCESSOR::m_ePacking ) ];
+
 	assert ( m_fnProcessSubblock );
 
 	return true;
@@ -1156,6 +2083,26 @@ struct ValueInInterval_T
 	{
 		return ValueInInterval<T, LEFT_CLOSED, RIGHT_CLOSED, LEFT_UNBOUNDED, RIGHT_UNBOUNDED> ( tValue, tMin, tMax );
 	}
+
+	// value is to the left of the interval (Eval is false for it and for all smaller values)
+	template<typename T=int64_t>
+	static inline bool IsBelow ( T tValue, T tMin )
+	{
+		if ( LEFT_UNBOUNDED )
+			return false;
+
+		return LEFT_CLOSED ? ( tValue<tMin ) : ( tValue<=tMin );
+	}
+
+	// value is to the right of the interval (Eval is false for it and for all greater values)
+	template<typename T=int64_t>
+	static inline bool IsAbove ( T tValue, T tMax )
+	{
+		if ( !LEFT_UNBOUNDED && RIGHT_UNBOUNDED )
+			return false;
+
+		return RIGHT_CLOSED ? ( tValue>tMax ) : ( tValue>=tMax );
+	}
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -1241,7 +2188,7 @@ private:
 bool Checker_Int_c::CheckBlockHeader ( uint32_t uBlockId )
 {
 	uint32_t uPacking = m_pReader->Unpack_uint32();
-	if ( uPacking!=(uint32_t)IntPacking_e::CONST && uPacking!=(uint32_t)IntPacking_e::TABLE && uPacking!=(uint32_t)IntPacking_e::DELTA && uPacking!=(uint32_t)IntPacking_e::GENERIC )
+	if ( uPacking>=(uint32_t)IntPacking_e::TOTAL )
 	{
 		m_fnError ( FormatStr ( "Unknown encoding of block %u: %u", uBlockId, uPacking ).c_str() );
 		return false;
@@ -19,6 +19,7 @@
 #include "buildermva.h"
 #include "reader.h"
 #include "check.h"
+#include "subblockcache.h"
 
 #include <algorithm>
 
@@ -376,6 +377,63 @@ void StoredBlock_MvaTable_T<T>::ReadSubblock ( int iSubblockId, int iNumValues,
 
 //////////////////////////////////////////////////////////////////////////
 
+template <typename T>
+class StoredBlock_MvaRLE_T
+{
+public:
+								StoredBlock_MvaRLE_T ( const std::string & sCodec32, const std::string & sCodec64, int iSubblockSize );
+
+	FORCE_INLINE void			ReadHeader ( FileReader_c & tReader );
+
+	template <bool PACK>
+	FORCE_INLINE uint32_t		GetValue ( uint8_t * & pValue, uint32_t uIdInBlock )	{ return PackValue<T,PACK> ( m_dValuePtrs [ m_tRuns.GetRun(uIdInBlock) ], pValue ); }
+	FORCE_INLINE int			GetValueLength ( uint32_t uIdInBlock )					{ return (int)m_dValuePtrs [ m_tRuns.GetRun(uIdInBlock) ].size()*sizeof(T); }
+
+	template <typename T_COMP>
+	FORCE_INLINE Span_T<T_COMP>	GetRunValue ( int iRun ) const { return { (T_COMP*)m_dValuePtrs[iRun].data(), m_dValuePtrs[iRun].size() }; }
+	FORCE_INLINE int			GetNumRuns() const { return m_tRuns.GetNumRuns(); }
+	FORCE_INLINE const StoredBlock_Runs_c & GetRuns() const { return m_tRuns; }
+
+private:
+	std::unique_ptr<IntCodec_i>	m_pCodec;
+	StoredBlock_Runs_c			m_tRuns;
+	SpanResizeable_T<uint32_t>	m_dTmp;
+
+	SpanResizeable_T<uint32_t>	m_dLengths;
+	SpanResizeable_T<T>			m_dValues;
+	std::vector<Span_T<T>>		m_dValuePtrs;
+};
+
+template <typename T>
+StoredBlock_MvaRLE_T<T>::StoredBlock_MvaRLE_T ( const std::string & sCodec32, const std::string & sCodec64, int iSubblockSize )
+	: m_pCodec ( CreateIntCodec ( sCodec32, sCodec64 ) )
+	, m_tRuns ( iSubblockSize, sCodec32, sCodec64 )
+{}
+
+template <typename T>
+void StoredBlock_MvaRLE_T<T>::ReadHeader ( FileReader_c & tReader )
+{
+	m_tRuns.ReadHeader(tReader);
+
+	// run values are stored the same way as table values
+	uint32_t uSizeOfLengths = tReader.Unpack_uint32();
+	DecodeValues_PFOR ( m_dLengths, tReader, *m_pCodec, m_dTmp, uSizeOfLengths );
+	assert ( (int)m_dLengths.size()==m_tRuns.GetNumRuns() );
+
+	uint32_t uSizeOfValues = tReader.Unpack_uint32();
+	uint32_t uTotalLength = 0;
+	for ( auto i : m_dLengths )
+		uTotalLength += i;
+
+	m_dValues.resize(uTotalLength);
+	DecodeValues_PFOR ( m_dValues, tReader, *m_pCodec, m_dTmp, uSizeOfValues );
+
+	PrecalcSizeOffset ( m_dLengths, m_dValues, m_dValuePtrs );
+	ApplyInverseDeltas ( m_dValues, m_dValuePtrs );
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 template <typename T>
 class StoredBlock_MvaPFOR_T
 {
@@ -389,6 +447,7 @@ public:
 	FORCE_INLINE uint32_t	GetValue ( uint8_t * & pValue, int iIdInSubblock ) const;
 	FORCE_INLINE int		GetValueLength ( int iIdInSubblock ) const	{ return (int)m_dValuePtrs[iIdInSubblock].size()*sizeof(T); }
 	FORCE_INLINE const std::vector<Span_T<T>> & GetAllValues() const	{ return m_dValuePtrs; }
+	FORCE_INLINE void		SetCacheKey ( uint64_t uAttrUID, uint32_t uBlockId ) { m_tCacheKey = { uAttrUID, uBlockId, 0, sizeof(T) }; }
 
 private:
 	std::unique_ptr<IntCodec_i>	m_pCodec;
@@ -401,6 +460,12 @@ private:
 
 	int64_t						m_tValuesOffset = 0;
 	int							m_iSubblockId = -1;
+
+	SubblockCacheKey_t			m_tCacheKey;
+	CachedSubblockPtr_t			m_pCachedSubblock;
+
+	FORCE_INLINE bool			ReadCachedSubblock ( SubblockCache_i & tCache, int iSubblockId, int iSubblockValues );
+	FORCE_INLINE void			AddCachedSubblock ( SubblockCache_i & tCache );
 };
 
 template <typename T>
@@ -426,6 +491,12 @@ void StoredBlock_MvaPFOR_T<T>::ReadSubblock ( int iSubblockId, int iSubblockValu
 
 	m_iSubblockId = iSubblockId;
 
+	SubblockCache_i * pCache = GetSubblockCache();
+	if ( pCache && ReadCachedSubblock ( *pCache, iSubblockId, iSubblockValues ) )
+		return;
+
+	m_pCachedSubblock.reset();
+
 	uint32_t uSize = m_dSubblockCumulativeSizes[iSubblockId];
 	uint32_t uOffset = 0;
 	if ( iSubblockId>0 )
@@ -450,6 +521,41 @@ void StoredBlock_MvaPFOR_T<T>::ReadSubblock ( int iSubblockId, int iSubblockValu
 
 	PrecalcSizeOffset ( m_dLengths, m_dValues, m_dValuePtrs );
 	ApplyInverseDeltas ( m_dValues, m_dValuePtrs );
+
+	if ( pCache )
+		AddCachedSubblock(*pCache);
+}
+
+// cached MVA subblocks store value lengths followed by the values (aligned to 8 bytes)
+static FORCE_INLINE size_t GetCachedMvaValuesOffset ( size_t tNumLengths )
+{
+	return ( tNumLengths*sizeof(uint32_t) + 7 ) & ~(size_t)7;
+}
+
+template <typename T>
+bool StoredBlock_MvaPFOR_T<T>::ReadCachedSubblock ( SubblockCache_i & tCache, int iSubblockId, int iSubblockValues )
+{
+	m_tCacheKey.m_uSubblockId = iSubblockId;
+	m_pCachedSubblock = tCache.Find(m_tCacheKey);
+	if ( !m_pCachedSubblock )
+		return false;
+
+	Span_T<uint32_t> dLengths ( GetCachedValues<uint32_t>(*m_pCachedSubblock).data(), iSubblockValues );
+	Span_T<T> dValues = GetCachedValues<T> ( *m_pCachedSubblock, GetCachedMvaValuesOffset(iSubblockValues) );
+	PrecalcSizeOffset ( dLengths, dValues, m_dValuePtrs );
+	return true;
+}
+
+template <typename T>
+void StoredBlock_MvaPFOR_T<T>::AddCachedSubblock ( SubblockCache_i & tCache )
+{
+	size_t tValuesOffset = GetCachedMvaValuesOffset ( m_dLengths.size() );
+
+	auto pSubblock = std::make_shared<CachedSubblock_t>();
+	pSubblock->m_dData.resize ( tValuesOffset + m_dValues.size()*sizeof(T) );
+	memcpy ( pSubblock->m_dData.data(), m_dLengths.data(), m_dLengths.size()*sizeof(uint32_t) );
+	memcpy ( pSubblock->m_dData.data()+tValuesOffset, m_dValues.data(), m_dValues.size()*sizeof(T) );
+	tCache.Add ( m_tCacheKey, pSubblock );
 }
 
 template <typename T>
@@ -479,6 +585,7 @@ protected:
 	StoredBlock_MvaConstLen_T<T>	m_tBlockConstLen;
 	StoredBlock_MvaTable_T<T>		m_tBlockTable;
 	StoredBlock_MvaPFOR_T<T>		m_tBlockPFOR;
+	StoredBlock_MvaRLE_T<T>			m_tBlockRLE;
 
 	void	(Accessor_MVA_T::*m_fnReadValue)()		= nullptr;
 	void	(Accessor_MVA_T::*m_fnReadValuePacked)()= nullptr;
@@ -501,8 +608,13 @@ protected:
 	template <bool PACK> void		ReadValue_PFOR()			{ m_tValueLength = m_tBlockPFOR.template GetValue<PACK> ( m_pResult, ReadSubblock(m_tBlockPFOR) ); }
 	int								GetValueLength_PFOR()		{ return m_tBlockPFOR.GetValueLength ( ReadSubblock(m_tBlockPFOR) ); }
 
+	template <bool PACK> void		ReadValue_RLE()				{ m_tValueLength = m_tBlockRLE.template GetValue<PACK> ( m_pResult, m_tRequestedRowID-m_tStartBlockRowId ); }
+	int								GetValueLength_RLE()		{ return m_tBlockRLE.GetValueLength ( m_tRequestedRowID-m_tStartBlockRowId ); }
+
 	template <typename SUBBLOCK>
 	FORCE_INLINE int				ReadSubblock ( SUBBLOCK & tSubblock );
+
+	FORCE_INLINE void				FetchSubblock ( int iSubblockId, const uint32_t * pRowID, const uint32_t * pRowIDEnd, int64_t * pOffset, std::vector<uint8_t> & dData );
 };
 
 template<typename T>
@@ -514,6 +626,7 @@ Accessor_MVA_T<T>::Accessor_MVA_T ( const AttributeHeader_i & tHeader, FileReade
 	, m_tBlockConstLen ( tHeader.GetSettings().m_sCompressionUINT32, tHeader.GetSettings().m_sCompressionUINT64 )
 	, m_tBlockTable ( tHeader.GetSettings().m_sCompressionUINT32, tHeader.GetSettings().m_sCompressionUINT64, tHeader.GetSettings().m_iSubblockSize )
 	, m_tBlockPFOR ( tHeader.GetSettings().m_sCompressionUINT32, tHeader.GetSettings().m_sCompressionUINT64 )
+	, m_tBlockRLE ( tHeader.GetSettings().m_sCompressionUINT32, tHeader.GetSettings().m_sCompressionUINT64, tHeader.GetSettings().m_iSubblockSize )
 {
 	assert(pReader);
 }
@@ -523,6 +636,7 @@ void Accessor_MVA_T<T>::SetCurBlock ( uint32_t uBlockId )
 {
 	m_pReader->Seek ( m_tHeader.GetBlockOffset(uBlockId) );
 	m_ePacking = (MvaPacking_e)m_pReader->Unpack_uint32();
+	m_tBlockPFOR.SetCacheKey ( m_tHeader.GetUID(), uBlockId );
 
 	uint32_t uDocsInBlock = m_tHeader.GetNumDocs(uBlockId);
 
@@ -556,6 +670,13 @@ void Accessor_MVA_T<T>::SetCurBlock ( uint32_t uBlockId )
 		m_tBlockPFOR.ReadHeader ( *m_pReader );
 		break;
 
+	case MvaPacking_e::RLE:
+		m_fnReadValue		= &Accessor_MVA_T<T>::ReadValue_RLE<false>;
+		m_fnReadValuePacked = &Accessor_MVA_T<T>::ReadValue_RLE<true>;
+		m_fnGetValueLength	= &Accessor_MVA_T<T>::GetValueLength_RLE;
+		m_tBlockRLE.ReadHeader ( *m_pReader );
+		break;
+
 	default:
 		assert ( 0 && "Packing not implemented yet" );
 		break;
@@ -577,6 +698,65 @@ int Accessor_MVA_T<T>::ReadSubblock ( SUBBLOCK & tSubblock )
 	return GetValueIdInSubblock(uIdInBlock);
 }
 
+// appends values of rowids from one subblock of the current block to the fetch arena
+template <typename T>
+void Accessor_MVA_T<T>::FetchSubblock ( int iSubblockId, const uint32_t * pRowID, const uint32_t * pRowIDEnd, int64_t * pOffset, std::vector<uint8_t> & dData )
+{
+	int iNumValues = StoredBlockTraits_t::GetNumSubblockValues(iSubblockId);
+	uint32_t tSubblockStart = m_tStartBlockRowId + StoredBlockTraits_t::SubblockId2RowId(iSubblockId);
+	uint8_t * pValue = nullptr;
+
+	switch ( m_ePacking )
+	{
+	case MvaPacking_e::CONST:
+	{
+		uint32_t uLength = m_tBlockConst.template GetValue<false>(pValue);
+		for ( ; pRowID<pRowIDEnd; pRowID++ )
+			AppendFetchedValue ( pValue, uLength, dData, pOffset );
+	}
+	break;
+
+	case MvaPacking_e::CONSTLEN:
+		m_tBlockConstLen.ReadSubblock ( iSubblockId, iNumValues, *m_pReader );
+		for ( ; pRowID<pRowIDEnd; pRowID++ )
+		{
+			uint32_t uLength = m_tBlockConstLen.template GetValue<false> ( pValue, *pRowID-tSubblockStart );
+			AppendFetchedValue ( pValue, uLength, dData, pOffset );
+		}
+		break;
+
+	case MvaPacking_e::TABLE:
+		m_tBlockTable.ReadSubblock ( iSubblockId, iNumValues, *m_pReader );
+		for ( ; pRowID<pRowIDEnd; pRowID++ )
+		{
+			uint32_t uLength = m_tBlockTable.template GetValue<false> ( pValue, *pRowID-tSubblockStart );
+			AppendFetchedValue ( pValue, uLength, dData, pOffset );
+		}
+		break;
+
+	case MvaPacking_e::DELTA_PFOR:
+		m_tBlockPFOR.ReadSubblock ( iSubblockId, iNumValues, *m_pReader );
+		for ( ; pRowID<pRowIDEnd; pRowID++ )
+		{
+			uint32_t uLength = m_tBlockPFOR.template GetValue<false> ( pValue, *pRowID-tSubblockStart );
+			AppendFetchedValue ( pValue, uLength, dData, pOffset );
+		}
+		break;
+
+	case MvaPacking_e::RLE:
+		for ( ; pRowID<pRowIDEnd; pRowID++ )
+		{
+			uint32_t uLength = m_tBlockRLE.template GetValue<false> ( pValue, *pRowID-m_tStartBlockRowId );
+			AppendFetchedValue ( pValue, uLength, dData, pOffset );
+		}
+		break;
+
+	default:
+		assert ( 0 && "Packing not implemented yet" );
+		break;
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 
@@ -591,6 +771,7 @@ public:
 
 	int64_t		Get() final						{ assert ( 0 && "INTERNAL ERROR: requesting int from MVA iterator" ); return 0; }
 	void		Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<int64_t> & dValues ) final { assert ( 0 && "INTERNAL ERROR: requesting batch int from MVA iterator" ); }
+	void		Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<int64_t> & dOffsets, std::vector<uint8_t> & dData ) final;
 	int			Get ( const uint8_t * & pData ) final;
 	uint8_t *	GetPacked() final;
 	int			GetLength() final;
@@ -612,6 +793,31 @@ uint32_t Iterator_MVA_T<T>::AdvanceTo ( uint32_t tRowID )
 	return tRowID;
 }
 
+template <typename T>
+void Iterator_MVA_T<T>::Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<int64_t> & dOffsets, std::vector<uint8_t> & dData )
+{
+	assert ( dOffsets.size()>dRowIDs.size() );
+
+	const uint32_t * pRowID = dRowIDs.begin();
+	const uint32_t * pRowIDEnd = dRowIDs.end();
+	int64_t * pOffset = dOffsets.begin();
+	*pOffset++ = (int64_t)dData.size();
+
+	while ( pRowID<pRowIDEnd )
+	{
+		AdvanceTo(*pRowID);
+
+		// consecutive rowids from the same subblock are fetched in one go
+		int iSubblockId = 0;
+		const uint32_t * pSubblockEnd = BASE::GetSubblockRunEnd ( pRowID, pRowIDEnd, iSubblockId );
+		BASE::FetchSubblock ( iSubblockId, pRowID, pSubblockEnd, pOffset, dData );
+		BASE::m_tRequestedRowID = *(pSubblockEnd-1);
+
+		pOffset += pSubblockEnd-pRowID;
+		pRowID = pSubblockEnd;
+	}
+}
+
 template <typename T>
 int Iterator_MVA_T<T>::Get ( const uint8_t * & pData )
 {
@@ -802,6 +1008,60 @@ bool AnalyzerBlock_MVA_Table_c::SetupNextBlock ( const StoredBlock_MvaTable_T<T>
 
 //////////////////////////////////////////////////////////////////////////
 
+class AnalyzerBlock_MVA_RLE_c : public AnalyzerBlock_MVA_c
+{
+	using AnalyzerBlock_MVA_c::AnalyzerBlock_MVA_c;
+
+public:
+	FORCE_INLINE int	ProcessSubblock ( uint32_t * & pRowID, const StoredBlock_Runs_c & tRuns, int iSubblockId, int iNumValues ) { return tRuns.ProcessSubblock ( pRowID, m_tRowID, iSubblockId, iNumValues, m_dMatches ); }
+
+	template<typename T, typename T_COMP, typename FUNC>
+	FORCE_INLINE bool	SetupNextBlock ( const StoredBlock_MvaRLE_T<T> & tBlock );
+
+private:
+	std::vector<uint8_t> m_dMatches;
+
+	template<typename T_COMP, typename FUNC>
+	FORCE_INLINE bool	Test ( const Span_T<T_COMP> & dValue );
+};
+
+template<typename T_COMP, typename FUNC>
+bool AnalyzerBlock_MVA_RLE_c::Test ( const Span_T<T_COMP> & dValue )
+{
+	switch ( m_eType )
+	{
+	case FilterType_e::VALUES:
+		if ( m_dValues.size()==1 )
+			return FUNC::Test ( dValue, m_iValue );
+
+		return FUNC::Test ( dValue, m_dValues );
+
+	case FilterType_e::RANGE:
+		return FUNC::Test ( dValue, m_iMinValue, m_iMaxValue );
+
+	default:
+		return false;
+	}
+}
+
+template<typename T, typename T_COMP, typename FUNC>
+bool AnalyzerBlock_MVA_RLE_c::SetupNextBlock ( const StoredBlock_MvaRLE_T<T> & tBlock )
+{
+	bool bAnythingMatches = false;
+
+	// each run value is tested only once
+	m_dMatches.resize ( tBlock.GetNumRuns() );
+	for ( int i = 0; i < tBlock.GetNumRuns(); i++ )
+	{
+		m_dMatches[i] = Test<T_COMP,FUNC> ( tBlock.template GetRunValue<T_COMP>(i) );
+		bAnythingMatches |= !!m_dMatches[i];
+	}
+
+	return bAnythingMatches;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 class AnalyzerBlock_MVA_Values_c : public AnalyzerBlock_MVA_c
 {
 	using AnalyzerBlock_MVA_c::AnalyzerBlock_MVA_c;
@@ -889,6 +1149,7 @@ public:
 private:
 	AnalyzerBlock_MVA_Const_c	m_tBlockConst;
 	AnalyzerBlock_MVA_Table_c	m_tBlockTable;
+	AnalyzerBlock_MVA_RLE_c		m_tBlockRLE;
 	AnalyzerBlock_MVA_Values_c	m_tBlockValues;
 
 	const Filter_t &			m_tSettings;
@@ -901,6 +1162,7 @@ private:
 
 	int			ProcessSubblockConst ( uint32_t * & pRowID, int iSubblockIdInBlock );
 	int			ProcessSubblockTable ( uint32_t * & pRowID, int iSubblockIdInBlock );
+	int			ProcessSubblockRLE ( uint32_t * & pRowID, int iSubblockIdInBlock );
 
 	int			ProcessSubblockConstLen_SingleValue ( uint32_t * & pRowID, int iSubblockIdInBlock );
 	int			ProcessSubblockDeltaPFOR_SingleValue ( uint32_t * & pRowID, int iSubblockIdInBlock );
@@ -916,15 +1178,17 @@ private:
 
 template <typename T, typename T_COMP, typename FUNC, bool HAVE_MATCHING_BLOCKS>
 Analyzer_MVA_T<T,T_COMP,FUNC,HAVE_MATCHING_BLOCKS>::Analyzer_MVA_T ( const AttributeHeader_i & tHeader, FileReader_c * pReader, const Filter_t & tSettings )
-	: ANALYZER ( tHeader.GetSettings().m_iSubblockSize )
+	: ANALYZER ( tHeader, pReader )
 	, ACCESSOR ( tHeader, pReader )
 	, m_tBlockConst ( ANALYZER::m_tRowID )
 	, m_tBlockTable ( ANALYZER::m_tRowID )
+	, m_tBlockRLE ( ANALYZER::m_tRowID )
 	, m_tBlockValues ( ANALYZER::m_tRowID )
 	, m_tSettings ( tSettings )
 {
 	m_tBlockConst.Setup(m_tSettings);
 	m_tBlockTable.Setup(m_tSettings);
+	m_tBlockRLE.Setup(m_tSettings);
 	m_tBlockValues.Setup(m_tSettings);
 
 	SetupPackingFuncs();
@@ -949,6 +1213,9 @@ void Analyzer_MVA_T<T,T_COMP,FUNC,HAVE_MATCHING_BLOCKS>::SetupPackingFuncs()
 	// doesn't depend on filter type too; work off pre-calculated array
 	dFuncs [ to_underlying ( MvaPacking_e::TABLE ) ] = &Analyzer_MVA_T<T,T_COMP,FUNC,HAVE_MATCHING_BLOCKS>::ProcessSubblockTable;
 
+	// same as table; run matches are pre-calculated once per block
+	dFuncs [ to_underlying ( MvaPacking_e::RLE ) ] = &Analyzer_MVA_T<T,T_COMP,FUNC,HAVE_MATCHING_BLOCKS>::ProcessSubblockRLE;
+
 	switch ( m_tSettings.m_eType )
 	{
 	case FilterType_e::VALUES:
@@ -988,6 +1255,12 @@ int Analyzer_MVA_T<T,T_COMP,FUNC,HAVE_MATCHING_BLOCKS>::ProcessSubblockTable ( u
 	return m_tBlockTable.ProcessSubblock ( pRowID, ACCESSOR::m_tBlockTable.GetValueIndexes() );
 }
 
+template <typename T, typename T_COMP, typename FUNC, bool HAVE_MATCHING_BLOCKS>
+int Analyzer_MVA_T<T,T_COMP,FUNC,HAVE_MATCHING_BLOCKS>::ProcessSubblockRLE ( uint32_t * & pRowID, int iSubblockIdInBlock )
+{
+	return m_tBlockRLE.ProcessSubblock ( pRowID, ACCESSOR::m_tBlockRLE.GetRuns(), iSubblockIdInBlock, StoredBlockTraits_t::GetNumSubblockValues(iSubblockIdInBlock) );
+}
+
 template <typename T, typename T_COMP, typename FUNC, bool HAVE_MATCHING_BLOCKS>
 int Analyzer_MVA_T<T,T_COMP,FUNC,HAVE_MATCHING_BLOCKS>::ProcessSubblockConstLen_SingleValue ( uint32_t * & pRowID, int iSubblockIdInBlock )
 {
@@ -1037,7 +1310,7 @@ bool Analyzer_MVA_T<T,T_COMP,FUNC,HAVE_MATCHING_BLOCKS>::MoveToBlock ( int iNext
 	{
 		ANALYZER::StartBlockProcessing ( (ACCESSOR&)*this, iNextBlock );
 
-		if ( ACCESSOR::m_ePacking!=MvaPacking_e::CONST && ACCESSOR::m_ePacking!=MvaPacking_e::TABLE )
+		if ( ACCESSOR::m_ePacking!=MvaPacking_e::CONST && ACCESSOR::m_ePacking!=MvaPacking_e::TABLE && ACCESSOR::m_ePacking!=MvaPacking_e::RLE )
 			break;
 
 		if ( ACCESSOR::m_ePacking==MvaPacking_e::CONST )
@@ -1045,6 +1318,11 @@ bool Analyzer_MVA_T<T,T_COMP,FUNC,HAVE_MATCHING_BLOCKS>::MoveToBlock ( int iNext
 			if ( m_tBlockConst.template SetupNextBlock<T,T_COMP,FUNC> ( ACCESSOR::m_tBlockConst ) )
 				break;
 		}
+		else if ( ACCESSOR::m_ePacking==MvaPacking_e::RLE )
+		{
+			if ( m_tBlockRLE.template SetupNextBlock<T,T_COMP,FUNC> ( ACCESSOR::m_tBlockRLE ) )
+				break;
+		}
 		else
 		{
 			if ( m_tBlockTable.template SetupNextBlock<T,T_COMP,FUNC> ( ACCESSOR::m_tBlockTable ) )
@@ -1128,7 +1406,7 @@ private:
 bool Checker_Mva_c::CheckBlockHeader ( uint32_t uBlockId )
 {
 	uint32_t uPacking = m_pReader->Unpack_uint32();
-	if ( uPacking!=(uint32_t)MvaPacking_e::CONST && uPacking!=(uint32_t)MvaPacking_e::CONSTLEN && uPacking!=(uint32_t)MvaPacking_e::TABLE && uPacking!=(uint32_t)MvaPacking_e::DELTA_PFOR )
+	if ( uPacking!=(uint32_t)MvaPacking_e::CONST && uPacking!=(uint32_t)MvaPacking_e::CONSTLEN && uPacking!=(uint32_t)MvaPacking_e::TABLE && uPacking!=(uint32_t)MvaPacking_e::DELTA_PFOR && uPacking!=(uint32_t)MvaPacking_e::RLE )
 	{
 		m_fnError ( FormatStr ( "Unknown encoding of block %u: %u", uBlockId, uPacking ).c_str() );
 		return false;
@@ -151,6 +151,7 @@ Span_T<Span_T<uint8_t>> & StoredBlock_StrConstLen_c::ReadAllSubblockValues ( int
 {
 	int iIdInBlock = iSubblockIdInBlock*m_iSubblockSize;
 	tReader.Seek ( m_tValuesOffset + int64_t(iIdInBlock)*m_tValueLength );
+	m_iLastReadId = -1;
 
 	uint64_t uTotalLength = m_tValueLength*iSubblockValues;
 	uint8_t * pAllData = nullptr;
@@ -300,6 +301,7 @@ void StoredBlock_StrGeneric_c::ReadHeader ( FileReader_c & tReader )
 	DecodeValues_Delta_PFOR ( m_dOffsets, tReader, *m_pCodec, m_dTmp, uSubblockSize, false );
 
 	m_tValuesOffset = tReader.GetPos();
+	m_iSubblockId = -1;
 }
 
 
@@ -335,6 +337,7 @@ Span_T<uint8_t> StoredBlock_StrGeneric_c::ReadValue ( int iIdInSubblock, FileRea
 		tReader.Seek(iOffset);
 
 	m_iLastReadId = iIdInSubblock;
+	m_bValuesRead = false;	// values read by ReadAllSubblockValues may point to reader's buffer
 	uint8_t * pValue = nullptr;
 
 	if ( PACK )
@@ -366,6 +369,7 @@ Span_T<Span_T<uint8_t>> & StoredBlock_StrGeneric_c::ReadAllSubblockValues ( int
 
 	m_bValuesRead = true;
 	tReader.Seek(m_iFirstValueOffset);
+	m_iLastReadId = -1;
 
 	uint64_t uTotalLength = m_dCumulativeLengths.back();
 	uint8_t * pAllData = nullptr;
@@ -392,6 +396,68 @@ Span_T<Span_T<uint8_t>> & StoredBlock_StrGeneric_c::ReadAllSubblockValues ( int
 
 //////////////////////////////////////////////////////////////////////////
 
+class StoredBlock_StrRLE_c
+{
+public:
+							StoredBlock_StrRLE_c ( const std::string & sCodec32, const std::string & sCodec64, int iSubblockSize );
+
+	FORCE_INLINE void		ReadHeader ( FileReader_c & tReader );
+	FORCE_INLINE int		GetValueLength ( uint32_t uIdInBlock )		{ return m_dRunValueLengths [ m_tRuns.GetRun(uIdInBlock) ]; }
+	template <bool PACK>
+	FORCE_INLINE Span_T<uint8_t> GetValue ( uint32_t uIdInBlock );
+
+	FORCE_INLINE int		GetNumRuns() const							{ return m_tRuns.GetNumRuns(); }
+	FORCE_INLINE int		GetRunValueLength ( int iRun ) const		{ return m_dRunValueLengths[iRun]; }
+	FORCE_INLINE Span_T<const uint8_t> GetRunValue ( int iRun ) const	{ return Span_T<const uint8_t> ( m_dRunValues.data()+m_dRunValueOffsets[iRun], m_dRunValueLengths[iRun] ); }
+	FORCE_INLINE const StoredBlock_Runs_c & GetRuns() const				{ return m_tRuns; }
+
+private:
+	std::unique_ptr<IntCodec_i>			m_pCodec;
+	StoredBlock_Runs_c					m_tRuns;
+	SpanResizeable_T<uint32_t>			m_dRunValueLengths;
+	std::vector<uint64_t>				m_dRunValueOffsets;
+	std::vector<uint8_t>				m_dRunValues;
+	SpanResizeable_T<uint32_t> 			m_dTmp;
+};
+
+
+StoredBlock_StrRLE_c::StoredBlock_StrRLE_c ( const std::string & sCodec32, const std::string & sCodec64, int iSubblockSize )
+	: m_pCodec ( CreateIntCodec ( sCodec32, sCodec64 ) )
+	, m_tRuns ( iSubblockSize, sCodec32, sCodec64 )
+{}
+
+
+void StoredBlock_StrRLE_c::ReadHeader ( FileReader_c & tReader )
+{
+	m_tRuns.ReadHeader(tReader);
+
+	uint32_t uTotalSizeOfLengths = (uint32_t)tReader.Unpack_uint64();
+	DecodeValues_PFOR ( m_dRunValueLengths, tReader, *m_pCodec, m_dTmp, uTotalSizeOfLengths );
+	assert ( (int)m_dRunValueLengths.size()==m_tRuns.GetNumRuns() );
+
+	m_dRunValueOffsets.resize ( m_dRunValueLengths.size() );
+	uint64_t uOffset = 0;
+	for ( size_t i = 0; i < m_dRunValueLengths.size(); i++ )
+	{
+		m_dRunValueOffsets[i] = uOffset;
+		uOffset += m_dRunValueLengths[i];
+	}
+
+	m_dRunValues.resize(uOffset);
+	tReader.Read ( m_dRunValues.data(), uOffset );
+}
+
+template <bool PACK>
+Span_T<uint8_t> StoredBlock_StrRLE_c::GetValue ( uint32_t uIdInBlock )
+{
+	int iRun = m_tRuns.GetRun(uIdInBlock);
+	uint8_t * pValue = nullptr;
+	uint32_t uLen = PackValue<uint8_t,PACK> ( Span_T<uint8_t> ( m_dRunValues.data()+m_dRunValueOffsets[iRun], m_dRunValueLengths[iRun] ), pValue );
+	return {pValue, uLen};
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 class Accessor_String_c : public StoredBlockTraits_t
 {
 	using BASE = StoredBlockTraits_t;
@@ -410,6 +476,7 @@ protected:
 	StoredBlock_StrConstLen_c		m_tBlockConstLen;
 	StoredBlock_StrTable_c			m_tBlockTable;
 	StoredBlock_StrGeneric_c		m_tBlockGeneric;
+	StoredBlock_StrRLE_c			m_tBlockRLE;
 
 	Span_T<uint8_t>					m_tResult;
 
@@ -429,8 +496,13 @@ protected:
 	template <bool PACK> void ReadValue_Generic()	{ m_tResult = m_tBlockGeneric.template ReadValue<PACK>( ReadSubblock(m_tBlockGeneric), *m_pReader ); }
 	int			GetValueLen_Generic()				{ return m_tBlockGeneric.GetValueLength ( ReadSubblock(m_tBlockGeneric) ); }
 
+	template <bool PACK> void ReadValue_RLE()		{ m_tResult = m_tBlockRLE.template GetValue<PACK> ( m_tRequestedRowID-m_tStartBlockRowId ); }
+	int			GetValueLen_RLE()					{ return m_tBlockRLE.GetValueLength ( m_tRequestedRowID-m_tStartBlockRowId ); }
+
 	template <typename T>
 	FORCE_INLINE int ReadSubblock ( T & tSubblock );
+
+	FORCE_INLINE void FetchSubblock ( int iSubblockId, const uint32_t * pRowID, const uint32_t * pRowIDEnd, int64_t * pOffset, std::vector<uint8_t> & dData );
 };
 
 
@@ -441,6 +513,7 @@ Accessor_String_c::Accessor_String_c ( const AttributeHeader_i & tHeader, FileRe
 	, m_tBlockConstLen ( tHeader.GetSettings().m_iSubblockSize )
 	, m_tBlockTable ( tHeader.GetSettings().m_sCompressionUINT32, tHeader.GetSettings().m_sCompressionUINT64, tHeader.GetSettings().m_iSubblockSize )
 	, m_tBlockGeneric ( tHeader.GetSettings().m_sCompressionUINT32, tHeader.GetSettings().m_sCompressionUINT64 )
+	, m_tBlockRLE ( tHeader.GetSettings().m_sCompressionUINT32, tHeader.GetSettings().m_sCompressionUINT64, tHeader.GetSettings().m_iSubblockSize )
 {
 	assert(pReader);
 }
@@ -481,6 +554,13 @@ void Accessor_String_c::SetCurBlock ( uint32_t uBlockId )
 		m_tBlockGeneric.ReadHeader ( *m_pReader );
 		break;
 
+	case StrPacking_e::RLE:
+		m_fnReadValue			= &Accessor_String_c::ReadValue_RLE<false>;
+		m_fnReadValuePacked		= &Accessor_String_c::ReadValue_RLE<true>;
+		m_fnGetValueLength		= &Accessor_String_c::GetValueLen_RLE;
+		m_tBlockRLE.ReadHeader ( *m_pReader );
+		break;
+
 	default:
 		assert ( 0 && "Packing not implemented yet" );
 		break;
@@ -501,6 +581,93 @@ int Accessor_String_c::ReadSubblock ( T & tSubblock )
 	return GetValueIdInSubblock(uIdInBlock);
 }
 
+// appends values of rowids from one subblock of the current block to the fetch arena
+void Accessor_String_c::FetchSubblock ( int iSubblockId, const uint32_t * pRowID, const uint32_t * pRowIDEnd, int64_t * pOffset, std::vector<uint8_t> & dData )
+{
+	// reading all subblock values in one go only pays off when most of them are requested
+	const int SPARSE_FETCH_RATIO = 4;
+
+	int iNumValues = StoredBlockTraits_t::GetNumSubblockValues(iSubblockId);
+	uint32_t tSubblockStart = m_tStartBlockRowId + StoredBlockTraits_t::SubblockId2RowId(iSubblockId);
+	bool bSparse = int ( pRowIDEnd-pRowID )*SPARSE_FETCH_RATIO < iNumValues;
+
+	switch ( m_ePacking )
+	{
+	case StrPacking_e::CONST:
+	{
+		Span_T<uint8_t> tValue = m_tBlockConst.GetValue<false>();
+		for ( ; pRowID<pRowIDEnd; pRowID++ )
+			AppendFetchedValue ( tValue.data(), tValue.size(), dData, pOffset );
+	}
+	break;
+
+	case StrPacking_e::CONSTLEN:
+		if ( bSparse )
+		{
+			for ( ; pRowID<pRowIDEnd; pRowID++ )
+			{
+				Span_T<uint8_t> tValue = m_tBlockConstLen.ReadValue<false> ( *m_pReader, *pRowID-m_tStartBlockRowId );
+				AppendFetchedValue ( tValue.data(), tValue.size(), dData, pOffset );
+			}
+		}
+		else
+		{
+			const auto & dValues = m_tBlockConstLen.ReadAllSubblockValues ( iSubblockId, iNumValues, *m_pReader );
+			for ( ; pRowID<pRowIDEnd; pRowID++ )
+			{
+				const auto & tValue = dValues[*pRowID-tSubblockStart];
+				AppendFetchedValue ( tValue.data(), tValue.size(), dData, pOffset );
+			}
+		}
+		break;
+
+	case StrPacking_e::TABLE:
+	{
+		m_tBlockTable.ReadSubblock ( iSubblockId, iNumValues, *m_pReader );
+		const uint32_t * pIndexes = m_tBlockTable.GetValueIndexes().data();
+		for ( ; pRowID<pRowIDEnd; pRowID++ )
+		{
+			Span_T<const uint8_t> tValue = m_tBlockTable.GetTableValue ( pIndexes[*pRowID-tSubblockStart] );
+			AppendFetchedValue ( tValue.data(), tValue.size(), dData, pOffset );
+		}
+	}
+	break;
+
+	case StrPacking_e::GENERIC:
+		m_tBlockGeneric.ReadSubblock ( iSubblockId, iNumValues, *m_pReader );
+		if ( bSparse )
+		{
+			for ( ; pRowID<pRowIDEnd; pRowID++ )
+			{
+				Span_T<uint8_t> tValue = m_tBlockGeneric.ReadValue<false> ( *pRowID-tSubblockStart, *m_pReader );
+				AppendFetchedValue ( tValue.data(), tValue.size(), dData, pOffset );
+			}
+		}
+		else
+		{
+			const auto & dValues = m_tBlockGeneric.ReadAllSubblockValues ( iSubblockId, *m_pReader );
+			for ( ; pRowID<pRowIDEnd; pRowID++ )
+			{
+				const auto & tValue = dValues[*pRowID-tSubblockStart];
+				AppendFetchedValue ( tValue.data(), tValue.size(), dData, pOffset );
+			}
+		}
+		break;
+
+	case StrPacking_e::RLE:
+		for ( ; pRowID<pRowIDEnd; pRowID++ )
+		{
+			Span_T<uint8_t> tValue = m_tBlockRLE.GetValue<false> ( *pRowID-m_tStartBlockRowId );
+			AppendFetchedValue ( tValue.data(), tValue.size(), dData, pOffset );
+		}
+		break;
+
+	default:
+		assert ( 0 && "Packing not implemented yet" );
+		break;
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 class Iterator_String_c : public Iterator_i, public Accessor_String_c
@@ -513,6 +680,7 @@ public:
 	uint32_t	AdvanceTo ( uint32_t tRowID ) final;
 	int64_t		Get() final						{ assert ( 0 && "INTERNAL ERROR: requesting int from string iterator" ); return 0; }
 	void		Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<int64_t> & dValues ) final { assert ( 0 && "INTERNAL ERROR: requesting batch int from string iterator" ); }
+	void		Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<int64_t> & dOffsets, std::vector<uint8_t> & dData ) final;
 
 	int			Get ( const uint8_t * & pData ) final;
 	uint8_t *	GetPacked() final;
@@ -544,6 +712,31 @@ uint32_t Iterator_String_c::AdvanceTo ( uint32_t tRowID )
 }
 
 
+void Iterator_String_c::Fetch ( const Span_T<uint32_t> & dRowIDs, Span_T<int64_t> & dOffsets, std::vector<uint8_t> & dData )
+{
+	assert ( dOffsets.size()>dRowIDs.size() );
+
+	const uint32_t * pRowID = dRowIDs.begin();
+	const uint32_t * pRowIDEnd = dRowIDs.end();
+	int64_t * pOffset = dOffsets.begin();
+	*pOffset++ = (int64_t)dData.size();
+
+	while ( pRowID<pRowIDEnd )
+	{
+		AdvanceTo(*pRowID);
+
+		// consecutive rowids from the same subblock are fetched in one go
+		int iSubblockId = 0;
+		const uint32_t * pSubblockEnd = GetSubblockRunEnd ( pRowID, pRowIDEnd, iSubblockId );
+		FetchSubblock ( iSubblockId, pRowID, pSubblockEnd, pOffset, dData );
+		m_tRequestedRowID = *(pSubblockEnd-1);
+
+		pOffset += pSubblockEnd-pRowID;
+		pRowID = pSubblockEnd;
+	}
+}
+
+
 int Iterator_String_c::Get ( const uint8_t * & pData )
 {
 	assert(m_fnReadValue);
@@ -705,6 +898,39 @@ bool AnalyzerBlock_Str_Table_T<EQ>::SetupNextBlock ( const StoredBlock_StrTable_
 
 //////////////////////////////////////////////////////////////////////////
 
+template <bool EQ>
+class AnalyzerBlock_Str_RLE_T : public AnalyzerBlock_Str_T<EQ>
+{
+	using BASE = AnalyzerBlock_Str_T<EQ>;
+	using BASE::AnalyzerBlock_Str_T;
+
+public:
+	FORCE_INLINE int	ProcessSubblock ( uint32_t * & pRowID, const StoredBlock_Runs_c & tRuns, int iSubblockId, int iNumValues ) { return tRuns.ProcessSubblock ( pRowID, BASE::m_tRowID, iSubblockId, iNumValues, m_dMatches ); }
+	FORCE_INLINE bool	SetupNextBlock ( const StoredBlock_StrRLE_c & tBlock );
+
+private:
+	std::vector<uint8_t> m_dMatches;
+};
+
+template <bool EQ>
+bool AnalyzerBlock_Str_RLE_T<EQ>::SetupNextBlock ( const StoredBlock_StrRLE_c & tBlock )
+{
+	assert ( BASE::m_eType==FilterType_e::STRINGS );
+	bool bAnythingMatches = false;
+
+	// each run value is compared only once
+	m_dMatches.resize ( tBlock.GetNumRuns() );
+	for ( int i = 0; i < tBlock.GetNumRuns(); i++ )
+	{
+		m_dMatches[i] = BASE::template CompareStrings<false> ( i, tBlock.GetRunValueLength(i), [&tBlock]( int iRun ){ return tBlock.GetRunValue(iRun); } );
+		bAnythingMatches |= !!m_dMatches[i];
+	}
+
+	return bAnythingMatches;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 template <bool EQ>
 class AnalyzerBlock_Str_Values_T : public AnalyzerBlock_Str_T<EQ>
 {
@@ -751,6 +977,7 @@ public:
 private:
 	AnalyzerBlock_Str_Const_T<EQ>	m_tBlockConst;
 	AnalyzerBlock_Str_Table_T<EQ>	m_tBlockTable;
+	AnalyzerBlock_Str_RLE_T<EQ>		m_tBlockRLE;
 	AnalyzerBlock_Str_Values_T<EQ>	m_tBlockValues;
 
 	const Filter_t &				m_tSettings;
@@ -763,6 +990,7 @@ private:
 
 	int			ProcessSubblockConst ( uint32_t * & pRowID, int iSubblockIdInBlock );
 	int			ProcessSubblockTable ( uint32_t * & pRowID, int iSubblockIdInBlock );
+	int			ProcessSubblockRLE ( uint32_t * & pRowID, int iSubblockIdInBlock );
 	template<bool SINGLEVALUE> int	ProcessSubblockConstLen ( uint32_t * & pRowID, int iSubblockIdInBlock );
 	template<bool SINGLEVALUE> int	ProcessSubblockGeneric ( uint32_t * & pRowID, int iSubblockIdInBlock );
 
@@ -771,15 +999,17 @@ private:
 
 template <bool HAVE_MATCHING_BLOCKS, bool EQ>
 Analyzer_String_T<HAVE_MATCHING_BLOCKS,EQ>::Analyzer_String_T ( const AttributeHeader_i & tHeader, FileReader_c * pReader, const Filter_t & tSettings )
-	: ANALYZER ( tHeader.GetSettings().m_iSubblockSize )
+	: ANALYZER ( tHeader, pReader )
 	, ACCESSOR ( tHeader, pReader )
 	, m_tBlockConst ( ANALYZER::m_tRowID )
 	, m_tBlockTable ( ANALYZER::m_tRowID )
+	, m_tBlockRLE ( ANALYZER::m_tRowID )
 	, m_tBlockValues ( ANALYZER::m_tRowID )
 	, m_tSettings ( tSettings )
 {
 	m_tBlockConst.Setup(m_tSettings);
 	m_tBlockTable.Setup(m_tSettings);
+	m_tBlockRLE.Setup(m_tSettings);
 	m_tBlockValues.Setup(m_tSettings);
 
 	SetupPackingFuncs();
@@ -804,6 +1034,9 @@ void Analyzer_String_T<HAVE_MATCHING_BLOCKS,EQ>::SetupPackingFuncs()
 	// doesn't depend on filter type too; work off pre-calculated array
 	dFuncs [ to_underlying ( StrPacking_e::TABLE ) ] = &Analyzer_String_T<HAVE_MATCHING_BLOCKS,EQ>::ProcessSubblockTable;
 
+	// same as table; run matches are pre-calculated once per block
+	dFuncs [ to_underlying ( StrPacking_e::RLE ) ] = &Analyzer_String_T<HAVE_MATCHING_BLOCKS,EQ>::ProcessSubblockRLE;
+
 	switch ( m_tSettings.m_eType )
 	{
 	case FilterType_e::STRINGS:
@@ -838,6 +1071,12 @@ int Analyzer_String_T<HAVE_MATCHING_BLOCKS,EQ>::ProcessSubblockTable ( uint32_t
 	return m_tBlockTable.ProcessSubblock ( pRowID, ACCESSOR::m_tBlockTable.GetValueIndexes() );
 }
 
+template <bool HAVE_MATCHING_BLOCKS, bool EQ>
+int Analyzer_String_T<HAVE_MATCHING_BLOCKS,EQ>::ProcessSubblockRLE ( uint32_t * & pRowID, int iSubblockIdInBlock )
+{
+	return m_tBlockRLE.ProcessSubblock ( pRowID, ACCESSOR::m_tBlockRLE.GetRuns(), iSubblockIdInBlock, StoredBlockTraits_t::GetNumSubblockValues(iSubblockIdInBlock) );
+}
+
 template <bool HAVE_MATCHING_BLOCKS, bool EQ>
 template <bool SINGLEVALUE>
 int Analyzer_String_T<HAVE_MATCHING_BLOCKS,EQ>::ProcessSubblockConstLen ( uint32_t * & pRowID, int iSubblockIdInBlock )
@@ -876,7 +1115,7 @@ bool Analyzer_String_T<HAVE_MATCHING_BLOCKS,EQ>::MoveToBlock ( int iNextBlock )
 	{
 		ANALYZER::StartBlockProcessing ( (ACCESSOR&)*this, iNextBlock );
 
-		if ( ACCESSOR::m_ePacking!=StrPacking_e::CONST && ACCESSOR::m_ePacking!=StrPacking_e::TABLE )
+		if ( ACCESSOR::m_ePacking!=StrPacking_e::CONST && ACCESSOR::m_ePacking!=StrPacking_e::TABLE && ACCESSOR::m_ePacking!=StrPacking_e::RLE )
 			break;
 
 		if ( ACCESSOR::m_ePacking==StrPacking_e::CONST )
@@ -884,6 +1123,11 @@ bool Analyzer_String_T<HAVE_MATCHING_BLOCKS,EQ>::MoveToBlock ( int iNextBlock )
 			if ( m_tBlockConst.SetupNextBlock ( ACCESSOR::m_tBlockConst ) )
 				break;
 		}
+		else if ( ACCESSOR::m_ePacking==StrPacking_e::RLE )
+		{
+			if ( m_tBlockRLE.SetupNextBlock ( ACCESSOR::m_tBlockRLE ) )
+				break;
+		}
 		else
 		{
 			if ( m_tBlockTable.SetupNextBlock ( ACCESSOR::m_tBlockTable ) )
@@ -938,7 +1182,7 @@ private:
 bool Checker_String_c::CheckBlockHeader ( uint32_t uBlockId )
 {
 	uint32_t uPacking = m_pReader->Unpack_uint32();
-	if ( uPacking!=(uint32_t)StrPacking_e::CONST && uPacking!=(uint32_t)StrPacking_e::CONSTLEN && uPacking!=(uint32_t)StrPacking_e::TABLE && uPacking!=(uint32_t)StrPacking_e::GENERIC )
+	if ( uPacking!=(uint32_t)StrPacking_e::CONST && uPacking!=(uint32_t)StrPacking_e::CONSTLEN && uPacking!=(uint32_t)StrPacking_e::TABLE && uPacking!=(uint32_t)StrPacking_e::GENERIC && uPacking!=(uint32_t)StrPacking_e::RLE )
 	{
 		m_fnError ( FormatStr ( "Unknown encoding of block %u: %u", uBlockId, uPacking ).c_str() );
 		return false;
@@ -22,6 +22,8 @@
 #include "reader.h"
 #include "delta.h"
 #include <cassert>
+#include <chrono>
+#include <algorithm>
 
 #if defined(USE_SIMDE)
 	#define SIMDE_ENABLE_NATIVE_ALIASES 1
@@ -107,17 +109,39 @@ struct StoredBlockTraits_t : SubblockCalc_t
 		int iLeftover = m_uNumDocsInBlock & (m_iSubblockSize-1);
 		return iLeftover ? iLeftover : m_iSubblockSize;
 	}
+
+	// batched fetches process rowids subblock by subblock; returns the end of the run of rowids that share a subblock with the first one
+	FORCE_INLINE const uint32_t * GetSubblockRunEnd ( const uint32_t * pRowID, const uint32_t * pRowIDEnd, int & iSubblockId ) const
+	{
+		iSubblockId = GetSubblockId ( *pRowID - m_tStartBlockRowId );
+		uint32_t tSubblockStart = m_tStartBlockRowId + SubblockId2RowId(iSubblockId);
+		uint32_t tSubblockEnd = tSubblockStart + GetNumSubblockValues(iSubblockId);
+
+		const uint32_t * pRunEnd = pRowID+1;
+		while ( pRunEnd<pRowIDEnd && *pRunEnd>=tSubblockStart && *pRunEnd<tSubblockEnd )
+			pRunEnd++;
+
+		return pRunEnd;
+	}
 };
 
+// appends a value to the arena of a batched blob fetch and stores the offset of its end
+FORCE_INLINE void AppendFetchedValue ( const uint8_t * pValue, size_t tLength, std::vector<uint8_t> & dData, int64_t * & pOffset )
+{
+	dData.insert ( dData.end(), pValue, pValue+tLength );
+	*pOffset++ = (int64_t)dData.size();
+}
+
 // common traits of all columnar analyzers
 template <bool HAVE_MATCHING_BLOCKS>
 class Analyzer_T : public Analyzer_i
 {
 public:
-				Analyzer_T ( int iSubblockSize );
+				Analyzer_T ( const AttributeHeader_i & tHeader, util::FileReader_c * pReader );
 
 	int64_t		GetNumProcessed() const final { return m_iNumProcessed; }
 	void		Setup ( SharedBlocks_c & pBlocks, uint32_t uTotalDocs ) final;
+	void		SetLimits ( const AnalyzerLimits_t & tLimits ) final { m_tLimits = tLimits; }
 	bool		HintRowID ( uint32_t tRowID ) final;
 
 protected:
@@ -129,10 +153,21 @@ protected:
 
 	std::vector<uint32_t> m_dCollected {0};
 	SharedBlocks_c		m_pMatchingSubblocks;
+	std::vector<uint64_t> m_dFullSubblocks;	// subblocks where all values match; empty if unknown
 
 	SubblockCalc_t		m_tSubblockCalc;
+	AnalyzerLimits_t	m_tLimits;
+	int					m_iScanned = 0;		// subblocks processed and blocks skipped since StartScan
+	std::chrono::steady_clock::time_point m_tScanStart;
+	bool				m_bPaused = false;	// block skipping ran out of budget; m_iCurSubblock is where it resumes
 
 	FORCE_INLINE bool	MoveToSubblock ( int iSubblock );
+	FORCE_INLINE void	StartScan();
+	FORCE_INLINE bool	StopSkippingBlocks();
+	void				SetupFullSubblocks ( const AttributeHeader_i & tHeader, const common::Filter_t & tFilter );
+	FORCE_INLINE bool	IsSubblockFull ( int iSubblockId ) const;
+	FORCE_INLINE bool	IsCancelled() const { return m_tLimits.m_pCancel && m_tLimits.m_pCancel->load ( std::memory_order_relaxed ); }
+	FORCE_INLINE bool	IsBudgetExhausted() const;
 	virtual bool		MoveToBlock ( int iBlock ) = 0;
 
 	template <typename ACCESSOR, typename PROCESSSUBBLOCK>
@@ -143,13 +178,24 @@ protected:
 
 	template <typename ACCESSOR>
 	FORCE_INLINE bool	RewindToNextBlock ( ACCESSOR & tAccessor, int & iNextBlock );
+
+private:
+	static const int	PREFETCH_BLOCKS = 4;
+
+	const AttributeHeader_i &	m_tPrefetchHeader;
+	const util::FileReader_c *	m_pPrefetchReader = nullptr;
+	int					m_iLastPrefetchedBlock = -1;
+
+	void				PrefetchBlocks ( int iBlock );
 };
 
 template <bool HAVE_MATCHING_BLOCKS>
-Analyzer_T<HAVE_MATCHING_BLOCKS>::Analyzer_T ( int iSubblockSize )
-	: m_tSubblockCalc ( iSubblockSize )
+Analyzer_T<HAVE_MATCHING_BLOCKS>::Analyzer_T ( const AttributeHeader_i & tHeader, util::FileReader_c * pReader )
+	: m_tSubblockCalc ( tHeader.GetSettings().m_iSubblockSize )
+	, m_tPrefetchHeader ( tHeader )
+	, m_pPrefetchReader ( pReader )
 {
-	m_dCollected.resize ( iSubblockSize*2 );
+	m_dCollected.resize ( m_tSubblockCalc.m_iSubblockSize*2 );
 }
 
 template <bool HAVE_MATCHING_BLOCKS>
@@ -164,7 +210,8 @@ void Analyzer_T<HAVE_MATCHING_BLOCKS>::Setup ( SharedBlocks_c & pBlocks, uint32_
 		m_iTotalSubblocks = ( uTotalDocs+m_tSubblockCalc.m_iSubblockSize-1 ) / m_tSubblockCalc.m_iSubblockSize;
 
 	// reject everything? signal the end
-	if ( !MoveToSubblock(0) )
+	StartScan();
+	if ( !MoveToSubblock(0) && !m_bPaused )
 		m_iCurSubblock = m_iTotalSubblocks;
 }
 
@@ -172,6 +219,7 @@ template <bool HAVE_MATCHING_BLOCKS>
 bool Analyzer_T<HAVE_MATCHING_BLOCKS>::MoveToSubblock ( int iSubblock )
 {
 	m_iCurSubblock = iSubblock;
+	m_bPaused = false;
 
 	if ( iSubblock>=m_iTotalSubblocks )
 		return false;
@@ -189,6 +237,8 @@ bool Analyzer_T<HAVE_MATCHING_BLOCKS>::MoveToSubblock ( int iSubblock )
 		return true;
 	}
 
+	PrefetchBlocks(iNextBlock);
+
 	if ( !MoveToBlock ( iNextBlock ) )
 		return false;
 
@@ -200,35 +250,72 @@ bool Analyzer_T<HAVE_MATCHING_BLOCKS>::MoveToSubblock ( int iSubblock )
 	return true;
 }
 
+// asks the OS to start reading the blocks we are about to visit, so that reads issued by MoveToBlock/ProcessSubblock don't stall on cold data
 template <bool HAVE_MATCHING_BLOCKS>
-bool Analyzer_T<HAVE_MATCHING_BLOCKS>::HintRowID ( uint32_t tRowID )
+void Analyzer_T<HAVE_MATCHING_BLOCKS>::PrefetchBlocks ( int iBlock )
 {
-	int iNextSubblock = m_iCurSubblock;
+	if ( !m_pPrefetchReader )
+		return;
 
-	// we assume that we are only advancing forward
-	while ( iNextSubblock<m_iTotalSubblocks )
+	if ( !HAVE_MATCHING_BLOCKS )
 	{
-		int iSubblockID;
-		if ( HAVE_MATCHING_BLOCKS )
-			iSubblockID = m_pMatchingSubblocks->GetBlock(iNextSubblock);
-		else
-			iSubblockID = iNextSubblock;
+		int iEnd = std::min ( iBlock+PREFETCH_BLOCKS, m_tPrefetchHeader.GetNumBlocks() );
+		for ( int i = std::max ( iBlock, m_iLastPrefetchedBlock+1 ); i < iEnd; i++ )
+			m_pPrefetchReader->Prefetch ( m_tPrefetchHeader.GetBlockOffset(i), m_tPrefetchHeader.GetBlockSize(i) );
 
-		uint32_t tSubblockStart = m_tSubblockCalc.SubblockId2RowId(iSubblockID);
-		uint32_t tSubblockEnd = tSubblockStart + m_tSubblockCalc.m_iSubblockSize;
+		m_iLastPrefetchedBlock = std::max ( m_iLastPrefetchedBlock, iEnd-1 );
+		return;
+	}
 
-		if ( tRowID<tSubblockStart || ( tRowID>=tSubblockStart && tRowID<tSubblockEnd ) )
-		{
-			if ( iNextSubblock!=m_iCurSubblock )
-				return MoveToSubblock(iNextSubblock);
+	// only blocks that have matching subblocks are prefetched
+	int iPrevBlock = -1;
+	int iNumBlocks = 0;
+	for ( int i = m_iCurSubblock; i < m_iTotalSubblocks; i++ )
+	{
+		int iMatchingBlock = m_tSubblockCalc.SubblockId2BlockId ( m_pMatchingSubblocks->GetBlock(i) );
+		if ( iMatchingBlock==iPrevBlock )
+			continue;
 
-			return true;
+		if ( ++iNumBlocks > PREFETCH_BLOCKS )
+			break;
+
+		iPrevBlock = iMatchingBlock;
+		if ( iMatchingBlock>m_iLastPrefetchedBlock )
+		{
+			m_pPrefetchReader->Prefetch ( m_tPrefetchHeader.GetBlockOffset(iMatchingBlock), m_tPrefetchHeader.GetBlockSize(iMatchingBlock) );
+			m_iLastPrefetchedBlock = iMatchingBlock;
 		}
+	}
+}
+
+template <bool HAVE_MATCHING_BLOCKS>
+bool Analyzer_T<HAVE_MATCHING_BLOCKS>::HintRowID ( uint32_t tRowID )
+{
+	if ( m_iCurSubblock>=m_iTotalSubblocks )
+		return false;
 
-		iNextSubblock++;
+	// the first subblock that ends after tRowID; we assume that we are only advancing forward
+	int iSubblockId = m_tSubblockCalc.GetSubblockId(tRowID);
+	int iNextSubblock;
+	if ( HAVE_MATCHING_BLOCKS )
+	{
+		iSubblockId = m_pMatchingSubblocks->FindNext(iSubblockId);
+		if ( iSubblockId<0 )
+			return false;
+
+		iNextSubblock = m_pMatchingSubblocks->GetIndex(iSubblockId);
 	}
+	else
+		iNextSubblock = iSubblockId;
 
-	return false;
+	if ( iNextSubblock>=m_iTotalSubblocks )
+		return false;
+
+	if ( iNextSubblock<=m_iCurSubblock )
+		return true;
+
+	StartScan();
+	return MoveToSubblock(iNextSubblock) || m_bPaused;
 }
 
 template <bool HAVE_MATCHING_BLOCKS>
@@ -243,26 +330,131 @@ bool Analyzer_T<HAVE_MATCHING_BLOCKS>::GetNextRowIdBlock ( ACCESSOR & tAccessor,
 	uint32_t * pRowIdMax = pRowIdStart + tAccessor.m_iSubblockSize;
 
 	// we scan until we find at least 128 (subblock size) matches.
-	// this might lead to this analyzer scanning the whole index
-	// a more responsive version would return after processing each 128 docs
-	// (even if it doesn't find any matches)
+	// this might lead to this analyzer scanning the whole index, unless the caller set limits
+	// (in that case we return after the budget is spent, even if we didn't find any matches)
+	bool bBounded = m_tLimits.IsBounded();
+	StartScan();
+
+	// the previous call ran out of budget while skipping blocks
+	if ( m_bPaused && !MoveToSubblock(m_iCurSubblock) )
+	{
+		dRowIdBlock = { pRowIdStart, 0 };
+		return m_bPaused;
+	}
+
 	while ( pRowID<pRowIdMax )
 	{
-		int iSubblockIdInBlock;
-		if ( HAVE_MATCHING_BLOCKS )
-			iSubblockIdInBlock = tAccessor.GetSubblockIdInBlock ( m_pMatchingSubblocks->GetBlock(m_iCurSubblock) );
-		else
-			iSubblockIdInBlock = tAccessor.GetSubblockIdInBlock ( m_iCurSubblock );
+		if ( IsCancelled() )
+		{
+			m_iCurSubblock = m_iTotalSubblocks;
+			return false;
+		}
+
+		int iSubblockId = HAVE_MATCHING_BLOCKS ? m_pMatchingSubblocks->GetBlock(m_iCurSubblock) : m_iCurSubblock;
+		int iSubblockIdInBlock = tAccessor.GetSubblockIdInBlock(iSubblockId);
 
-		m_iNumProcessed += fnProcessSubblock ( pRowID, iSubblockIdInBlock );
+		if ( IsSubblockFull(iSubblockId) )
+		{
+			int iNumValues = tAccessor.GetNumSubblockValues(iSubblockIdInBlock);
+			for ( int i = 0; i < iNumValues; i++ )
+				*pRowID++ = m_tRowID++;
+
+			m_iNumProcessed += iNumValues;
+		}
+		else
+			m_iNumProcessed += fnProcessSubblock ( pRowID, iSubblockIdInBlock );
 
 		if ( !MoveToSubblock ( m_iCurSubblock+1 ) )
-			break;
+		{
+			if ( IsCancelled() )
+				return false;
+
+			if ( !m_bPaused )
+				break;
+
+			dRowIdBlock = { pRowIdStart, size_t(pRowID-pRowIdStart) };
+			return true;
+		}
+
+		// we continue from the current subblock on the next call
+		m_iScanned++;
+		if ( bBounded && IsBudgetExhausted() )
+		{
+			dRowIdBlock = { pRowIdStart, size_t(pRowID-pRowIdStart) };
+			return true;
+		}
 	}
 
 	return CheckEmptySpan ( pRowID, pRowIdStart, dRowIdBlock );
 }
 
+// must be called while the minmax tree is locked; the result is kept after the tree is unloaded
+template <bool HAVE_MATCHING_BLOCKS>
+void Analyzer_T<HAVE_MATCHING_BLOCKS>::SetupFullSubblocks ( const AttributeHeader_i & tHeader, const common::Filter_t & tFilter )
+{
+	m_dFullSubblocks.resize(0);
+	int iNumLevels = tHeader.GetNumMinMaxLevels();
+	if ( !iNumLevels || !tHeader.IsMinMaxLoaded() )
+		return;
+
+	int iNumLeaves = tHeader.GetNumMinMaxBlocks ( iNumLevels-1 );
+	std::vector<uint64_t> dLeaves ( ( iNumLeaves+63 ) >> 6, UINT64_MAX );
+	util::Span_T<uint64_t> dLeavesSpan(dLeaves);
+	if ( !tHeader.FilterCoveredMinMaxLeaves ( tFilter, dLeavesSpan ) )
+		return;
+
+	if ( std::any_of ( dLeaves.begin(), dLeaves.end(), []( uint64_t uWord ){ return uWord!=0; } ) )
+		m_dFullSubblocks = std::move(dLeaves);
+}
+
+template <bool HAVE_MATCHING_BLOCKS>
+bool Analyzer_T<HAVE_MATCHING_BLOCKS>::IsSubblockFull ( int iSubblockId ) const
+{
+	size_t tWord = iSubblockId >> 6;
+	return tWord<m_dFullSubblocks.size() && ( m_dFullSubblocks[tWord] & ( 1ULL << ( iSubblockId & 63 ) ) );
+}
+
+template <bool HAVE_MATCHING_BLOCKS>
+bool Analyzer_T<HAVE_MATCHING_BLOCKS>::IsBudgetExhausted() const
+{
+	if ( m_tLimits.m_iMaxSubblocks>0 && m_iScanned>=m_tLimits.m_iMaxSubblocks )
+		return true;
+
+	if ( m_tLimits.m_iMaxTimeUs<=0 )
+		return false;
+
+	return std::chrono::duration_cast<std::chrono::microseconds> ( std::chrono::steady_clock::now()-m_tScanStart ).count()>=m_tLimits.m_iMaxTimeUs;
+}
+
+template <bool HAVE_MATCHING_BLOCKS>
+void Analyzer_T<HAVE_MATCHING_BLOCKS>::StartScan()
+{
+	m_iScanned = 0;
+	if ( m_tLimits.m_iMaxTimeUs>0 )
+		m_tScanStart = std::chrono::steady_clock::now();
+}
+
+// called for every block that MoveToBlock skips without finding matches
+// true on cancel (m_iCurSubblock is moved to the end) or when the budget is spent (the analyzer is paused at the next block)
+template <bool HAVE_MATCHING_BLOCKS>
+bool Analyzer_T<HAVE_MATCHING_BLOCKS>::StopSkippingBlocks()
+{
+	if ( IsCancelled() )
+	{
+		m_iCurSubblock = m_iTotalSubblocks;
+		return true;
+	}
+
+	m_iScanned++;
+	if ( m_tLimits.IsBounded() && IsBudgetExhausted() )
+	{
+		m_bPaused = true;
+		return true;
+	}
+
+	return false;
+}
+
 template <bool HAVE_MATCHING_BLOCKS>
 template <typename ACCESSOR>
 void Analyzer_T<HAVE_MATCHING_BLOCKS>::StartBlockProcessing ( ACCESSOR & tAccessor, int iNextBlock )
@@ -271,6 +463,7 @@ void Analyzer_T<HAVE_MATCHING_BLOCKS>::StartBlockProcessing ( ACCESSOR & tAccess
 	tAccessor.SetCurBlock ( m_iCurBlockId );
 }
 
+// false if there are no more blocks, or if skipping was cancelled or paused
 template <bool HAVE_MATCHING_BLOCKS>
 template <typename ACCESSOR>
 bool Analyzer_T<HAVE_MATCHING_BLOCKS>::RewindToNextBlock ( ACCESSOR & tAccessor, int & iNextBlock )
@@ -279,7 +472,7 @@ bool Analyzer_T<HAVE_MATCHING_BLOCKS>::RewindToNextBlock ( ACCESSOR & tAccessor,
 	{
 		iNextBlock = m_iCurBlockId+1;
 		m_iCurSubblock = tAccessor.GetSubblockId ( BlockId2RowId(iNextBlock) );
-		return m_iCurSubblock<m_iTotalSubblocks;
+		return m_iCurSubblock<m_iTotalSubblocks && !StopSkippingBlocks();
 	}
 
 	while ( iNextBlock==m_iCurBlockId && m_iCurSubblock<m_iTotalSubblocks )
@@ -288,7 +481,7 @@ bool Analyzer_T<HAVE_MATCHING_BLOCKS>::RewindToNextBlock ( ACCESSOR & tAccessor,
 	if ( iNextBlock!=m_iCurBlockId )
 	{
 		m_iCurSubblock--;
-		return true;
+		return !StopSkippingBlocks();
 	}
 
 	return false;
@@ -365,6 +558,34 @@ FORCE_INLINE void DecodeValues_Delta_PFOR ( util::SpanResizeable_T<T> & dValues,
 	ComputeInverseDeltas ( dValues, uFlags==util::to_underlying ( IntDeltaPacking_e::DELTA_ASC ) );
 }
 
+template <typename T>
+FORCE_INLINE void DecodeValues_DeltaDelta_PFOR ( util::SpanResizeable_T<T> & dValues, util::FileReader_c & tReader, util::IntCodec_i & tCodec, util::SpanResizeable_T<uint32_t> & dTmp, uint32_t uTotalSize, bool & bSorted )
+{
+	int64_t tStart = tReader.GetPos();
+	bSorted = !!( tReader.Read_uint8() & DELTA_DELTA_SORTED );
+
+	T uFirst = (T)tReader.Unpack_uint64();
+	uint32_t uPFOREncodedSize = uint32_t ( uTotalSize - ( tReader.GetPos() - tStart ) );
+	assert ( uPFOREncodedSize % 4 == 0 );
+
+	dTmp.resize ( uPFOREncodedSize>>2 );
+	tReader.Read ( (uint8_t*)dTmp.data(), (int)dTmp.size()*sizeof(dTmp[0]) );
+
+	tCodec.Decode ( dTmp, dValues );
+
+	// restore deltas from deltas of deltas, then values from deltas
+	if ( dValues.size()>1 )
+	{
+		util::Span_T<T> dDeltas ( dValues.data()+1, dValues.size()-1 );
+		util::ZigzagDecode ( dDeltas.data(), dDeltas.size() );
+		ComputeInverseDeltas ( dDeltas, true );
+	}
+
+	assert ( !dValues[0] );
+	dValues[0] = uFirst;
+	ComputeInverseDeltas ( dValues, true );
+}
+
 template <typename T>
 FORCE_INLINE void DecodeValues_PFOR ( util::SpanResizeable_T<T> & dValues, util::FileReader_c & tReader, util::IntCodec_i & tCodec, util::SpanResizeable_T<uint32_t> & dTmp, uint32_t uTotalSize )
 {
@@ -381,6 +602,87 @@ FORCE_INLINE void DecodeValues_PFOR ( util::SpanResizeable_T<T> & dValues, util:
 	AddMinValue ( dValues, uMin );
 }
 
+// run boundaries of RLE-packed blocks (of any attribute type)
+class StoredBlock_Runs_c
+{
+public:
+							StoredBlock_Runs_c ( int iSubblockSize, const std::string & sCodec32, const std::string & sCodec64 );
+
+	FORCE_INLINE void		ReadHeader ( util::FileReader_c & tReader );
+	FORCE_INLINE int		GetNumRuns() const { return (int)m_dRunEnds.size(); }
+	FORCE_INLINE int		GetRun ( uint32_t uIdInBlock );
+
+	template <typename MATCHES>
+	FORCE_INLINE int		ProcessSubblock ( uint32_t * & pRowID, uint32_t & tRowID, int iSubblockId, int iNumValues, const MATCHES & dRunMatches ) const;
+
+private:
+	std::unique_ptr<util::IntCodec_i> m_pCodec;
+	int						m_iSubblockSize = 0;
+	util::SpanResizeable_T<uint32_t> m_dRunEnds;
+	util::SpanResizeable_T<uint32_t> m_dTmp;
+	int						m_iLastRun = 0;
+};
+
+inline StoredBlock_Runs_c::StoredBlock_Runs_c ( int iSubblockSize, const std::string & sCodec32, const std::string & sCodec64 )
+	: m_pCodec ( util::CreateIntCodec ( sCodec32, sCodec64 ) )
+	, m_iSubblockSize ( iSubblockSize )
+{}
+
+
+inline void StoredBlock_Runs_c::ReadHeader ( util::FileReader_c & tReader )
+{
+	uint32_t uTotalSize = (uint32_t)tReader.Unpack_uint64();
+	DecodeValues_Delta_PFOR ( m_dRunEnds, tReader, *m_pCodec, m_dTmp, uTotalSize, false );
+	m_iLastRun = 0;
+}
+
+
+inline int StoredBlock_Runs_c::GetRun ( uint32_t uIdInBlock )
+{
+	// rows are usually fetched in ascending order; check the last run and the one after it first
+	int iRun = m_iLastRun;
+	if ( uIdInBlock < m_dRunEnds[iRun] && ( !iRun || uIdInBlock>=m_dRunEnds[iRun-1] ) )
+		return iRun;
+
+	iRun++;
+	if ( iRun<GetNumRuns() && uIdInBlock < m_dRunEnds[iRun] && uIdInBlock>=m_dRunEnds[iRun-1] )
+	{
+		m_iLastRun = iRun;
+		return iRun;
+	}
+
+	m_iLastRun = int ( std::upper_bound ( m_dRunEnds.begin(), m_dRunEnds.end(), uIdInBlock ) - m_dRunEnds.begin() );
+	assert ( m_iLastRun<GetNumRuns() );
+	return m_iLastRun;
+}
+
+// emits rowid ranges of all matching runs that overlap with the subblock
+template <typename MATCHES>
+int StoredBlock_Runs_c::ProcessSubblock ( uint32_t * & pRowID, uint32_t & tRowID, int iSubblockId, int iNumValues, const MATCHES & dRunMatches ) const
+{
+	uint32_t uStart = uint32_t(iSubblockId)*m_iSubblockSize;
+	uint32_t uEnd = uStart + iNumValues;
+	int iRun = int ( std::upper_bound ( m_dRunEnds.begin(), m_dRunEnds.end(), uStart ) - m_dRunEnds.begin() );
+
+	uint32_t uRunStart = uStart;
+	while ( uRunStart < uEnd )
+	{
+		uint32_t uRunEnd = std::min ( m_dRunEnds[iRun], uEnd );
+		if ( dRunMatches[iRun] )
+		{
+			uint32_t tRunRowID = tRowID + uRunStart - uStart;
+			for ( uint32_t i = uRunStart; i < uRunEnd; i++ )
+				*pRowID++ = tRunRowID++;
+		}
+
+		uRunStart = uRunEnd;
+		iRun++;
+	}
+
+	tRowID += iNumValues;
+	return iNumValues;
+}
+
 template <typename T, bool PACK>
 FORCE_INLINE uint32_t PackValue ( const util::Span_T<T> & dValue, uint8_t * & pValue )
 {
@@ -18,6 +18,13 @@
 #include "buildertraits.h"
 #include "reader.h"
 #include "check.h"
+#include "builderint.h"
+#include "builderbloom.h"
+#include "minmaxleaves.h"
+
+#include <climits>
+#include <limits>
+#include <atomic>
 
 namespace columnar
 {
@@ -34,22 +41,50 @@ public:
 
 	inline int			GetNumLevels() const					{ return (int)m_dTreeLevels.size(); }
 	inline int			GetNumBlocks ( int iLevel ) const		{ return m_dTreeLevels[iLevel].first; }
-	inline Element_t	Get ( int iLevel, int iBlock ) const	{ return m_dTreeLevels[iLevel].second[iBlock]; }
+	inline Element_t	Get ( int iLevel, int iBlock ) const;
+	inline Span_T<T>	GetLeafMins() const						{ return GetLeaves ( m_pMins.get() ); }
+	inline Span_T<T>	GetLeafMaxs() const						{ return GetLeaves ( m_pMaxs.get() ); }
 
 	bool				Load ( FileReader_c & tReader, std::string & sError );
 	bool				Check ( FileReader_c & tReader, Reporter_fn & fnError );
 
+	inline bool			IsTreeLoaded() const					{ return !!m_pMins || !m_iTreeElements; }
+	bool				LoadTree ( FileReader_c & tReader, std::string & sError );
+	void				UnloadTree();
+
 private:
-	using TreeLevel_t = std::pair<int,Element_t*>;
-	std::unique_ptr<Element_t[]>	m_pMinMaxTree;
+	using TreeLevel_t = std::pair<int,int>;		// number of blocks on the level; index of its first block
+	std::unique_ptr<T[]>			m_pMins;	// all levels, root first; separate arrays so that leaves can be scanned with SIMD
+	std::unique_ptr<T[]>			m_pMaxs;
 	std::unique_ptr<TreeLevel_t[]>	m_pTreeLevels;
-	Span_T<Element_t>				m_dMinMaxTree;
 	Span_T<TreeLevel_t>				m_dTreeLevels;
+	int								m_iTreeElements = 0;
+	int64_t							m_iTreeOffset = 0;
 
-	void				LoadTreeLevels ( FileReader_c & tReader );
+	inline Span_T<T>	GetLeaves ( T * pLevels ) const;
+	void				LoadTreeLevels ( FileReader_c & tReader, T * pMins, T * pMaxs );
 };
 
+template <typename T>
+typename MinMax_T<T>::Element_t MinMax_T<T>::Get ( int iLevel, int iBlock ) const
+{
+	assert ( IsTreeLoaded() );
+	int iElement = m_dTreeLevels[iLevel].second + iBlock;
+	return { m_pMins[iElement], m_pMaxs[iElement] };
+}
 
+template <typename T>
+Span_T<T> MinMax_T<T>::GetLeaves ( T * pLevels ) const
+{
+	assert ( IsTreeLoaded() );
+	if ( m_dTreeLevels.empty() || !pLevels )
+		return Span_T<T>();
+
+	const TreeLevel_t & tLeaves = m_dTreeLevels[m_dTreeLevels.size()-1];
+	return Span_T<T> ( pLevels + tLeaves.second, tLeaves.first );
+}
+
+// only the level sizes are loaded here; the tree itself is loaded on demand by LoadTree
 template <typename T>
 bool MinMax_T<T>::Load ( FileReader_c & tReader, std::string & sError )
 {
@@ -57,37 +92,57 @@ bool MinMax_T<T>::Load ( FileReader_c & tReader, std::string & sError )
 	m_pTreeLevels = std::unique_ptr<TreeLevel_t[]> ( new TreeLevel_t[iTreeLevels] );
 	m_dTreeLevels = Span_T<TreeLevel_t>( m_pTreeLevels.get(), iTreeLevels );
 
-	int iTreeElements = 0;
+	m_iTreeElements = 0;
 	for ( auto & i : m_dTreeLevels )
 	{
 		i.first = tReader.Unpack_uint32();
-		iTreeElements += i.first;
+		i.second = m_iTreeElements;
+		m_iTreeElements += i.first;
 	}
 
-	m_pMinMaxTree = std::unique_ptr<Element_t[]> ( new Element_t[iTreeElements] );
-	m_dMinMaxTree = Span_T<Element_t> ( m_pMinMaxTree.get(), iTreeElements );
+	uint64_t uTreeSize = tReader.Read_uint64();
+	m_iTreeOffset = tReader.GetPos();
+	tReader.Seek ( m_iTreeOffset + (int64_t)uTreeSize );
 
-	LoadTreeLevels(tReader);
-
-	if ( iTreeElements )
+	if ( tReader.IsError() )
 	{
-		int iCumulativeBlocks = 0;
-		for ( auto & i : m_dTreeLevels )
-		{
-			i.second = &m_dMinMaxTree[iCumulativeBlocks];
-			iCumulativeBlocks += i.first;
-		}
+		sError = tReader.GetError();
+		return false;
 	}
 
+	return true;
+}
+
+template <typename T>
+bool MinMax_T<T>::LoadTree ( FileReader_c & tReader, std::string & sError )
+{
+	if ( IsTreeLoaded() )
+		return true;
+
+	tReader.Seek(m_iTreeOffset);
+
+	std::unique_ptr<T[]> pMins ( new T[m_iTreeElements] );
+	std::unique_ptr<T[]> pMaxs ( new T[m_iTreeElements] );
+	LoadTreeLevels ( tReader, pMins.get(), pMaxs.get() );
+
 	if ( tReader.IsError() )
 	{
 		sError = tReader.GetError();
 		return false;
 	}
 
+	m_pMins = std::move(pMins);
+	m_pMaxs = std::move(pMaxs);
 	return true;
 }
 
+template <typename T>
+void MinMax_T<T>::UnloadTree()
+{
+	m_pMins.reset();
+	m_pMaxs.reset();
+}
+
 template <typename T>
 bool MinMax_T<T>::Check ( FileReader_c & tReader, Reporter_fn & fnError )
 {
@@ -110,48 +165,111 @@ bool MinMax_T<T>::Check ( FileReader_c & tReader, Reporter_fn & fnError )
 	}
 
 	// fixme: maybe add minmax tree verification (opposite of construction process)
-	for ( int i = 0; i < iTotalElements; i++ )
-	{
-		tReader.Unpack_uint64();
-		tReader.Unpack_uint64();
-	}
+	int64_t iTreeSize = 0;
+	if ( !CheckInt64 ( tReader, iTotalElements, tReader.GetFileSize()-tReader.GetPos(), "Minmax tree size", iTreeSize, fnError ) ) return false;
 
+	tReader.Seek ( tReader.GetPos()+iTreeSize );
 	return true;
 }
 
 template <typename T>
-void MinMax_T<T>::LoadTreeLevels ( FileReader_c & tReader )
+void MinMax_T<T>::LoadTreeLevels ( FileReader_c & tReader, T * pMins, T * pMaxs )
 {
-	for ( auto & i : m_dMinMaxTree )
+	for ( int i = 0; i < m_iTreeElements; i++ )
 	{
-		i.first = (T)tReader.Unpack_uint64();
-		i.second = i.first + (T)tReader.Unpack_uint64();
-		assert ( i.first<=i.second );
+		pMins[i] = (T)tReader.Unpack_uint64();
+		pMaxs[i] = pMins[i] + (T)tReader.Unpack_uint64();
+		assert ( pMins[i]<=pMaxs[i] );
 	}
 }
 
 template <>
-void MinMax_T<uint8_t>::LoadTreeLevels ( FileReader_c & tReader )
+void MinMax_T<uint8_t>::LoadTreeLevels ( FileReader_c & tReader, uint8_t * pMins, uint8_t * pMaxs )
 {
-	for ( auto & i : m_dMinMaxTree )
+	for ( int i = 0; i < m_iTreeElements; i++ )
 	{
 		uint8_t uPacked = tReader.Read_uint8();
-		i.first = ( uPacked >> 1 ) & 1;
-		i.second = uPacked & 1;
-		assert ( i.first<=i.second );
-		assert ( i.second<2 );
+		pMins[i] = ( uPacked >> 1 ) & 1;
+		pMaxs[i] = uPacked & 1;
+		assert ( pMins[i]<=pMaxs[i] );
+		assert ( pMaxs[i]<2 );
 	}
 }
 
 template <>
-void MinMax_T<float>::LoadTreeLevels ( FileReader_c & tReader )
+void MinMax_T<float>::LoadTreeLevels ( FileReader_c & tReader, float * pMins, float * pMaxs )
+{
+	for ( int i = 0; i < m_iTreeElements; i++ )
+	{
+		pMins[i] = UintToFloat ( tReader.Unpack_uint32() );
+		pMaxs[i] = UintToFloat ( tReader.Unpack_uint32() );
+		assert ( pMins[i]<=pMaxs[i] );
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+class BloomFilter_c
+{
+public:
+	inline bool	IsEmpty() const { return m_dOffsets.size()<=1; }
+	inline bool	Test ( int iBlock, uint64_t uValue ) const;
+
+	bool		Load ( FileReader_c & tReader, std::string & sError );
+	bool		Check ( FileReader_c & tReader, Reporter_fn & fnError );
+
+private:
+	std::vector<uint32_t>	m_dOffsets{0};
+	std::vector<uint64_t>	m_dFilters;
+};
+
+
+inline bool BloomFilter_c::Test ( int iBlock, uint64_t uValue ) const
+{
+	assert ( iBlock>=0 && iBlock+1<(int)m_dOffsets.size() );
+	uint32_t uStart = m_dOffsets[iBlock];
+	return BloomTest ( m_dFilters.data()+uStart, int ( m_dOffsets[iBlock+1]-uStart ), uValue );
+}
+
+
+bool BloomFilter_c::Load ( FileReader_c & tReader, std::string & sError )
 {
-	for ( auto & i :m_dMinMaxTree )
+	int iNumFilters = (int)tReader.Unpack_uint32();
+	m_dOffsets.resize ( iNumFilters+1 );
+	for ( int i = 0; i < iNumFilters; i++ )
+		m_dOffsets[i+1] = m_dOffsets[i] + tReader.Unpack_uint32();
+
+	m_dFilters.resize ( m_dOffsets.back() );
+	tReader.Read ( (uint8_t*)m_dFilters.data(), m_dFilters.size()*sizeof ( m_dFilters[0] ) );
+
+	if ( tReader.IsError() )
 	{
-		i.first = UintToFloat ( tReader.Unpack_uint32() );
-		i.second = UintToFloat ( tReader.Unpack_uint32() );
-		assert ( i.first<=i.second );
+		sError = tReader.GetError();
+		return false;
 	}
+
+	return true;
+}
+
+
+bool BloomFilter_c::Check ( FileReader_c & tReader, Reporter_fn & fnError )
+{
+	int iNumFilters = 0;
+	if ( !CheckInt32Packed ( tReader, 0, INT_MAX, "Number of bloom filters", iNumFilters, fnError ) )
+		return false;
+
+	int64_t iTotalWords = 0;
+	for ( int i = 0; i < iNumFilters; i++ )
+	{
+		int iNumWords = 0;
+		if ( !CheckInt32Packed ( tReader, 1, 65536*BLOOM_BITS_PER_VALUE/64, "Bloom filter size", iNumWords, fnError ) )
+			return false;
+
+		iTotalWords += iNumWords;
+	}
+
+	tReader.Seek ( tReader.GetPos() + iTotalWords*sizeof(uint64_t) );
+	return true;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -161,6 +279,7 @@ public:
 							AttributeHeader_c ( AttrType_e eType, uint32_t uTotalDocs );
 
 	const std::string &		GetName() const override { return m_sName; }
+	uint64_t				GetUID() const override { return m_uUID; }
 	AttrType_e				GetType() const override { return m_eType; }
 	const Settings_t &		GetSettings() const override { return m_tSettings; }
 
@@ -168,28 +287,45 @@ public:
 	int						GetNumBlocks() const override { return (int)m_dBlocks.size(); }
 	uint32_t				GetNumDocs ( int iBlock ) const override ;
 	uint64_t				GetBlockOffset ( int iBlock ) const override { return m_dBlocks[iBlock]; }
+	uint64_t				GetBlockSize ( int iBlock ) const override { return m_dBlockSizes[iBlock]; }
 
 	int						GetNumMinMaxLevels() const override { return 0; }
 	int						GetNumMinMaxBlocks ( int iLevel ) const override { return 0; }
 	std::pair<int64_t,int64_t> GetMinMax ( int iLevel, int iBlock ) const override { return {0, 0}; }
 
+	bool					IsMinMaxLoaded() const override { return true; }
+	bool					LoadMinMax ( FileReader_c & tReader, std::string & sError ) override { return true; }
+	void					UnloadMinMax() override {}
+	bool					FilterMinMaxLeaves ( const Filter_t & tFilter, Span_T<uint64_t> & dLeaves ) const override { return false; }
+	bool					FilterCoveredMinMaxLeaves ( const Filter_t & tFilter, Span_T<uint64_t> & dLeaves ) const override { return false; }
+
+	const std::vector<uint64_t> & GetDictionary() const override;
+
+	bool					HaveBloomFilter() const override { return false; }
+	bool					BloomFilterTest ( int iBlock, int64_t iValue ) const override { return true; }
+
 	bool					Load ( FileReader_c & tReader, std::string & sError ) override;
 	bool					Check ( FileReader_c & tReader, Reporter_fn & fnError ) override;
 
 private:
 	std::string				m_sName;
+	uint64_t				m_uUID = 0;
 	AttrType_e				m_eType = AttrType_e::NONE;
 	uint32_t				m_uTotalDocs = 0;
 	Settings_t				m_tSettings;
 
 	std::vector<uint64_t>	m_dBlocks{0};
+	std::vector<uint64_t>	m_dBlockSizes{0};
 };
 
 
 AttributeHeader_c::AttributeHeader_c ( AttrType_e eType, uint32_t uTotalDocs )
 	: m_eType ( eType )
 	, m_uTotalDocs ( uTotalDocs )
-{}
+{
+	static std::atomic<uint64_t> uNextUID{1};
+	m_uUID = uNextUID.fetch_add ( 1, std::memory_order_relaxed );
+}
 
 
 uint32_t AttributeHeader_c::GetNumDocs ( int iBlock ) const
@@ -204,6 +340,13 @@ uint32_t AttributeHeader_c::GetNumDocs ( int iBlock ) const
 }
 
 
+const std::vector<uint64_t> & AttributeHeader_c::GetDictionary() const
+{
+	static const std::vector<uint64_t> dEmpty;
+	return dEmpty;
+}
+
+
 bool AttributeHeader_c::Load ( FileReader_c & tReader, std::string & sError )
 {
 	m_tSettings.Load(tReader);
@@ -219,6 +362,10 @@ bool AttributeHeader_c::Load ( FileReader_c & tReader, std::string & sError )
 	for ( size_t i=1; i < m_dBlocks.size(); i++ )
 		m_dBlocks[i] = tReader.Unpack_uint64() + m_dBlocks[i-1];
 
+	m_dBlockSizes.resize ( m_dBlocks.size() );
+	for ( auto & i : m_dBlockSizes )
+		i = tReader.Unpack_uint64();
+
 	if ( tReader.IsError() )
 	{
 		sError = tReader.GetError();
@@ -249,11 +396,140 @@ bool AttributeHeader_c::Check ( FileReader_c & tReader, Reporter_fn & fnError )
 		}
 	}
 
+	for ( int i = 0; i < iBlocks; i++ )
+	{
+		int64_t iSize = (int64_t)tReader.Unpack_uint64();
+		if ( iSize<0 || iSize>iFileSize )
+		{
+			fnError ( FormatStr ( "Block size out of bounds: %lld", iSize ).c_str() );
+			return false;
+		}
+	}
+
 	return true;
 }
 
 //////////////////////////////////////////////////////////////////////////
 
+// converts VALUES/RANGE filters to a closed [min,max] range; multiple values are replaced by their bounds
+static bool GetIntFilterRange ( const Filter_t & tFilter, int64_t & iMin, int64_t & iMax, bool & bEmpty )
+{
+	bEmpty = false;
+
+	switch ( tFilter.m_eType )
+	{
+	case FilterType_e::VALUES:
+		if ( tFilter.m_dValues.empty() || ( tFilter.m_bExclude && tFilter.m_dValues.size()>1 ) )
+			return false;
+
+		iMin = *std::min_element ( tFilter.m_dValues.begin(), tFilter.m_dValues.end() );
+		iMax = *std::max_element ( tFilter.m_dValues.begin(), tFilter.m_dValues.end() );
+		return true;
+
+	case FilterType_e::RANGE:
+		iMin = tFilter.m_bLeftUnbounded ? INT64_MIN : tFilter.m_iMinValue;
+		iMax = tFilter.m_bRightUnbounded ? INT64_MAX : tFilter.m_iMaxValue;
+
+		if ( !tFilter.m_bLeftUnbounded && !tFilter.m_bLeftClosed )
+		{
+			if ( iMin==INT64_MAX )
+				bEmpty = true;
+			else
+				iMin++;
+		}
+
+		if ( !tFilter.m_bRightUnbounded && !tFilter.m_bRightClosed )
+		{
+			if ( iMax==INT64_MIN )
+				bEmpty = true;
+			else
+				iMax--;
+		}
+
+		bEmpty |= iMin>iMax;
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+// MVA minmax covers all values of all documents, so only ANY() can be checked against it
+static bool IsLeafFilterSupported ( const Filter_t & tFilter, AttrType_e eType )
+{
+	if ( eType==AttrType_e::UINT32SET || eType==AttrType_e::INT64SET )
+		return !tFilter.m_bExclude && tFilter.m_eMvaAggr==MvaAggr_e::ANY;
+
+	return true;
+}
+
+// the leaf range can tell if all values of a leaf match (MVA leaves can't: documents may have no values at all)
+static bool IsLeafRangeExact ( const Filter_t & tFilter, AttrType_e eType )
+{
+	if ( eType==AttrType_e::UINT32SET || eType==AttrType_e::INT64SET )
+		return false;
+
+	return tFilter.m_eType==FilterType_e::RANGE || ( tFilter.m_eType==FilterType_e::VALUES && tFilter.m_dValues.size()==1 );
+}
+
+template <typename T>
+static bool GetLeafRange ( const Filter_t & tFilter, AttrType_e eType, LeafRange_T<T> & tRange )
+{
+	return false;
+}
+
+template <>
+bool GetLeafRange ( const Filter_t & tFilter, AttrType_e eType, LeafRange_T<uint32_t> & tRange )
+{
+	if ( eType!=AttrType_e::UINT32 && eType!=AttrType_e::TIMESTAMP && eType!=AttrType_e::UINT32SET )
+		return false;
+
+	int64_t iMin, iMax;
+	if ( !IsLeafFilterSupported ( tFilter, eType ) || !GetIntFilterRange ( tFilter, iMin, iMax, tRange.m_bEmpty ) )
+		return false;
+
+	tRange.m_bExclude = tFilter.m_bExclude;
+	tRange.m_bExact = IsLeafRangeExact ( tFilter, eType );
+	tRange.m_bEmpty |= iMax<0 || iMin>UINT_MAX;
+	tRange.m_tMin = (uint32_t)std::max ( iMin, (int64_t)0 );
+	tRange.m_tMax = (uint32_t)std::min ( iMax, (int64_t)UINT_MAX );
+	return true;
+}
+
+template <>
+bool GetLeafRange ( const Filter_t & tFilter, AttrType_e eType, LeafRange_T<int64_t> & tRange )
+{
+	if ( eType!=AttrType_e::INT64 && eType!=AttrType_e::INT64SET )
+		return false;
+
+	if ( !IsLeafFilterSupported ( tFilter, eType ) || !GetIntFilterRange ( tFilter, tRange.m_tMin, tRange.m_tMax, tRange.m_bEmpty ) )
+		return false;
+
+	tRange.m_bExclude = tFilter.m_bExclude;
+	tRange.m_bExact = IsLeafRangeExact ( tFilter, eType );
+	return true;
+}
+
+template <>
+bool GetLeafRange ( const Filter_t & tFilter, AttrType_e eType, LeafRange_T<float> & tRange )
+{
+	if ( eType!=AttrType_e::FLOAT )
+		return false;
+
+	Filter_t tFixedFilter = tFilter;
+	FixupFilterSettings ( tFixedFilter, eType );
+	if ( tFixedFilter.m_eType!=FilterType_e::FLOATRANGE )
+		return false;
+
+	tRange.m_tMin = tFixedFilter.m_bLeftUnbounded ? -std::numeric_limits<float>::infinity() : tFixedFilter.m_fMinValue;
+	tRange.m_tMax = tFixedFilter.m_bRightUnbounded ? std::numeric_limits<float>::infinity() : tFixedFilter.m_fMaxValue;
+	tRange.m_bLeftStrict = !tFixedFilter.m_bLeftUnbounded && !tFixedFilter.m_bLeftClosed;
+	tRange.m_bRightStrict = !tFixedFilter.m_bRightUnbounded && !tFixedFilter.m_bRightClosed;
+	tRange.m_bExclude = tFixedFilter.m_bExclude;
+	tRange.m_bExact = true;
+	return true;
+}
+
 template <typename T>
 class AttributeHeader_Int_T : public AttributeHeader_c
 {
@@ -265,6 +541,12 @@ public:
 	int				GetNumMinMaxBlocks ( int iLevel ) const override	{ return m_tMinMax.GetNumBlocks(iLevel); }
 	std::pair<int64_t,int64_t> GetMinMax ( int iLevel, int iBlock ) const override;
 
+	bool			IsMinMaxLoaded() const override										{ return m_tMinMax.IsTreeLoaded(); }
+	bool			LoadMinMax ( FileReader_c & tReader, std::string & sError ) override	{ return m_tMinMax.LoadTree ( tReader, sError ); }
+	void			UnloadMinMax() override												{ m_tMinMax.UnloadTree(); }
+	bool			FilterMinMaxLeaves ( const Filter_t & tFilter, Span_T<uint64_t> & dLeaves ) const override;
+	bool			FilterCoveredMinMaxLeaves ( const Filter_t & tFilter, Span_T<uint64_t> & dLeaves ) const override;
+
 	bool			Load ( FileReader_c & tReader, std::string & sError ) override;
 	bool			Check ( FileReader_c & tReader, Reporter_fn & fnError ) override;
 
@@ -290,6 +572,28 @@ bool AttributeHeader_Int_T<T>::Check ( FileReader_c & tReader, Reporter_fn & fnE
 	return m_tMinMax.Check ( tReader, fnError );
 }
 
+template <typename T>
+bool AttributeHeader_Int_T<T>::FilterMinMaxLeaves ( const Filter_t & tFilter, Span_T<uint64_t> & dLeaves ) const
+{
+	LeafRange_T<T> tRange;
+	if ( !m_tMinMax.IsTreeLoaded() || !GetLeafRange ( tFilter, GetType(), tRange ) )
+		return false;
+
+	AndMatchingLeaves ( m_tMinMax.GetLeafMins(), m_tMinMax.GetLeafMaxs(), tRange, dLeaves );
+	return true;
+}
+
+template <typename T>
+bool AttributeHeader_Int_T<T>::FilterCoveredMinMaxLeaves ( const Filter_t & tFilter, Span_T<uint64_t> & dLeaves ) const
+{
+	LeafRange_T<T> tRange;
+	if ( !m_tMinMax.IsTreeLoaded() || !GetLeafRange ( tFilter, GetType(), tRange ) )
+		return false;
+
+	AndCoveredLeaves ( m_tMinMax.GetLeafMins(), m_tMinMax.GetLeafMaxs(), tRange, dLeaves );
+	return true;
+}
+
 template <typename T>
 std::pair<int64_t,int64_t> AttributeHeader_Int_T<T>::GetMinMax ( int iLevel, int iBlock ) const
 {
@@ -306,25 +610,81 @@ std::pair<int64_t,int64_t> AttributeHeader_Int_T<float>::GetMinMax ( int iLevel,
 
 //////////////////////////////////////////////////////////////////////////
 
+// integer attributes also store a value dictionary (used by DICT-packed blocks)
+template <typename T>
+class AttributeHeader_IntDict_T : public AttributeHeader_Int_T<T>
+{
+	using BASE = AttributeHeader_Int_T<T>;
+	using BASE::BASE;
+
+public:
+	const std::vector<uint64_t> & GetDictionary() const override { return m_dDictionary; }
+
+	bool			HaveBloomFilter() const override { return !m_tBloom.IsEmpty(); }
+	bool			BloomFilterTest ( int iBlock, int64_t iValue ) const override { return m_tBloom.Test ( iBlock, (uint64_t)(T)iValue ); }
+
+	bool			Load ( FileReader_c & tReader, std::string & sError ) override;
+	bool			Check ( FileReader_c & tReader, Reporter_fn & fnError ) override;
+
+private:
+	std::vector<uint64_t> m_dDictionary;
+	BloomFilter_c	m_tBloom;
+};
+
+template <typename T>
+bool AttributeHeader_IntDict_T<T>::Load ( FileReader_c & tReader, std::string & sError )
+{
+	if ( !BASE::Load ( tReader, sError ) )
+		return false;
+
+	ReadVectorPacked ( m_dDictionary, tReader );
+	return m_tBloom.Load ( tReader, sError );
+}
+
+// float packer stores raw float bits
+template <>
+bool AttributeHeader_IntDict_T<float>::BloomFilterTest ( int iBlock, int64_t iValue ) const
+{
+	return m_tBloom.Test ( iBlock, (uint32_t)iValue );
+}
+
+template <typename T>
+bool AttributeHeader_IntDict_T<T>::Check ( FileReader_c & tReader, Reporter_fn & fnError )
+{
+	if ( !BASE::Check ( tReader, fnError ) )
+		return false;
+
+	int iDictSize = 0;
+	if ( !CheckInt32Packed ( tReader, 0, MAX_DICTIONARY_SIZE, "Dictionary size", iDictSize, fnError ) )
+		return false;
+
+	for ( int i = 0; i < iDictSize; i++ )
+		tReader.Unpack_uint64();
+
+	return m_tBloom.Check ( tReader, fnError );
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 AttributeHeader_i * CreateAttributeHeader ( AttrType_e eType, uint32_t uTotalDocs, std::string & sError )
 {
 	switch ( eType )
 	{
 	case AttrType_e::UINT32:
 	case AttrType_e::TIMESTAMP:
-		return new AttributeHeader_Int_T<uint32_t> ( eType, uTotalDocs );
+		return new AttributeHeader_IntDict_T<uint32_t> ( eType, uTotalDocs );
 
 	case AttrType_e::INT64:
-		return new AttributeHeader_Int_T<int64_t> ( eType, uTotalDocs );
+		return new AttributeHeader_IntDict_T<int64_t> ( eType, uTotalDocs );
 
 	case AttrType_e::UINT64:
-		return new AttributeHeader_Int_T<uint64_t> ( eType, uTotalDocs );
+		return new AttributeHeader_IntDict_T<uint64_t> ( eType, uTotalDocs );
 
 	case AttrType_e::BOOLEAN:
 		return new AttributeHeader_Int_T<uint8_t> ( eType, uTotalDocs );
 
 	case AttrType_e::FLOAT:
-		return new AttributeHeader_Int_T<float> ( eType, uTotalDocs );
+		return new AttributeHeader_IntDict_T<float> ( eType, uTotalDocs );
 
 	case AttrType_e::STRING:
 		return new AttributeHeader_Int_T<uint32_t> (eType, uTotalDocs);
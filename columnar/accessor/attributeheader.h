@@ -32,6 +32,7 @@ public:
 	virtual						~AttributeHeader_i() = default;
 
 	virtual const std::string &	GetName() const = 0;
+	virtual uint64_t			GetUID() const = 0;		// unique among all headers loaded by this process
 	virtual common::AttrType_e	GetType() const = 0;
 	virtual const Settings_t &	GetSettings() const = 0;
 
@@ -39,11 +40,27 @@ public:
 	virtual int					GetNumBlocks() const = 0;
 	virtual uint32_t			GetNumDocs ( int iBlock ) const = 0;
 	virtual uint64_t			GetBlockOffset ( int iBlock ) const = 0;
+	virtual uint64_t			GetBlockSize ( int iBlock ) const = 0;
 
 	virtual int					GetNumMinMaxLevels() const = 0;
 	virtual int					GetNumMinMaxBlocks ( int iLevel ) const = 0;
 	virtual std::pair<int64_t,int64_t> GetMinMax ( int iLevel, int iBlock ) const = 0;
 
+	// minmax trees are not loaded by Load (only the number of levels and blocks are); they are loaded on demand and can be unloaded later
+	virtual bool				IsMinMaxLoaded() const = 0;
+	virtual bool				LoadMinMax ( util::FileReader_c & tReader, std::string & sError ) = 0;
+	virtual void				UnloadMinMax() = 0;
+
+	// ANDs a bitmap of minmax tree leaves (one bit per leaf) with the leaves that may match the filter; false if the filter is not supported
+	virtual bool				FilterMinMaxLeaves ( const common::Filter_t & tFilter, util::Span_T<uint64_t> & dLeaves ) const = 0;
+	// same, but keeps only the leaves where all values match the filter
+	virtual bool				FilterCoveredMinMaxLeaves ( const common::Filter_t & tFilter, util::Span_T<uint64_t> & dLeaves ) const = 0;
+
+	virtual const std::vector<uint64_t> & GetDictionary() const = 0;
+
+	virtual bool				HaveBloomFilter() const = 0;
+	virtual bool				BloomFilterTest ( int iBlock, int64_t iValue ) const = 0;	// false if the value is definitely not in the given subblock
+
 	virtual bool				Load ( util::FileReader_c & tReader, std::string & sError ) = 0;
 	virtual bool				Check ( util::FileReader_c & tReader, Reporter_fn & fnError ) = 0;
 };
@@ -108,6 +108,17 @@ bool StorageChecker_c::Check()
 		return false;
 	}
 
+	int64_t iFileSize = m_tReader.GetFileSize();
+	m_tReader.Seek ( iFileSize-sizeof(uint64_t) );
+	int64_t iDirOffset = (int64_t)m_tReader.Read_uint64();
+	if ( iDirOffset<(int64_t)sizeof(uint32_t) || iDirOffset>=iFileSize )
+	{
+		m_fnError ( FormatStr ( "Header directory offset points beyond EOF: %lld; EOF at %lld", iDirOffset, iFileSize ).c_str() );
+		return false;
+	}
+
+	m_tReader.Seek(iDirOffset);
+
 	int iNumAttrs = (int)m_tReader.Read_uint32();
 	if ( iNumAttrs && !CheckHeaders(iNumAttrs) )
 		return false;
@@ -145,6 +156,7 @@ Checker_i * StorageChecker_c::CreateChecker ( const AttributeHeader_i & tHeader
 	case AttrType_e::TIMESTAMP:
 	case AttrType_e::FLOAT:
 	case AttrType_e::INT64:
+	case AttrType_e::UINT64:
 		return CreateCheckerInt ( tHeader, pReader.release(), m_fnProgress, m_fnError );
 
 	case AttrType_e::BOOLEAN:
@@ -166,11 +178,33 @@ Checker_i * StorageChecker_c::CreateChecker ( const AttributeHeader_i & tHeader
 
 bool StorageChecker_c::CheckHeaders ( int iNumAttrs )
 {
-	m_dHeaders.resize(iNumAttrs);
+	struct DirEntry_t
+	{
+		AttrType_e	m_eType;
+		int64_t		m_iOffset;
+	};
+
 	int64_t iFileSize = m_tReader.GetFileSize();
+	std::vector<DirEntry_t> dDirectory;
+	for ( int i = 0; i < iNumAttrs; i++ )
+	{
+		if ( !CheckString ( m_tReader, 0, 1024, "Attribute name", m_fnError ) )
+			return false;
+
+		AttrType_e eType = AttrType_e ( m_tReader.Read_uint32() );
+		int64_t iOffset = 0;
+		if ( !CheckInt64 ( m_tReader, sizeof(uint32_t), iFileSize, "Header offset", iOffset, m_fnError ) )
+			return false;
+
+		dDirectory.push_back ( { eType, iOffset } );
+	}
+
+	m_dHeaders.resize(iNumAttrs);
 
 	for ( size_t i = 0; i < m_dHeaders.size(); i++ )
 	{
+		m_tReader.Seek ( dDirectory[i].m_iOffset );
+
 		AttrType_e eType = AttrType_e ( m_tReader.Read_uint32() );
 		if ( eType>=AttrType_e::TOTAL )
 		{
@@ -178,6 +212,12 @@ bool StorageChecker_c::CheckHeaders ( int iNumAttrs )
 			return false;
 		}
 
+		if ( eType!=dDirectory[i].m_eType )
+		{
+			m_fnError ( FormatStr ( "Attribute type mismatch: %u in directory, %u in header", to_underlying ( dDirectory[i].m_eType ), to_underlying(eType) ).c_str() );
+			return false;
+		}
+
 		std::string sError;
 		std::unique_ptr<AttributeHeader_i> pHeader ( CreateAttributeHeader ( eType, m_uTotalDocs, sError ) );
 		if ( !pHeader )
@@ -198,17 +238,13 @@ bool StorageChecker_c::CheckHeaders ( int iNumAttrs )
 			return false;
 		}
 
-		m_dHeaders[i] = std::move(pHeader);
-
-		int64_t iNextOffset = (int64_t)m_tReader.Read_uint64();
-		if ( iNextOffset<0 || iNextOffset>=iFileSize )
+		if ( !pHeader->LoadMinMax ( m_tReader, sError ) )
 		{
-			m_fnError ( FormatStr ( "Offset points beyond EOF: %lld; EOF at %lld", iNextOffset, iFileSize ).c_str() );
+			m_fnError ( sError.c_str() );
 			return false;
-
 		}
 
-		m_tReader.Seek(iNextOffset);
+		m_dHeaders[i] = std::move(pHeader);
 	}
 
 	return true;
@@ -0,0 +1,576 @@
+// Copyright (c) 2020-2022, Manticore Software LTD (https://manticoresearch.com)
+// All rights reserved
+//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "filterkernels.h"
+
+#include <algorithm>
+#include <cassert>
+
+#if defined(USE_SIMDE)
+	#define SIMDE_ENABLE_NATIVE_ALIASES 1
+	#include <simde/x86/sse4.1.h>
+#elif _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+// avx2 and avx-512 kernels are compiled for their instruction sets regardless of the global flags and are only called if the cpu supports them
+#if !defined(USE_SIMDE)
+	#define HAVE_AVX_KERNELS 1
+	#if _MSC_VER
+		#define TARGET_AVX2
+		#define TARGET_AVX512
+	#else
+		#define TARGET_AVX2		__attribute__((target("avx2,popcnt")))
+		#define TARGET_AVX512	__attribute__((target("avx512f,popcnt")))
+	#endif
+#endif
+
+namespace columnar
+{
+
+using namespace util;
+
+static FORCE_INLINE bool FloatInRange ( float fValue, const FloatRange_t & tRange )
+{
+	bool bLeft = tRange.m_bLeftClosed ? fValue>=tRange.m_fMin : fValue>tRange.m_fMin;
+	bool bRight = tRange.m_bRightClosed ? fValue<=tRange.m_fMax : fValue<tRange.m_fMax;
+	return bLeft && bRight;
+}
+
+// tails that don't fill a vector
+static FORCE_INLINE uint32_t * ScalarSingleValue ( const uint32_t * pValues, int iStart, int iNum, uint32_t uValue, bool bEq, uint32_t tRowID, uint32_t * pRowID )
+{
+	for ( int i = iStart; i < iNum; i++ )
+	{
+		*pRowID = tRowID+i;
+		pRowID += ( pValues[i]==uValue )==bEq;
+	}
+
+	return pRowID;
+}
+
+static FORCE_INLINE uint32_t * ScalarValues ( const uint32_t * pValues, int iStart, int iNum, const uint32_t * pFilterValues, int iNumFilterValues, uint32_t tRowID, uint32_t * pRowID )
+{
+	for ( int i = iStart; i < iNum; i++ )
+		for ( int j = 0; j < iNumFilterValues; j++ )
+			if ( pValues[i]==pFilterValues[j] )
+			{
+				*pRowID++ = tRowID+i;
+				break;
+			}
+
+	return pRowID;
+}
+
+static FORCE_INLINE uint32_t * ScalarRange ( const uint32_t * pValues, int iStart, int iNum, uint32_t uMin, uint32_t uMax, uint32_t tRowID, uint32_t * pRowID )
+{
+	for ( int i = iStart; i < iNum; i++ )
+	{
+		*pRowID = tRowID+i;
+		pRowID += pValues[i]>=uMin && pValues[i]<=uMax;
+	}
+
+	return pRowID;
+}
+
+static FORCE_INLINE uint32_t * ScalarFloatRange ( const uint32_t * pValues, int iStart, int iNum, const FloatRange_t & tRange, uint32_t tRowID, uint32_t * pRowID )
+{
+	for ( int i = iStart; i < iNum; i++ )
+	{
+		*pRowID = tRowID+i;
+		pRowID += FloatInRange ( UintToFloat ( pValues[i] ), tRange );
+	}
+
+	return pRowID;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// sse4.1 (or simde): 4 values per step; mask-to-index via a shuffle table
+
+alignas(16) static uint8_t	g_dShuffleSSE[16][16];
+alignas(32) static uint32_t	g_dPermuteAVX2[256][8];
+
+static void InitMaskTables()
+{
+	for ( int iMask = 0; iMask < 16; iMask++ )
+	{
+		int iOut = 0;
+		for ( int i = 0; i < 4; i++ )
+			if ( iMask & ( 1<<i ) )
+			{
+				for ( int iByte = 0; iByte < 4; iByte++ )
+					g_dShuffleSSE[iMask][iOut*4+iByte] = uint8_t ( i*4+iByte );
+
+				iOut++;
+			}
+
+		for ( ; iOut < 4; iOut++ )
+			for ( int iByte = 0; iByte < 4; iByte++ )
+				g_dShuffleSSE[iMask][iOut*4+iByte] = 0x80;
+	}
+
+	for ( int iMask = 0; iMask < 256; iMask++ )
+	{
+		int iOut = 0;
+		for ( int i = 0; i < 8; i++ )
+			if ( iMask & ( 1<<i ) )
+				g_dPermuteAVX2[iMask][iOut++] = i;
+
+		for ( ; iOut < 8; iOut++ )
+			g_dPermuteAVX2[iMask][iOut] = 0;
+	}
+}
+
+
+static bool g_bMaskTablesReady = ( InitMaskTables(), true );
+
+
+static FORCE_INLINE uint32_t * StoreMatchesSSE ( int iMask, __m128i tRowIDs, uint32_t * pRowID )
+{
+	__m128i tShuffle = _mm_load_si128 ( (const __m128i*)g_dShuffleSSE[iMask] );
+	_mm_storeu_si128 ( (__m128i*)pRowID, _mm_shuffle_epi8 ( tRowIDs, tShuffle ) );
+	return pRowID + PopCount ( (uint64_t)iMask );
+}
+
+
+static uint32_t * SingleValueSSE ( const uint32_t * pValues, int iNum, uint32_t uValue, bool bEq, uint32_t tRowID, uint32_t * pRowID )
+{
+	__m128i tValue = _mm_set1_epi32 ( (int)uValue );
+	__m128i tRowIDs = _mm_add_epi32 ( _mm_set1_epi32 ( (int)tRowID ), _mm_setr_epi32 ( 0, 1, 2, 3 ) );
+	__m128i tStep = _mm_set1_epi32(4);
+	int iInvert = bEq ? 0 : 0xF;
+
+	int i = 0;
+	for ( ; i+4<=iNum; i+=4 )
+	{
+		__m128i tValues = _mm_loadu_si128 ( (const __m128i*)( pValues+i ) );
+		int iMask = _mm_movemask_ps ( _mm_castsi128_ps ( _mm_cmpeq_epi32 ( tValues, tValue ) ) ) ^ iInvert;
+		pRowID = StoreMatchesSSE ( iMask, tRowIDs, pRowID );
+		tRowIDs = _mm_add_epi32 ( tRowIDs, tStep );
+	}
+
+	return ScalarSingleValue ( pValues, i, iNum, uValue, bEq, tRowID, pRowID );
+}
+
+
+static uint32_t * ValuesSSE ( const uint32_t * pValues, int iNum, const uint32_t * pFilterValues, int iNumFilterValues, uint32_t tRowID, uint32_t * pRowID )
+{
+	__m128i tRowIDs = _mm_add_epi32 ( _mm_set1_epi32 ( (int)tRowID ), _mm_setr_epi32 ( 0, 1, 2, 3 ) );
+	__m128i tStep = _mm_set1_epi32(4);
+
+	int i = 0;
+	for ( ; i+4<=iNum; i+=4 )
+	{
+		__m128i tValues = _mm_loadu_si128 ( (const __m128i*)( pValues+i ) );
+		__m128i tMatch = _mm_setzero_si128();
+		for ( int j = 0; j < iNumFilterValues; j++ )
+			tMatch = _mm_or_si128 ( tMatch, _mm_cmpeq_epi32 ( tValues, _mm_set1_epi32 ( (int)pFilterValues[j] ) ) );
+
+		pRowID = StoreMatchesSSE ( _mm_movemask_ps ( _mm_castsi128_ps(tMatch) ), tRowIDs, pRowID );
+		tRowIDs = _mm_add_epi32 ( tRowIDs, tStep );
+	}
+
+	return ScalarValues ( pValues, i, iNum, pFilterValues, iNumFilterValues, tRowID, pRowID );
+}
+
+
+static uint32_t * RangeSSE ( const uint32_t * pValues, int iNum, uint32_t uMin, uint32_t uMax, uint32_t tRowID, uint32_t * pRowID )
+{
+	__m128i tMin = _mm_set1_epi32 ( (int)uMin );
+	__m128i tMax = _mm_set1_epi32 ( (int)uMax );
+	__m128i tRowIDs = _mm_add_epi32 ( _mm_set1_epi32 ( (int)tRowID ), _mm_setr_epi32 ( 0, 1, 2, 3 ) );
+	__m128i tStep = _mm_set1_epi32(4);
+
+	int i = 0;
+	for ( ; i+4<=iNum; i+=4 )
+	{
+		// no unsigned compares in sse4.1; a>=b is the same as max(a,b)==a
+		__m128i tValues = _mm_loadu_si128 ( (const __m128i*)( pValues+i ) );
+		__m128i tLeft = _mm_cmpeq_epi32 ( _mm_max_epu32 ( tValues, tMin ), tValues );
+		__m128i tRight = _mm_cmpeq_epi32 ( _mm_min_epu32 ( tValues, tMax ), tValues );
+		pRowID = StoreMatchesSSE ( _mm_movemask_ps ( _mm_castsi128_ps ( _mm_and_si128 ( tLeft, tRight ) ) ), tRowIDs, pRowID );
+		tRowIDs = _mm_add_epi32 ( tRowIDs, tStep );
+	}
+
+	return ScalarRange ( pValues, i, iNum, uMin, uMax, tRowID, pRowID );
+}
+
+
+static uint32_t * FloatRangeSSE ( const uint32_t * pValues, int iNum, const FloatRange_t & tRange, uint32_t tRowID, uint32_t * pRowID )
+{
+	__m128 tMin = _mm_set1_ps ( tRange.m_fMin );
+	__m128 tMax = _mm_set1_ps ( tRange.m_fMax );
+	__m128i tRowIDs = _mm_add_epi32 ( _mm_set1_epi32 ( (int)tRowID ), _mm_setr_epi32 ( 0, 1, 2, 3 ) );
+	__m128i tStep = _mm_set1_epi32(4);
+
+	int i = 0;
+	for ( ; i+4<=iNum; i+=4 )
+	{
+		__m128 tValues = _mm_castsi128_ps ( _mm_loadu_si128 ( (const __m128i*)( pValues+i ) ) );
+		__m128 tLeft = tRange.m_bLeftClosed ? _mm_cmpge_ps ( tValues, tMin ) : _mm_cmpgt_ps ( tValues, tMin );
+		__m128 tRight = tRange.m_bRightClosed ? _mm_cmple_ps ( tValues, tMax ) : _mm_cmplt_ps ( tValues, tMax );
+		pRowID = StoreMatchesSSE ( _mm_movemask_ps ( _mm_and_ps ( tLeft, tRight ) ), tRowIDs, pRowID );
+		tRowIDs = _mm_add_epi32 ( tRowIDs, tStep );
+	}
+
+	return ScalarFloatRange ( pValues, i, iNum, tRange, tRowID, pRowID );
+}
+
+//////////////////////////////////////////////////////////////////////////
+// avx2: 8 values per step; mask-to-index via a permutation table
+
+#if HAVE_AVX_KERNELS
+
+TARGET_AVX2 static FORCE_INLINE uint32_t * StoreMatchesAVX2 ( int iMask, __m256i tRowIDs, uint32_t * pRowID )
+{
+	__m256i tPermute = _mm256_load_si256 ( (const __m256i*)g_dPermuteAVX2[iMask] );
+	_mm256_storeu_si256 ( (__m256i*)pRowID, _mm256_permutevar8x32_epi32 ( tRowIDs, tPermute ) );
+	return pRowID + _mm_popcnt_u32 ( (uint32_t)iMask );
+}
+
+
+TARGET_AVX2 static FORCE_INLINE __m256i FirstRowIDsAVX2 ( uint32_t tRowID )
+{
+	return _mm256_add_epi32 ( _mm256_set1_epi32 ( (int)tRowID ), _mm256_setr_epi32 ( 0, 1, 2, 3, 4, 5, 6, 7 ) );
+}
+
+
+TARGET_AVX2 static uint32_t * SingleValueAVX2 ( const uint32_t * pValues, int iNum, uint32_t uValue, bool bEq, uint32_t tRowID, uint32_t * pRowID )
+{
+	__m256i tValue = _mm256_set1_epi32 ( (int)uValue );
+	__m256i tRowIDs = FirstRowIDsAVX2(tRowID);
+	__m256i tStep = _mm256_set1_epi32(8);
+	int iInvert = bEq ? 0 : 0xFF;
+
+	int i = 0;
+	for ( ; i+8<=iNum; i+=8 )
+	{
+		__m256i tValues = _mm256_loadu_si256 ( (const __m256i*)( pValues+i ) );
+		int iMask = _mm256_movemask_ps ( _mm256_castsi256_ps ( _mm256_cmpeq_epi32 ( tValues, tValue ) ) ) ^ iInvert;
+		pRowID = StoreMatchesAVX2 ( iMask, tRowIDs, pRowID );
+		tRowIDs = _mm256_add_epi32 ( tRowIDs, tStep );
+	}
+
+	return ScalarSingleValue ( pValues, i, iNum, uValue, bEq, tRowID, pRowID );
+}
+
+
+TARGET_AVX2 static uint32_t * ValuesAVX2 ( const uint32_t * pValues, int iNum, const uint32_t * pFilterValues, int iNumFilterValues, uint32_t tRowID, uint32_t * pRowID )
+{
+	__m256i tRowIDs = FirstRowIDsAVX2(tRowID);
+	__m256i tStep = _mm256_set1_epi32(8);
+
+	int i = 0;
+	for ( ; i+8<=iNum; i+=8 )
+	{
+		__m256i tValues = _mm256_loadu_si256 ( (const __m256i*)( pValues+i ) );
+		__m256i tMatch = _mm256_setzero_si256();
+		for ( int j = 0; j < iNumFilterValues; j++ )
+			tMatch = _mm256_or_si256 ( tMatch, _mm256_cmpeq_epi32 ( tValues, _mm256_set1_epi32 ( (int)pFilterValues[j] ) ) );
+
+		pRowID = StoreMatchesAVX2 ( _mm256_movemask_ps ( _mm256_castsi256_ps(tMatch) ), tRowIDs, pRowID );
+		tRowIDs = _mm256_add_epi32 ( tRowIDs, tStep );
+	}
+
+	return ScalarValues ( pValues, i, iNum, pFilterValues, iNumFilterValues, tRowID, pRowID );
+}
+
+
+TARGET_AVX2 static uint32_t * RangeAVX2 ( const uint32_t * pValues, int iNum, uint32_t uMin, uint32_t uMax, uint32_t tRowID, uint32_t * pRowID )
+{
+	__m256i tMin = _mm256_set1_epi32 ( (int)uMin );
+	__m256i tMax = _mm256_set1_epi32 ( (int)uMax );
+	__m256i tRowIDs = FirstRowIDsAVX2(tRowID);
+	__m256i tStep = _mm256_set1_epi32(8);
+
+	int i = 0;
+	for ( ; i+8<=iNum; i+=8 )
+	{
+		__m256i tValues = _mm256_loadu_si256 ( (const __m256i*)( pValues+i ) );
+		__m256i tLeft = _mm256_cmpeq_epi32 ( _mm256_max_epu32 ( tValues, tMin ), tValues );
+		__m256i tRight = _mm256_cmpeq_epi32 ( _mm256_min_epu32 ( tValues, tMax ), tValues );
+		pRowID = StoreMatchesAVX2 ( _mm256_movemask_ps ( _mm256_castsi256_ps ( _mm256_and_si256 ( tLeft, tRight ) ) ), tRowIDs, pRowID );
+		tRowIDs = _mm256_add_epi32 ( tRowIDs, tStep );
+	}
+
+	return ScalarRange ( pValues, i, iNum, uMin, uMax, tRowID, pRowID );
+}
+
+
+TARGET_AVX2 static uint32_t * FloatRangeAVX2 ( const uint32_t * pValues, int iNum, const FloatRange_t & tRange, uint32_t tRowID, uint32_t * pRowID )
+{
+	__m256 tMin = _mm256_set1_ps ( tRange.m_fMin );
+	__m256 tMax = _mm256_set1_ps ( tRange.m_fMax );
+	__m256i tRowIDs = FirstRowIDsAVX2(tRowID);
+	__m256i tStep = _mm256_set1_epi32(8);
+
+	int i = 0;
+	for ( ; i+8<=iNum; i+=8 )
+	{
+		__m256 tValues = _mm256_castsi256_ps ( _mm256_loadu_si256 ( (const __m256i*)( pValues+i ) ) );
+		__m256 tLeft = tRange.m_bLeftClosed ? _mm256_cmp_ps ( tValues, tMin, _CMP_GE_OQ ) : _mm256_cmp_ps ( tValues, tMin, _CMP_GT_OQ );
+		__m256 tRight = tRange.m_bRightClosed ? _mm256_cmp_ps ( tValues, tMax, _CMP_LE_OQ ) : _mm256_cmp_ps ( tValues, tMax, _CMP_LT_OQ );
+		pRowID = StoreMatchesAVX2 ( _mm256_movemask_ps ( _mm256_and_ps ( tLeft, tRight ) ), tRowIDs, pRowID );
+		tRowIDs = _mm256_add_epi32 ( tRowIDs, tStep );
+	}
+
+	return ScalarFloatRange ( pValues, i, iNum, tRange, tRowID, pRowID );
+}
+
+//////////////////////////////////////////////////////////////////////////
+// avx-512: 16 values per step; row ids are written with compress-store
+
+TARGET_AVX512 static FORCE_INLINE uint32_t * StoreMatchesAVX512 ( __mmask16 uMask, __m512i tRowIDs, uint32_t * pRowID )
+{
+	_mm512_mask_compressstoreu_epi32 ( pRowID, uMask, tRowIDs );
+	return pRowID + _mm_popcnt_u32(uMask);
+}
+
+
+TARGET_AVX512 static FORCE_INLINE __m512i FirstRowIDsAVX512 ( uint32_t tRowID )
+{
+	return _mm512_add_epi32 ( _mm512_set1_epi32 ( (int)tRowID ), _mm512_setr_epi32 ( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 ) );
+}
+
+
+TARGET_AVX512 static uint32_t * SingleValueAVX512 ( const uint32_t * pValues, int iNum, uint32_t uValue, bool bEq, uint32_t tRowID, uint32_t * pRowID )
+{
+	__m512i tValue = _mm512_set1_epi32 ( (int)uValue );
+	__m512i tRowIDs = FirstRowIDsAVX512(tRowID);
+	__m512i tStep = _mm512_set1_epi32(16);
+
+	int i = 0;
+	for ( ; i+16<=iNum; i+=16 )
+	{
+		__m512i tValues = _mm512_loadu_si512 ( pValues+i );
+		__mmask16 uMask = bEq ? _mm512_cmpeq_epu32_mask ( tValues, tValue ) : _mm512_cmpneq_epu32_mask ( tValues, tValue );
+		pRowID = StoreMatchesAVX512 ( uMask, tRowIDs, pRowID );
+		tRowIDs = _mm512_add_epi32 ( tRowIDs, tStep );
+	}
+
+	return ScalarSingleValue ( pValues, i, iNum, uValue, bEq, tRowID, pRowID );
+}
+
+
+TARGET_AVX512 static uint32_t * ValuesAVX512 ( const uint32_t * pValues, int iNum, const uint32_t * pFilterValues, int iNumFilterValues, uint32_t tRowID, uint32_t * pRowID )
+{
+	__m512i tRowIDs = FirstRowIDsAVX512(tRowID);
+	__m512i tStep = _mm512_set1_epi32(16);
+
+	int i = 0;
+	for ( ; i+16<=iNum; i+=16 )
+	{
+		__m512i tValues = _mm512_loadu_si512 ( pValues+i );
+		__mmask16 uMask = 0;
+		for ( int j = 0; j < iNumFilterValues; j++ )
+			uMask |= _mm512_cmpeq_epu32_mask ( tValues, _mm512_set1_epi32 ( (int)pFilterValues[j] ) );
+
+		pRowID = StoreMatchesAVX512 ( uMask, tRowIDs, pRowID );
+		tRowIDs = _mm512_add_epi32 ( tRowIDs, tStep );
+	}
+
+	return ScalarValues ( pValues, i, iNum, pFilterValues, iNumFilterValues, tRowID, pRowID );
+}
+
+
+TARGET_AVX512 static uint32_t * RangeAVX512 ( const uint32_t * pValues, int iNum, uint32_t uMin, uint32_t uMax, uint32_t tRowID, uint32_t * pRowID )
+{
+	__m512i tMin = _mm512_set1_epi32 ( (int)uMin );
+	__m512i tMax = _mm512_set1_epi32 ( (int)uMax );
+	__m512i tRowIDs = FirstRowIDsAVX512(tRowID);
+	__m512i tStep = _mm512_set1_epi32(16);
+
+	int i = 0;
+	for ( ; i+16<=iNum; i+=16 )
+	{
+		__m512i tValues = _mm512_loadu_si512 ( pValues+i );
+		__mmask16 uMask = _mm512_mask_cmple_epu32_mask ( _mm512_cmpge_epu32_mask ( tValues, tMin ), tValues, tMax );
+		pRowID = StoreMatchesAVX512 ( uMask, tRowIDs, pRowID );
+		tRowIDs = _mm512_add_epi32 ( tRowIDs, tStep );
+	}
+
+	return ScalarRange ( pValues, i, iNum, uMin, uMax, tRowID, pRowID );
+}
+
+
+TARGET_AVX512 static uint32_t * FloatRangeAVX512 ( const uint32_t * pValues, int iNum, const FloatRange_t & tRange, uint32_t tRowID, uint32_t * pRowID )
+{
+	__m512 tMin = _mm512_set1_ps ( tRange.m_fMin );
+	__m512 tMax = _mm512_set1_ps ( tRange.m_fMax );
+	__m512i tRowIDs = FirstRowIDsAVX512(tRowID);
+	__m512i tStep = _mm512_set1_epi32(16);
+
+	int i = 0;
+	for ( ; i+16<=iNum; i+=16 )
+	{
+		__m512 tValues = _mm512_castsi512_ps ( _mm512_loadu_si512 ( pValues+i ) );
+		__mmask16 uLeft = tRange.m_bLeftClosed ? _mm512_cmp_ps_mask ( tValues, tMin, _CMP_GE_OQ ) : _mm512_cmp_ps_mask ( tValues, tMin, _CMP_GT_OQ );
+		__mmask16 uRight = tRange.m_bRightClosed ? _mm512_cmp_ps_mask ( tValues, tMax, _CMP_LE_OQ ) : _mm512_cmp_ps_mask ( tValues, tMax, _CMP_LT_OQ );
+		pRowID = StoreMatchesAVX512 ( uLeft & uRight, tRowIDs, pRowID );
+		tRowIDs = _mm512_add_epi32 ( tRowIDs, tStep );
+	}
+
+	return ScalarFloatRange ( pValues, i, iNum, tRange, tRowID, pRowID );
+}
+
+#endif // HAVE_AVX_KERNELS
+
+//////////////////////////////////////////////////////////////////////////
+// packed ordinals: value i of a 128-value pack is stored in lane i%4 at bit offset (i/4)*iBits of that lane's bit stream
+
+template <typename MATCH>
+static FORCE_INLINE uint32_t * FilterPackedOrdinals ( const uint32_t * pPacked, int iBits, int iNum, uint32_t tRowID, uint32_t * pRowID, MATCH && fnMatch )
+{
+	assert ( iBits>0 && iBits<32 );
+
+	const int VALUES_PER_PACK = 128;
+	__m128i tOrdinalMask = _mm_set1_epi32 ( ( 1<<iBits ) - 1 );
+	__m128i tRowIDs = _mm_add_epi32 ( _mm_set1_epi32 ( (int)tRowID ), _mm_setr_epi32 ( 0, 1, 2, 3 ) );
+	__m128i tStep = _mm_set1_epi32(4);
+
+	for ( int iPackStart = 0; iPackStart < iNum; iPackStart += VALUES_PER_PACK )
+	{
+		const __m128i * pPack = (const __m128i *)pPacked;
+		int iPackValues = std::min ( iNum-iPackStart, VALUES_PER_PACK );
+		int iOffset = 0;
+		for ( int i = 0; i < iPackValues; i += 4, iOffset += iBits )
+		{
+			int iWord = iOffset >> 5;
+			int iShift = iOffset & 31;
+			__m128i tOrdinals = _mm_srl_epi32 ( _mm_loadu_si128 ( pPack+iWord ), _mm_cvtsi32_si128(iShift) );
+			if ( iShift+iBits>32 )
+				tOrdinals = _mm_or_si128 ( tOrdinals, _mm_sll_epi32 ( _mm_loadu_si128 ( pPack+iWord+1 ), _mm_cvtsi32_si128 ( 32-iShift ) ) );
+
+			int iMask = fnMatch ( _mm_and_si128 ( tOrdinals, tOrdinalMask ) );
+			if ( i+4>iPackValues )
+				iMask &= ( 1 << ( iPackValues-i ) ) - 1;
+
+			pRowID = StoreMatchesSSE ( iMask, tRowIDs, pRowID );
+			tRowIDs = _mm_add_epi32 ( tRowIDs, tStep );
+		}
+
+		pPacked += iBits*4;
+	}
+
+	return pRowID;
+}
+
+
+uint32_t * FilterPackedOrdinals_Value ( const uint32_t * pPacked, int iBits, int iNum, uint32_t uOrdinal, bool bEq, uint32_t tRowID, uint32_t * pRowID )
+{
+	__m128i tOrdinal = _mm_set1_epi32 ( (int)uOrdinal );
+	int iInvert = bEq ? 0 : 0xF;
+	return FilterPackedOrdinals ( pPacked, iBits, iNum, tRowID, pRowID, [tOrdinal, iInvert]( __m128i tOrdinals ){ return _mm_movemask_ps ( _mm_castsi128_ps ( _mm_cmpeq_epi32 ( tOrdinals, tOrdinal ) ) ) ^ iInvert; } );
+}
+
+
+uint32_t * FilterPackedOrdinals_Range ( const uint32_t * pPacked, int iBits, int iNum, uint32_t uMinOrdinal, uint32_t uMaxOrdinal, uint32_t tRowID, uint32_t * pRowID )
+{
+	// ordinals are small, so signed compares are fine
+	__m128i tMin = _mm_set1_epi32 ( (int)uMinOrdinal-1 );
+	__m128i tMax = _mm_set1_epi32 ( (int)uMaxOrdinal+1 );
+	return FilterPackedOrdinals ( pPacked, iBits, iNum, tRowID, pRowID, [tMin, tMax]( __m128i tOrdinals ){ return _mm_movemask_ps ( _mm_castsi128_ps ( _mm_and_si128 ( _mm_cmpgt_epi32 ( tOrdinals, tMin ), _mm_cmplt_epi32 ( tOrdinals, tMax ) ) ) ); } );
+}
+
+
+uint32_t * FilterPackedOrdinals_Set ( const uint32_t * pPacked, int iBits, int iNum, const uint64_t * pOrdinalSet, uint32_t tRowID, uint32_t * pRowID )
+{
+	return FilterPackedOrdinals ( pPacked, iBits, iNum, tRowID, pRowID, [pOrdinalSet]( __m128i tOrdinals )
+		{
+			alignas(16) uint32_t dOrdinals[4];
+			_mm_store_si128 ( (__m128i*)dOrdinals, tOrdinals );
+
+			int iMask = 0;
+			for ( int i = 0; i < 4; i++ )
+				iMask |= int ( ( pOrdinalSet [ dOrdinals[i] >> 6 ] >> ( dOrdinals[i] & 63 ) ) & 1 ) << i;
+
+			return iMask;
+		} );
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+enum class SimdLevel_e
+{
+	SSE,
+	AVX2,
+	AVX512
+};
+
+static SimdLevel_e DetectSimdLevel()
+{
+#if !HAVE_AVX_KERNELS
+	return SimdLevel_e::SSE;
+#elif _MSC_VER
+	int dInfo[4];
+	__cpuid ( dInfo, 0 );
+	if ( dInfo[0]<7 )
+		return SimdLevel_e::SSE;
+
+	// the OS must save ymm/zmm registers on context switches
+	__cpuid ( dInfo, 1 );
+	const int OSXSAVE = 1<<27;
+	if ( !( dInfo[2] & OSXSAVE ) )
+		return SimdLevel_e::SSE;
+
+	uint64_t uXCR0 = _xgetbv(0);
+	__cpuidex ( dInfo, 7, 0 );
+	const int AVX2 = 1<<5;
+	const int AVX512F = 1<<16;
+	if ( ( dInfo[1] & AVX512F ) && ( uXCR0 & 0xE6 )==0xE6 )
+		return SimdLevel_e::AVX512;
+
+	if ( ( dInfo[1] & AVX2 ) && ( uXCR0 & 0x6 )==0x6 )
+		return SimdLevel_e::AVX2;
+
+	return SimdLevel_e::SSE;
+#else
+	__builtin_cpu_init();
+	if ( __builtin_cpu_supports("avx512f") )
+		return SimdLevel_e::AVX512;
+
+	if ( __builtin_cpu_supports("avx2") )
+		return SimdLevel_e::AVX2;
+
+	return SimdLevel_e::SSE;
+#endif
+}
+
+
+static FilterKernels_t SelectFilterKernels()
+{
+	assert ( g_bMaskTablesReady );
+
+	switch ( DetectSimdLevel() )
+	{
+#if HAVE_AVX_KERNELS
+	case SimdLevel_e::AVX512:	return { SingleValueAVX512, ValuesAVX512, RangeAVX512, FloatRangeAVX512, "avx512" };
+	case SimdLevel_e::AVX2:		return { SingleValueAVX2, ValuesAVX2, RangeAVX2, FloatRangeAVX2, "avx2" };
+#endif
+	default:					return { SingleValueSSE, ValuesSSE, RangeSSE, FloatRangeSSE, "sse4.1" };
+	}
+}
+
+
+const FilterKernels_t & GetFilterKernels()
+{
+	static FilterKernels_t tKernels = SelectFilterKernels();
+	return tKernels;
+}
+
+} // namespace columnar
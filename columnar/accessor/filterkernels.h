@@ -0,0 +1,52 @@
+// Copyright (c) 2020-2022, Manticore Software LTD (https://manticoresearch.com)
+// All rights reserved
+//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "util/util.h"
+
+namespace columnar
+{
+
+struct FloatRange_t
+{
+	float	m_fMin;
+	float	m_fMax;
+	bool	m_bLeftClosed;
+	bool	m_bRightClosed;
+};
+
+// filter kernels for 32-bit values. each kernel checks iNum values, writes row ids (tRowID + value index) of matching values to pRowID and returns the new end
+// full vectors are stored to the output, so it must have room for iNum row ids
+struct FilterKernels_t
+{
+	uint32_t *	(*m_fnSingleValue) ( const uint32_t * pValues, int iNum, uint32_t uValue, bool bEq, uint32_t tRowID, uint32_t * pRowID );
+	uint32_t *	(*m_fnValues) ( const uint32_t * pValues, int iNum, const uint32_t * pFilterValues, int iNumFilterValues, uint32_t tRowID, uint32_t * pRowID );
+	uint32_t *	(*m_fnRange) ( const uint32_t * pValues, int iNum, uint32_t uMin, uint32_t uMax, uint32_t tRowID, uint32_t * pRowID );	// closed range
+	uint32_t *	(*m_fnFloatRange) ( const uint32_t * pValues, int iNum, const FloatRange_t & tRange, uint32_t tRowID, uint32_t * pRowID );	// values are floats stored as uint32
+	const char *	m_szName;
+};
+
+// kernels for the best instruction set supported by the CPU (AVX-512, AVX2 or the SSE4.1 baseline); selected once
+const FilterKernels_t & GetFilterKernels();
+
+// filters on table ordinals packed with util::BitPack (packs of 128 values, each in 4 interleaved 32-bit lanes of iBits words)
+// ordinals are checked in registers and never unpacked to memory; output rules are the same as above
+uint32_t *	FilterPackedOrdinals_Value ( const uint32_t * pPacked, int iBits, int iNum, uint32_t uOrdinal, bool bEq, uint32_t tRowID, uint32_t * pRowID );
+uint32_t *	FilterPackedOrdinals_Range ( const uint32_t * pPacked, int iBits, int iNum, uint32_t uMinOrdinal, uint32_t uMaxOrdinal, uint32_t tRowID, uint32_t * pRowID );
+uint32_t *	FilterPackedOrdinals_Set ( const uint32_t * pPacked, int iBits, int iNum, const uint64_t * pOrdinalSet, uint32_t tRowID, uint32_t * pRowID );	// 256-bit set
+
+} // namespace columnar
@@ -0,0 +1,202 @@
+// Copyright (c) 2020-2022, Manticore Software LTD (https://manticoresearch.com)
+// All rights reserved
+//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "columnar.h"
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+
+#if defined(USE_SIMDE)
+	#define SIMDE_ENABLE_NATIVE_ALIASES 1
+	#include <simde/x86/sse4.1.h>
+#elif _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+namespace columnar
+{
+
+// a filter converted to a range check on minmax tree leaves
+template <typename T>
+struct LeafRange_T
+{
+	T		m_tMin;
+	T		m_tMax;
+	bool	m_bLeftStrict = false;	// only used by floats; integer ranges are always closed
+	bool	m_bRightStrict = false;
+	bool	m_bExclude = false;		// leaf fails if it is completely inside the range
+	bool	m_bEmpty = false;		// no value of type T fits the range
+	bool	m_bExact = false;		// the range is the filter itself (not just the bounds of its values), so leaves can be checked for full matches
+};
+
+template <typename T>
+FORCE_INLINE bool LeafMatches ( T tMin, T tMax, const LeafRange_T<T> & tRange )
+{
+	if ( tRange.m_bExclude )
+	{
+		bool bLeft = tRange.m_bLeftStrict ? tMin>tRange.m_tMin : tMin>=tRange.m_tMin;
+		bool bRight = tRange.m_bRightStrict ? tMax<tRange.m_tMax : tMax<=tRange.m_tMax;
+		return !( bLeft && bRight );
+	}
+
+	bool bLeft = tRange.m_bLeftStrict ? tMax>tRange.m_tMin : tMax>=tRange.m_tMin;
+	bool bRight = tRange.m_bRightStrict ? tMin<tRange.m_tMax : tMin<=tRange.m_tMax;
+	return bLeft && bRight;
+}
+
+// returns a mask of 4 leaves that pass
+template <typename T>
+FORCE_INLINE uint32_t LeafMatches4 ( const T * pMins, const T * pMaxs, const LeafRange_T<T> & tRange )
+{
+	uint32_t uMask = 0;
+	for ( int i = 0; i < 4; i++ )
+		uMask |= uint32_t ( LeafMatches ( pMins[i], pMaxs[i], tRange ) ) << i;
+
+	return uMask;
+}
+
+template <>
+FORCE_INLINE uint32_t LeafMatches4 ( const uint32_t * pMins, const uint32_t * pMaxs, const LeafRange_T<uint32_t> & tRange )
+{
+	__m128i tMins = _mm_loadu_si128 ( (const __m128i*)pMins );
+	__m128i tMaxs = _mm_loadu_si128 ( (const __m128i*)pMaxs );
+	__m128i tLo = _mm_set1_epi32 ( (int)tRange.m_tMin );
+	__m128i tHi = _mm_set1_epi32 ( (int)tRange.m_tMax );
+
+	// no unsigned compares in sse4.1; a>=b is the same as max(a,b)==a
+	__m128i tLeft, tRight;
+	if ( tRange.m_bExclude )
+	{
+		tLeft = _mm_cmpeq_epi32 ( _mm_max_epu32 ( tMins, tLo ), tMins );
+		tRight = _mm_cmpeq_epi32 ( _mm_min_epu32 ( tMaxs, tHi ), tMaxs );
+		return ~_mm_movemask_ps ( _mm_castsi128_ps ( _mm_and_si128 ( tLeft, tRight ) ) ) & 0xF;
+	}
+
+	tLeft = _mm_cmpeq_epi32 ( _mm_max_epu32 ( tMaxs, tLo ), tMaxs );
+	tRight = _mm_cmpeq_epi32 ( _mm_min_epu32 ( tMins, tHi ), tMins );
+	return _mm_movemask_ps ( _mm_castsi128_ps ( _mm_and_si128 ( tLeft, tRight ) ) );
+}
+
+template <>
+FORCE_INLINE uint32_t LeafMatches4 ( const float * pMins, const float * pMaxs, const LeafRange_T<float> & tRange )
+{
+	__m128 tMins = _mm_loadu_ps(pMins);
+	__m128 tMaxs = _mm_loadu_ps(pMaxs);
+	__m128 tLo = _mm_set1_ps ( tRange.m_tMin );
+	__m128 tHi = _mm_set1_ps ( tRange.m_tMax );
+
+	if ( tRange.m_bExclude )
+	{
+		__m128 tLeft = tRange.m_bLeftStrict ? _mm_cmpgt_ps ( tMins, tLo ) : _mm_cmpge_ps ( tMins, tLo );
+		__m128 tRight = tRange.m_bRightStrict ? _mm_cmplt_ps ( tMaxs, tHi ) : _mm_cmple_ps ( tMaxs, tHi );
+		return ~_mm_movemask_ps ( _mm_and_ps ( tLeft, tRight ) ) & 0xF;
+	}
+
+	__m128 tLeft = tRange.m_bLeftStrict ? _mm_cmpgt_ps ( tMaxs, tLo ) : _mm_cmpge_ps ( tMaxs, tLo );
+	__m128 tRight = tRange.m_bRightStrict ? _mm_cmplt_ps ( tMins, tHi ) : _mm_cmple_ps ( tMins, tHi );
+	return _mm_movemask_ps ( _mm_and_ps ( tLeft, tRight ) );
+}
+
+// ANDs the bitmap of matching leaves (one bit per leaf) with the result of the range check
+template <typename T>
+void AndMatchingLeaves ( const util::Span_T<T> & dMins, const util::Span_T<T> & dMaxs, const LeafRange_T<T> & tRange, util::Span_T<uint64_t> & dLeaves )
+{
+	assert ( dMins.size()==dMaxs.size() );
+	assert ( dLeaves.size()*64>=dMins.size() );
+
+	if ( tRange.m_bEmpty )
+	{
+		if ( !tRange.m_bExclude )
+			memset ( dLeaves.data(), 0, dLeaves.size()*sizeof(dLeaves[0]) );
+
+		return;
+	}
+
+	const T * pMins = dMins.data();
+	const T * pMaxs = dMaxs.data();
+	size_t tNumLeaves = dMins.size();
+	size_t tLeaf = 0;
+	for ( auto & uWord : dLeaves )
+	{
+		if ( !uWord )
+		{
+			tLeaf += 64;
+			continue;
+		}
+
+		uint64_t uMask = 0;
+		size_t tWordEnd = std::min ( tLeaf+64, tNumLeaves );
+		int iBit = 0;
+		for ( ; tLeaf+4<=tWordEnd; tLeaf+=4, iBit+=4 )
+			uMask |= uint64_t ( LeafMatches4 ( pMins+tLeaf, pMaxs+tLeaf, tRange ) ) << iBit;
+
+		for ( ; tLeaf<tWordEnd; tLeaf++, iBit++ )
+			uMask |= uint64_t ( LeafMatches ( pMins[tLeaf], pMaxs[tLeaf], tRange ) ) << iBit;
+
+		uWord &= uMask;
+	}
+}
+
+// ANDs the bitmap of leaves with the leaves where every value matches the range
+template <typename T>
+void AndCoveredLeaves ( const util::Span_T<T> & dMins, const util::Span_T<T> & dMaxs, const LeafRange_T<T> & tRange, util::Span_T<uint64_t> & dLeaves )
+{
+	assert ( dMins.size()==dMaxs.size() );
+	assert ( dLeaves.size()*64>=dMins.size() );
+
+	if ( !tRange.m_bExact || ( tRange.m_bEmpty && !tRange.m_bExclude ) )
+	{
+		memset ( dLeaves.data(), 0, dLeaves.size()*sizeof(dLeaves[0]) );
+		return;
+	}
+
+	if ( tRange.m_bEmpty )
+		return;
+
+	// a leaf is covered by the range if it doesn't match the inverted range
+	LeafRange_T<T> tInverted = tRange;
+	tInverted.m_bExclude = !tRange.m_bExclude;
+
+	const T * pMins = dMins.data();
+	const T * pMaxs = dMaxs.data();
+	size_t tNumLeaves = dMins.size();
+	size_t tLeaf = 0;
+	for ( auto & uWord : dLeaves )
+	{
+		if ( !uWord )
+		{
+			tLeaf += 64;
+			continue;
+		}
+
+		uint64_t uMask = 0;
+		size_t tWordEnd = std::min ( tLeaf+64, tNumLeaves );
+		int iBit = 0;
+		for ( ; tLeaf+4<=tWordEnd; tLeaf+=4, iBit+=4 )
+			uMask |= uint64_t ( ~LeafMatches4 ( pMins+tLeaf, pMaxs+tLeaf, tInverted ) & 0xF ) << iBit;
+
+		for ( ; tLeaf<tWordEnd; tLeaf++, iBit++ )
+			uMask |= uint64_t ( !LeafMatches ( pMins[tLeaf], pMaxs[tLeaf], tInverted ) ) << iBit;
+
+		uWord &= uMask;
+	}
+}
+
+} // namespace columnar
@@ -0,0 +1,247 @@
+// Copyright (c) 2020-2022, Manticore Software LTD (https://manticoresearch.com)
+// All rights reserved
+//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "subblockcache.h"
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace columnar
+{
+
+struct SubblockCacheKeyHash_t
+{
+	size_t operator() ( const SubblockCacheKey_t & tKey ) const
+	{
+		uint64_t uHash = tKey.m_uAttrUID*0x9E3779B97F4A7C15ULL;
+		uHash ^= ( uint64_t(tKey.m_uBlockId)<<32 | tKey.m_uSubblockId ) + 0x9E3779B97F4A7C15ULL + (uHash<<6) + (uHash>>2);
+		uHash ^= tKey.m_uValueSize;
+		return (size_t)uHash;
+	}
+};
+
+// one part of the cache with its own lock; entries are evicted with CLOCK
+class SubblockCacheShard_c
+{
+public:
+	CachedSubblockPtr_t	Find ( const SubblockCacheKey_t & tKey );
+	void				Add ( const SubblockCacheKey_t & tKey, CachedSubblockPtr_t pSubblock, uint64_t uLimit, uint64_t & uEvicted );
+	uint64_t			Shrink ( uint64_t uLimit );
+	void				AddStats ( SubblockCacheStats_t & tStats ) const;
+
+private:
+	struct Entry_t
+	{
+		SubblockCacheKey_t	m_tKey;
+		CachedSubblockPtr_t	m_pSubblock;
+		bool				m_bReferenced = false;
+	};
+
+	mutable std::mutex	m_tLock;
+	std::unordered_map<SubblockCacheKey_t, int, SubblockCacheKeyHash_t> m_hEntries;
+	std::vector<Entry_t> m_dEntries;	// clock ring; free slots have no subblock
+	std::vector<int>	m_dFreeSlots;
+	size_t				m_tHand = 0;
+	uint64_t			m_uMemUsed = 0;
+
+	static uint64_t		GetEntrySize ( const CachedSubblock_t & tSubblock ) { return tSubblock.m_dData.size() + sizeof(CachedSubblock_t) + sizeof(Entry_t); }
+	uint64_t			EvictUntil ( uint64_t uLimit );
+};
+
+
+CachedSubblockPtr_t SubblockCacheShard_c::Find ( const SubblockCacheKey_t & tKey )
+{
+	std::unique_lock<std::mutex> tLock(m_tLock);
+	auto tFound = m_hEntries.find(tKey);
+	if ( tFound==m_hEntries.end() )
+		return nullptr;
+
+	Entry_t & tEntry = m_dEntries[tFound->second];
+	tEntry.m_bReferenced = true;
+	return tEntry.m_pSubblock;
+}
+
+
+void SubblockCacheShard_c::Add ( const SubblockCacheKey_t & tKey, CachedSubblockPtr_t pSubblock, uint64_t uLimit, uint64_t & uEvicted )
+{
+	uint64_t uSize = GetEntrySize(*pSubblock);
+	if ( uSize>uLimit )
+		return;
+
+	std::unique_lock<std::mutex> tLock(m_tLock);
+	if ( m_hEntries.find(tKey)!=m_hEntries.end() )	// another thread decoded the same subblock
+		return;
+
+	uEvicted += EvictUntil ( uLimit-uSize );
+
+	int iSlot = (int)m_dEntries.size();
+	if ( m_dFreeSlots.empty() )
+		m_dEntries.push_back({});
+	else
+	{
+		iSlot = m_dFreeSlots.back();
+		m_dFreeSlots.pop_back();
+	}
+
+	Entry_t & tEntry = m_dEntries[iSlot];
+	tEntry.m_tKey = tKey;
+	tEntry.m_pSubblock = std::move(pSubblock);
+	tEntry.m_bReferenced = false;
+
+	m_hEntries.insert ( { tKey, iSlot } );
+	m_uMemUsed += uSize;
+}
+
+
+uint64_t SubblockCacheShard_c::Shrink ( uint64_t uLimit )
+{
+	std::unique_lock<std::mutex> tLock(m_tLock);
+	return EvictUntil(uLimit);
+}
+
+
+uint64_t SubblockCacheShard_c::EvictUntil ( uint64_t uLimit )
+{
+	uint64_t uEvicted = 0;
+	while ( m_uMemUsed>uLimit && !m_hEntries.empty() )
+	{
+		if ( m_tHand>=m_dEntries.size() )
+			m_tHand = 0;
+
+		Entry_t & tEntry = m_dEntries[m_tHand++];
+		if ( !tEntry.m_pSubblock )
+			continue;
+
+		// recently used entries get a second chance
+		if ( tEntry.m_bReferenced )
+		{
+			tEntry.m_bReferenced = false;
+			continue;
+		}
+
+		// iterators that still hold the subblock keep it alive; we only drop our reference
+		m_uMemUsed -= GetEntrySize ( *tEntry.m_pSubblock );
+		m_hEntries.erase ( tEntry.m_tKey );
+		tEntry.m_pSubblock.reset();
+		m_dFreeSlots.push_back ( int ( &tEntry-m_dEntries.data() ) );
+		uEvicted++;
+	}
+
+	return uEvicted;
+}
+
+
+void SubblockCacheShard_c::AddStats ( SubblockCacheStats_t & tStats ) const
+{
+	std::unique_lock<std::mutex> tLock(m_tLock);
+	tStats.m_uMemUsed += m_uMemUsed;
+	tStats.m_uEntries += m_hEntries.size();
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+class SubblockCache_c : public SubblockCache_i
+{
+public:
+	CachedSubblockPtr_t	Find ( const SubblockCacheKey_t & tKey ) override;
+	void				Add ( const SubblockCacheKey_t & tKey, CachedSubblockPtr_t pSubblock ) override;
+	void				SetLimit ( uint64_t uMaxBytes ) override;
+	void				GetStats ( SubblockCacheStats_t & tStats ) const override;
+
+private:
+	static const int	NUM_SHARDS = 16;
+
+	SubblockCacheShard_c	m_dShards[NUM_SHARDS];
+	std::atomic<uint64_t>	m_uShardLimit{0};
+	std::atomic<uint64_t>	m_uHits{0};
+	std::atomic<uint64_t>	m_uMisses{0};
+	std::atomic<uint64_t>	m_uEvictions{0};
+
+	FORCE_INLINE SubblockCacheShard_c & GetShard ( const SubblockCacheKey_t & tKey ) { return m_dShards [ SubblockCacheKeyHash_t()(tKey) % NUM_SHARDS ]; }
+};
+
+
+CachedSubblockPtr_t SubblockCache_c::Find ( const SubblockCacheKey_t & tKey )
+{
+	CachedSubblockPtr_t pSubblock = GetShard(tKey).Find(tKey);
+	if ( pSubblock )
+		m_uHits.fetch_add ( 1, std::memory_order_relaxed );
+	else
+		m_uMisses.fetch_add ( 1, std::memory_order_relaxed );
+
+	return pSubblock;
+}
+
+
+void SubblockCache_c::Add ( const SubblockCacheKey_t & tKey, CachedSubblockPtr_t pSubblock )
+{
+	uint64_t uEvicted = 0;
+	GetShard(tKey).Add ( tKey, std::move(pSubblock), m_uShardLimit.load(std::memory_order_relaxed), uEvicted );
+	if ( uEvicted )
+		m_uEvictions.fetch_add ( uEvicted, std::memory_order_relaxed );
+}
+
+
+void SubblockCache_c::SetLimit ( uint64_t uMaxBytes )
+{
+	uint64_t uShardLimit = uMaxBytes/NUM_SHARDS;
+	m_uShardLimit.store ( uShardLimit, std::memory_order_relaxed );
+
+	uint64_t uEvicted = 0;
+	for ( auto & tShard : m_dShards )
+		uEvicted += tShard.Shrink(uShardLimit);
+
+	m_uEvictions.fetch_add ( uEvicted, std::memory_order_relaxed );
+}
+
+
+void SubblockCache_c::GetStats ( SubblockCacheStats_t & tStats ) const
+{
+	tStats = SubblockCacheStats_t();
+	tStats.m_uMemLimit	= m_uShardLimit.load(std::memory_order_relaxed)*NUM_SHARDS;
+	tStats.m_uHits		= m_uHits.load(std::memory_order_relaxed);
+	tStats.m_uMisses	= m_uMisses.load(std::memory_order_relaxed);
+	tStats.m_uEvictions	= m_uEvictions.load(std::memory_order_relaxed);
+
+	for ( const auto & tShard : m_dShards )
+		tShard.AddStats(tStats);
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+static SubblockCache_c g_tSubblockCache;
+static std::atomic<bool> g_bSubblockCacheEnabled{false};
+
+SubblockCache_i * GetSubblockCache()
+{
+	return g_bSubblockCacheEnabled.load(std::memory_order_relaxed) ? &g_tSubblockCache : nullptr;
+}
+
+
+void SetSubblockCacheLimit ( uint64_t uMaxBytes )
+{
+	g_bSubblockCacheEnabled.store ( uMaxBytes>0, std::memory_order_relaxed );
+	g_tSubblockCache.SetLimit(uMaxBytes);
+}
+
+
+void GetSubblockCacheStats ( SubblockCacheStats_t & tStats )
+{
+	g_tSubblockCache.GetStats(tStats);
+}
+
+} // namespace columnar
@@ -0,0 +1,81 @@
+// Copyright (c) 2020-2022, Manticore Software LTD (https://manticoresearch.com)
+// All rights reserved
+//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "columnar.h"
+#include <memory>
+
+namespace columnar
+{
+
+struct SubblockCacheKey_t
+{
+	uint64_t	m_uAttrUID = 0;		// AttributeHeader_i::GetUID(); never reused, so subblocks of closed storages can't be hit
+	uint32_t	m_uBlockId = 0;
+	uint32_t	m_uSubblockId = 0;
+	uint32_t	m_uValueSize = 0;
+
+	bool operator == ( const SubblockCacheKey_t & tRhs ) const
+	{
+		return m_uAttrUID==tRhs.m_uAttrUID && m_uBlockId==tRhs.m_uBlockId && m_uSubblockId==tRhs.m_uSubblockId && m_uValueSize==tRhs.m_uValueSize;
+	}
+};
+
+// decoded subblock data; immutable once it is in the cache
+struct CachedSubblock_t
+{
+	std::vector<uint8_t>	m_dData;
+	uint32_t				m_uFlags = 0;	// decoder-specific
+};
+
+using CachedSubblockPtr_t = std::shared_ptr<const CachedSubblock_t>;
+
+// process-wide cache of decoded subblocks shared by all iterators and analyzers
+class SubblockCache_i
+{
+public:
+	virtual						~SubblockCache_i() = default;
+
+	virtual CachedSubblockPtr_t	Find ( const SubblockCacheKey_t & tKey ) = 0;
+	virtual void				Add ( const SubblockCacheKey_t & tKey, CachedSubblockPtr_t pSubblock ) = 0;
+	virtual void				SetLimit ( uint64_t uMaxBytes ) = 0;
+	virtual void				GetStats ( SubblockCacheStats_t & tStats ) const = 0;
+};
+
+// null if the cache is disabled (that's the default)
+SubblockCache_i *	GetSubblockCache();
+void				SetSubblockCacheLimit ( uint64_t uMaxBytes );
+void				GetSubblockCacheStats ( SubblockCacheStats_t & tStats );
+
+template <typename T>
+CachedSubblockPtr_t CreateCachedSubblock ( const util::Span_T<T> & dValues, uint32_t uFlags = 0 )
+{
+	auto pSubblock = std::make_shared<CachedSubblock_t>();
+	pSubblock->m_dData.resize ( dValues.size()*sizeof(T) );
+	memcpy ( pSubblock->m_dData.data(), dValues.data(), pSubblock->m_dData.size() );
+	pSubblock->m_uFlags = uFlags;
+	return pSubblock;
+}
+
+template <typename T>
+FORCE_INLINE util::Span_T<T> GetCachedValues ( const CachedSubblock_t & tSubblock, size_t tOffset = 0 )
+{
+	assert ( tOffset<=tSubblock.m_dData.size() );
+	return util::Span_T<T> ( (T*)( tSubblock.m_dData.data()+tOffset ), ( tSubblock.m_dData.size()-tOffset ) / sizeof(T) );
+}
+
+} // namespace columnar
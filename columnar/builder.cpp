@@ -20,9 +20,11 @@
 #include "builderbool.h"
 #include "builderint.h"
 #include "buildermva.h"
+#include "threadpool.h"
 
 #include <memory>
 #include <algorithm>
+#include <future>
 
 namespace columnar
 {
@@ -38,38 +40,69 @@ public:
 	void	SetAttr ( int iAttr, int64_t tAttr ) final;
 	void	SetAttr ( int iAttr, const uint8_t * pData, int iLength ) final;
 	void	SetAttr ( int iAttr, const int64_t * pData, int iLength ) final;
+	void	SetAttrBatch ( int iAttr, const Span_T<int64_t> & dValues ) final;
+	void	SetAttrBatch ( int iAttr, const Span_T<int64_t> & dOffsets, const uint8_t * pData ) final;
+	void	SetAttrBatch ( int iAttr, const Span_T<int64_t> & dOffsets, const int64_t * pData ) final;
 	bool	Done ( std::string & sError ) final;
+	void	GetPackingStats ( std::vector<PackingStats_t> & dStats ) const final;
 
 private:
-	std::string	m_sFile;
+	// values of one attribute collected for one block; packers get them as a single batch
+	struct CollectedBlock_t
+	{
+		std::vector<int64_t>	m_dValues;		// ints or MVA values
+		std::vector<uint8_t>	m_dData;		// string bodies
+		std::vector<int64_t>	m_dOffsets{0};	// string/MVA offsets
+		int						m_iDocs = 0;
+
+		void	Reset();
+	};
+
+	BlockWriter_c	m_tWriter;
 	std::vector<std::vector<std::shared_ptr<Packer_i>>> m_dPackers;
 	std::vector<std::shared_ptr<Packer_i>> m_dFlatPackers;
-
+	std::vector<AttrType_e> m_dAttrTypes;
+
+	// double-buffered blocks: rows are added to one while the other one is packed on the pool
+	std::vector<CollectedBlock_t> m_dCollecting;
+	std::vector<CollectedBlock_t> m_dPacking;
+	std::vector<std::future<void>> m_dPackingDone;
+
+	// declared last so that it is destroyed (and its queued jobs are finished) before the buffers
+	std::unique_ptr<ThreadPool_i> m_pPool;
+
+	inline CollectedBlock_t & GetCollecting ( int iAttr );
+	template <typename ADD>
+	void	AddBatch ( int iAttr, int iNumDocs, ADD && fnAddChunk );
+	void	PackCollected ( int iAttr, bool bLastBlock );
+	void	WaitPacking ( int iAttr );
+	void	AddCollected ( int iAttr, CollectedBlock_t & tBlock );
+	void	FinalizePackers();
 	bool	WriteHeaders ( FileWriter_c & tWriter, std::string & sError );
-	bool	WriteBodies ( std::string & sError );
-	void	Cleanup();
 };
 
 
 bool Builder_c::Setup ( const Settings_t & tSettings, const Schema_t & tSchema, const std::string & sFile, std::string & sError )
 {
-	m_sFile = sFile;
+	if ( !m_tWriter.Open ( sFile, sError ) )
+		return false;
 
-	int iPackers = 0;
+	m_tWriter.GetWriter().Write_uint32 ( STORAGE_VERSION );
 
 	for ( const auto & i : tSchema )
 	{
 		std::vector<std::shared_ptr<Packer_i>> dPackers;
+		m_dAttrTypes.push_back ( i.m_eType );
 
 		switch ( i.m_eType )
 		{
 		case AttrType_e::UINT32:
 		case AttrType_e::TIMESTAMP:
-			dPackers.push_back ( std::shared_ptr<Packer_i> ( CreatePackerUint32 ( tSettings, i.m_sName ) ) );
+			dPackers.push_back ( std::shared_ptr<Packer_i> ( CreatePackerUint32 ( tSettings, i.m_sName, i.m_bBloomFilter ) ) );
 			break;
 
 		case AttrType_e::INT64:
-			dPackers.push_back ( std::shared_ptr<Packer_i> ( CreatePackerInt64 ( tSettings, i.m_sName ) ) );
+			dPackers.push_back ( std::shared_ptr<Packer_i> ( CreatePackerInt64 ( tSettings, i.m_sName, i.m_bBloomFilter ) ) );
 			break;
 
 		case AttrType_e::BOOLEAN:
@@ -77,12 +110,12 @@ bool Builder_c::Setup ( const Settings_t & tSettings, const Schema_t & tSchema,
 			break;
 
 		case AttrType_e::FLOAT:
-			dPackers.push_back ( std::shared_ptr<Packer_i> ( CreatePackerFloat ( tSettings, i.m_sName ) ) );
+			dPackers.push_back ( std::shared_ptr<Packer_i> ( CreatePackerFloat ( tSettings, i.m_sName, i.m_bBloomFilter ) ) );
 			break;
 
 		case AttrType_e::STRING:
 			if ( i.m_fnCalcHash )
-				dPackers.push_back ( std::shared_ptr<Packer_i> ( CreatePackerHash ( tSettings, GenerateHashAttrName ( i.m_sName ), i.m_fnCalcHash ) ) );
+				dPackers.push_back ( std::shared_ptr<Packer_i> ( CreatePackerHash ( tSettings, GenerateHashAttrName ( i.m_sName ), i.m_fnCalcHash, i.m_bBloomFilter ) ) );
 
 			dPackers.push_back ( std::shared_ptr<Packer_i> ( CreatePackerStr ( tSettings, i.m_sName ) ) );
 			break;
@@ -102,11 +135,7 @@ bool Builder_c::Setup ( const Settings_t & tSettings, const Schema_t & tSchema,
 		if ( !dPackers.empty() )
 		{
 			for ( auto & i : dPackers )
-			{
-				std::string sFilename = FormatStr ( "%s.%d", sFile.c_str(), iPackers++ );
-				if ( !i->Setup ( sFilename, sError ) )
-					return false;
-			}
+				i->Setup(m_tWriter);
 
 			m_dPackers.push_back ( std::move(dPackers) );
 		}
@@ -121,12 +150,110 @@ bool Builder_c::Setup ( const Settings_t & tSettings, const Schema_t & tSchema,
 		for ( auto & j : i )
 			m_dFlatPackers.push_back(j);
 
+	if ( tSettings.m_iBuildThreads>1 )
+	{
+		m_pPool = std::unique_ptr<ThreadPool_i> ( CreateThreadPool ( tSettings.m_iBuildThreads ) );
+		m_dCollecting.resize ( m_dPackers.size() );
+		m_dPacking.resize ( m_dPackers.size() );
+		m_dPackingDone.resize ( m_dPackers.size() );
+	}
+
 	return true;
 }
 
 
+void Builder_c::CollectedBlock_t::Reset()
+{
+	m_dValues.resize(0);
+	m_dData.resize(0);
+	m_dOffsets.resize(1);
+	m_iDocs = 0;
+}
+
+// appends a chunk of string/MVA docs given as [iCount+1] offsets into pData
+template <typename T>
+static void AppendChunk ( std::vector<T> & dData, std::vector<int64_t> & dOffsets, const int64_t * pOffsets, const T * pData, int iCount )
+{
+	int64_t iShift = (int64_t)dData.size() - pOffsets[0];
+	dData.insert ( dData.end(), pData+pOffsets[0], pData+pOffsets[iCount] );
+	for ( int i = 1; i <= iCount; i++ )
+		dOffsets.push_back ( pOffsets[i]+iShift );
+}
+
+
+Builder_c::CollectedBlock_t & Builder_c::GetCollecting ( int iAttr )
+{
+	if ( m_dCollecting[iAttr].m_iDocs==DOCS_PER_BLOCK )
+		PackCollected ( iAttr, false );
+
+	return m_dCollecting[iAttr];
+}
+
+// hands the collected block over to the pool; rows keep coming into the other buffer while it is packed
+void Builder_c::PackCollected ( int iAttr, bool bLastBlock )
+{
+	WaitPacking(iAttr);
+
+	std::swap ( m_dCollecting[iAttr], m_dPacking[iAttr] );
+	m_dCollecting[iAttr].Reset();
+
+	auto pTask = std::make_shared<std::packaged_task<void()>> ( [this, iAttr, bLastBlock]
+		{
+			AddCollected ( iAttr, m_dPacking[iAttr] );
+			for ( auto & i : m_dPackers[iAttr] )
+				if ( bLastBlock )
+					i->Done();
+				else
+					i->Flush();
+		} );
+
+	m_dPackingDone[iAttr] = pTask->get_future();
+	m_pPool->Enqueue ( [pTask]{ (*pTask)(); } );
+}
+
+
+void Builder_c::WaitPacking ( int iAttr )
+{
+	auto & tDone = m_dPackingDone[iAttr];
+	if ( tDone.valid() )
+		tDone.get();
+}
+
+
+void Builder_c::AddCollected ( int iAttr, CollectedBlock_t & tBlock )
+{
+	if ( !tBlock.m_iDocs )
+		return;
+
+	for ( auto & i : m_dPackers[iAttr] )
+		switch ( m_dAttrTypes[iAttr] )
+		{
+		case AttrType_e::STRING:
+			i->AddDocs ( Span_T<int64_t>(tBlock.m_dOffsets), tBlock.m_dData.data() );
+			break;
+
+		case AttrType_e::UINT32SET:
+		case AttrType_e::INT64SET:
+			i->AddDocs ( Span_T<int64_t>(tBlock.m_dOffsets), tBlock.m_dValues.data() );
+			break;
+
+		default:
+			i->AddDocs ( Span_T<int64_t>(tBlock.m_dValues) );
+			break;
+		}
+}
+
+
 void Builder_c::SetAttr ( int iAttr, int64_t tAttr )
 {
+	if ( m_pPool )
+	{
+		CollectedBlock_t & tBlock = GetCollecting(iAttr);
+		tBlock.m_dValues.push_back(tAttr);
+		tBlock.m_iDocs++;
+		return;
+	}
+
 	for ( auto & i : m_dPackers[iAttr] )
 		i->AddDoc(tAttr);
 }
@@ -134,6 +261,15 @@ void Builder_c::SetAttr ( int iAttr, int64_t tAttr )
 
 void Builder_c::SetAttr ( int iAttr, const uint8_t * pData, int iLength )
 {
+	if ( m_pPool )
+	{
+		CollectedBlock_t & tBlock = GetCollecting(iAttr);
+		tBlock.m_dData.insert ( tBlock.m_dData.end(), pData, pData+iLength );
+		tBlock.m_dOffsets.push_back ( (int64_t)tBlock.m_dData.size() );
+		tBlock.m_iDocs++;
+		return;
+	}
+
 	for ( auto & i : m_dPackers[iAttr] )
 		i->AddDoc ( pData, iLength );
 }
@@ -141,72 +277,162 @@ void Builder_c::SetAttr ( int iAttr, const uint8_t * pData, int iLength )
 
 void Builder_c::SetAttr ( int iAttr, const int64_t * pData, int iLength )
 {
+	if ( m_pPool )
+	{
+		CollectedBlock_t & tBlock = GetCollecting(iAttr);
+		tBlock.m_dValues.insert ( tBlock.m_dValues.end(), pData, pData+iLength );
+		tBlock.m_dOffsets.push_back ( (int64_t)tBlock.m_dValues.size() );
+		tBlock.m_iDocs++;
+		return;
+	}
+
 	for ( auto & i : m_dPackers[iAttr] )
 		i->AddDoc ( pData, iLength );
 }
 
+// splits the batch at block boundaries; full blocks are handed over to the pool
+template <typename ADD>
+void Builder_c::AddBatch ( int iAttr, int iNumDocs, ADD && fnAddChunk )
+{
+	int iStart = 0;
+	while ( iStart < iNumDocs )
+	{
+		CollectedBlock_t & tBlock = GetCollecting(iAttr);
+		int iChunk = std::min ( iNumDocs-iStart, DOCS_PER_BLOCK-tBlock.m_iDocs );
+		fnAddChunk ( tBlock, iStart, iChunk );
+		tBlock.m_iDocs += iChunk;
+		iStart += iChunk;
+	}
+}
 
-bool Builder_c::WriteHeaders ( FileWriter_c & tWriter, std::string & sError )
+
+void Builder_c::SetAttrBatch ( int iAttr, const Span_T<int64_t> & dValues )
 {
-	tWriter.Write_uint32 ( STORAGE_VERSION );
-	tWriter.Write_uint32 ( (uint32_t)m_dFlatPackers.size() );
-	for ( size_t i=0; i < m_dFlatPackers.size(); i++ )
+	if ( !m_pPool )
 	{
-		auto & pPacker = m_dFlatPackers[i];
-		if ( !pPacker->WriteHeader ( tWriter, sError ) )
-			return false;
+		for ( auto & i : m_dPackers[iAttr] )
+			i->AddDocs(dValues);
 
-		int64_t tNextOffset = i<m_dFlatPackers.size()-1 ? tWriter.GetPos() : 0;
-		tWriter.Write_uint64 ( tNextOffset + sizeof(int64_t) );
+		return;
 	}
 
-	return true;
+	AddBatch ( iAttr, (int)dValues.size(), [&dValues]( CollectedBlock_t & tBlock, int iStart, int iCount )
+		{
+			tBlock.m_dValues.insert ( tBlock.m_dValues.end(), dValues.data()+iStart, dValues.data()+iStart+iCount );
+		} );
 }
 
 
-bool Builder_c::WriteBodies ( std::string & sError )
+void Builder_c::SetAttrBatch ( int iAttr, const Span_T<int64_t> & dOffsets, const uint8_t * pData )
 {
-	return std::all_of ( m_dFlatPackers.cbegin(), m_dFlatPackers.cend(), [this, &sError]( auto & i ){ return i->WriteBody ( m_sFile, sError ); } );
-}
+	if ( dOffsets.empty() )
+		return;
 
+	if ( !m_pPool )
+	{
+		for ( auto & i : m_dPackers[iAttr] )
+			i->AddDocs ( dOffsets, pData );
 
-void Builder_c::Cleanup()
-{
-	std::for_each ( m_dFlatPackers.cbegin(), m_dFlatPackers.cend(), []( auto & i ){ return i->Cleanup(); } );
+		return;
+	}
+
+	AddBatch ( iAttr, (int)dOffsets.size()-1, [&dOffsets, pData]( CollectedBlock_t & tBlock, int iStart, int iCount )
+		{
+			AppendChunk ( tBlock.m_dData, tBlock.m_dOffsets, dOffsets.data()+iStart, pData, iCount );
+		} );
 }
 
 
-bool Builder_c::Done ( std::string & sError )
+void Builder_c::SetAttrBatch ( int iAttr, const Span_T<int64_t> & dOffsets, const int64_t * pData )
 {
-	std::for_each ( m_dFlatPackers.cbegin(), m_dFlatPackers.cend(), []( auto & i ){ i->Done(); } );
+	if ( dOffsets.empty() )
+		return;
+
+	if ( !m_pPool )
+	{
+		for ( auto & i : m_dPackers[iAttr] )
+			i->AddDocs ( dOffsets, pData );
+
+		return;
+	}
+
+	AddBatch ( iAttr, (int)dOffsets.size()-1, [&dOffsets, pData]( CollectedBlock_t & tBlock, int iStart, int iCount )
+		{
+			AppendChunk ( tBlock.m_dValues, tBlock.m_dOffsets, dOffsets.data()+iStart, pData, iCount );
+		} );
+}
 
-	// [N][header0][offset_of_header1]...[body0]...
 
+bool Builder_c::WriteHeaders ( FileWriter_c & tWriter, std::string & sError )
+{
+	std::vector<int64_t> dHeaderOffsets;
+	for ( auto & i : m_dFlatPackers )
 	{
-		FileWriter_c tWriter;
-		if ( !tWriter.Open ( m_sFile, sError ) )
+		dHeaderOffsets.push_back ( tWriter.GetPos() );
+		if ( !i->WriteHeader ( tWriter, sError ) )
 			return false;
+	}
 
-		if ( !WriteHeaders ( tWriter, sError) )
-			return false;
+	// the directory lets the reader load headers on demand
+	int64_t iDirOffset = tWriter.GetPos();
+	tWriter.Write_uint32 ( (uint32_t)m_dFlatPackers.size() );
+	for ( size_t i = 0; i < m_dFlatPackers.size(); i++ )
+	{
+		tWriter.Write_string ( m_dFlatPackers[i]->GetName() );
+		tWriter.Write_uint32 ( to_underlying ( m_dFlatPackers[i]->GetType() ) );
+		tWriter.Write_uint64 ( dHeaderOffsets[i] );
+	}
 
-		int64_t tBodyOffset = tWriter.GetPos();
-		for ( auto & i : m_dFlatPackers )
-		{
-			i->CorrectOffset ( tWriter, tBodyOffset );
-			tBodyOffset += i->GetBodySize();
-		}
+	tWriter.Write_uint64 ( iDirOffset );
+	return true;
+}
+
+
+void Builder_c::FinalizePackers()
+{
+	if ( !m_pPool )
+	{
+		std::for_each ( m_dFlatPackers.cbegin(), m_dFlatPackers.cend(), []( auto & i ){ i->Done(); } );
+		return;
 	}
 
-	if ( !WriteBodies(sError) )
+	// the remaining rows are packed as the last block of every attribute
+	for ( size_t i = 0; i < m_dPackers.size(); i++ )
+		PackCollected ( (int)i, true );
+
+	for ( size_t i = 0; i < m_dPackers.size(); i++ )
+		WaitPacking ( (int)i );
+}
+
+
+bool Builder_c::Done ( std::string & sError )
+{
+	FinalizePackers();
+
+	// [version][blocks of all attributes]...[header0]...[headerN][N][name0,type0,offset0]...[nameN,typeN,offsetN][offset of N]
+	FileWriter_c & tWriter = m_tWriter.GetWriter();
+	if ( !WriteHeaders ( tWriter, sError ) )
 		return false;
 
-	Cleanup();
+	tWriter.Close();
+
+	if ( tWriter.IsError() )
+	{
+		sError = tWriter.GetError();
+		return false;
+	}
 
 	return true;
 }
 
 
+void Builder_c::GetPackingStats ( std::vector<PackingStats_t> & dStats ) const
+{
+	for ( auto & i : m_dFlatPackers )
+		i->AddPackingStats(dStats);
+}
+
+
 bool CheckSubblockSize ( int iSubblockSize, std::string & sError )
 {
 	const int MIN_SUBBLOCK_SIZE = 128;
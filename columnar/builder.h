@@ -22,7 +22,16 @@
 namespace columnar
 {
 
-static const uint32_t STORAGE_VERSION = 9;
+static const uint32_t STORAGE_VERSION = 19;
+
+struct PackingStats_t
+{
+	std::string	m_sAttr;
+	std::string	m_sPacking;
+	int			m_iBlocks = 0;
+	int64_t		m_iSize = 0;
+};
+
 
 class Builder_i
 {
@@ -32,7 +41,16 @@ public:
 	virtual void	SetAttr ( int iAttr, int64_t tAttr ) = 0;
 	virtual void	SetAttr ( int iAttr, const uint8_t * pData, int iLength ) = 0;
 	virtual void	SetAttr ( int iAttr, const int64_t * pData, int iLength ) = 0;
+
+	// batch versions; strings and MVAs are passed as N+1 offsets into a data array (value i spans [dOffsets[i],dOffsets[i+1]))
+	virtual void	SetAttrBatch ( int iAttr, const util::Span_T<int64_t> & dValues ) = 0;
+	virtual void	SetAttrBatch ( int iAttr, const util::Span_T<int64_t> & dOffsets, const uint8_t * pData ) = 0;
+	virtual void	SetAttrBatch ( int iAttr, const util::Span_T<int64_t> & dOffsets, const int64_t * pData ) = 0;
+
 	virtual bool	Done ( std::string & sError ) = 0;
+
+	// number of blocks (and bytes) stored with each packing, per attribute
+	virtual void	GetPackingStats ( std::vector<PackingStats_t> & dStats ) const = 0;
 };
 
 } // namespace columnar
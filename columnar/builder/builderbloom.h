@@ -0,0 +1,138 @@
+// Copyright (c) 2020-2022, Manticore Software LTD (https://manticoresearch.com)
+// All rights reserved
+//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "columnar.h"
+
+#include <algorithm>
+
+namespace columnar
+{
+
+static const int BLOOM_BITS_PER_VALUE = 10;	// ~1% false positives with 7 hashes
+static const int BLOOM_NUM_HASHES = 7;
+
+FORCE_INLINE uint64_t BloomHash ( uint64_t uValue )
+{
+	// splitmix64 finalizer
+	uValue ^= uValue >> 30;
+	uValue *= 0xbf58476d1ce4e5b9ULL;
+	uValue ^= uValue >> 27;
+	uValue *= 0x94d049bb133111ebULL;
+	uValue ^= uValue >> 31;
+	return uValue;
+}
+
+FORCE_INLINE void BloomSet ( uint64_t * pWords, int iNumWords, uint64_t uValue )
+{
+	uint64_t uHash = BloomHash(uValue);
+	uint32_t uHash1 = (uint32_t)uHash;
+	uint32_t uHash2 = uint32_t ( uHash >> 32 ) | 1;
+	uint32_t uNumBits = uint32_t(iNumWords) << 6;
+
+	for ( int i = 0; i < BLOOM_NUM_HASHES; i++ )
+	{
+		uint32_t uBit = ( uHash1 + i*uHash2 ) % uNumBits;
+		pWords[uBit >> 6] |= 1ULL << ( uBit & 63 );
+	}
+}
+
+FORCE_INLINE bool BloomTest ( const uint64_t * pWords, int iNumWords, uint64_t uValue )
+{
+	uint64_t uHash = BloomHash(uValue);
+	uint32_t uHash1 = (uint32_t)uHash;
+	uint32_t uHash2 = uint32_t ( uHash >> 32 ) | 1;
+	uint32_t uNumBits = uint32_t(iNumWords) << 6;
+
+	for ( int i = 0; i < BLOOM_NUM_HASHES; i++ )
+	{
+		uint32_t uBit = ( uHash1 + i*uHash2 ) % uNumBits;
+		if ( !( pWords[uBit >> 6] & ( 1ULL << ( uBit & 63 ) ) ) )
+			return false;
+	}
+
+	return true;
+}
+
+// per-subblock bloom filters over attribute values; used to skip subblocks on equality filters
+class BloomFilterBuilder_c
+{
+public:
+				BloomFilterBuilder_c ( const Settings_t & tSettings ) : m_tSettings ( tSettings ) {}
+
+	void		Enable()	{ m_bEnabled = true; }
+	void		Add ( uint64_t uValue );
+	bool		Save ( util::FileWriter_c & tWriter, std::string & sError );
+
+private:
+	const Settings_t &		m_tSettings;
+	bool					m_bEnabled = false;
+	int						m_iCollected = 0;
+	std::vector<uint64_t>	m_dCollected;
+	std::vector<uint32_t>	m_dFilterSizes;
+	std::vector<uint64_t>	m_dFilters;
+
+	void		Flush();
+};
+
+
+inline void BloomFilterBuilder_c::Add ( uint64_t uValue )
+{
+	if ( !m_bEnabled )
+		return;
+
+	if ( m_iCollected==m_tSettings.m_iSubblockSize )
+		Flush();
+
+	m_dCollected.push_back(uValue);
+	m_iCollected++;
+}
+
+
+inline void BloomFilterBuilder_c::Flush()
+{
+	if ( !m_iCollected )
+		return;
+
+	std::sort ( m_dCollected.begin(), m_dCollected.end() );
+	m_dCollected.erase ( std::unique ( m_dCollected.begin(), m_dCollected.end() ), m_dCollected.end() );
+
+	int iNumWords = std::max ( 1, int ( ( m_dCollected.size()*BLOOM_BITS_PER_VALUE + 63 ) >> 6 ) );
+	size_t tOffset = m_dFilters.size();
+	m_dFilters.resize ( tOffset + iNumWords, 0 );
+	for ( auto i : m_dCollected )
+		BloomSet ( m_dFilters.data() + tOffset, iNumWords, i );
+
+	m_dFilterSizes.push_back(iNumWords);
+	m_dCollected.resize(0);
+	m_iCollected = 0;
+}
+
+
+inline bool BloomFilterBuilder_c::Save ( util::FileWriter_c & tWriter, std::string & sError )
+{
+	Flush();
+
+	tWriter.Pack_uint32 ( (uint32_t)m_dFilterSizes.size() );
+	for ( auto i : m_dFilterSizes )
+		tWriter.Pack_uint32(i);
+
+	tWriter.Write ( (const uint8_t*)m_dFilters.data(), m_dFilters.size()*sizeof ( m_dFilters[0] ) );
+	return !tWriter.IsError();
+}
+
+} // namespace columnar
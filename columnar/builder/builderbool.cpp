@@ -24,6 +24,16 @@ namespace columnar
 using namespace util;
 using namespace common;
 
+static const char * GetPackingName ( BoolPacking_e ePacking )
+{
+	switch ( ePacking )
+	{
+	case BoolPacking_e::CONST:	return "const";
+	case BoolPacking_e::BITMAP:	return "bitmap";
+	default:					return "unknown";
+	}
+}
+
 class AttributeHeaderBuilder_Bool_c : public AttributeHeaderBuilder_c
 {
 	using BASE = AttributeHeaderBuilder_c;
@@ -33,7 +43,7 @@ public:
 
 			AttributeHeaderBuilder_Bool_c ( const Settings_t & tSettings, const std::string & sName, AttrType_e eType );
 
-	bool	Save ( FileWriter_c & tWriter, int64_t & tBaseOffset, std::string & sError );
+	bool	Save ( FileWriter_c & tWriter, std::string & sError );
 };
 
 
@@ -43,9 +53,9 @@ AttributeHeaderBuilder_Bool_c::AttributeHeaderBuilder_Bool_c ( const Settings_t
 {}
 
 
-bool AttributeHeaderBuilder_Bool_c::Save ( FileWriter_c & tWriter, int64_t & tBaseOffset, std::string & sError )
+bool AttributeHeaderBuilder_Bool_c::Save ( FileWriter_c & tWriter, std::string & sError )
 {
-	if ( !BASE::Save ( tWriter, tBaseOffset, sError ) )
+	if ( !BASE::Save ( tWriter, sError ) )
 		return false;
 
 	return m_tMinMax.Save ( tWriter, sError );
@@ -66,6 +76,7 @@ public:
 	void				AddDoc ( int64_t tAttr ) override;
 	void				AddDoc ( const uint8_t * pData, int iLength ) override;
 	void				AddDoc ( const int64_t * pData, int iLength ) override;
+	void				AddDocs ( const Span_T<int64_t> & dValues ) override;
 	void				Flush() override;
 
 protected:
@@ -119,6 +130,24 @@ void Packer_Bool_c::AddDoc ( const int64_t * pData, int iLength )
 }
 
 
+void Packer_Bool_c::AddDocs ( const Span_T<int64_t> & dValues )
+{
+	size_t tDoc = 0;
+	while ( tDoc < dValues.size() )
+	{
+		if ( m_dCollected.size()==DOCS_PER_BLOCK )
+			Flush();
+
+		size_t tChunkEnd = std::min ( dValues.size(), tDoc + DOCS_PER_BLOCK - m_dCollected.size() );
+		for ( ; tDoc < tChunkEnd; tDoc++ )
+		{
+			AnalyzeCollected ( dValues[tDoc] );
+			m_dCollected.push_back ( !!dValues[tDoc] );
+		}
+	}
+}
+
+
 void Packer_Bool_c::AnalyzeCollected ( int64_t tAttr )
 {
 	bool bValue = !!tAttr;
@@ -171,9 +200,10 @@ void Packer_Bool_c::Flush()
 	if ( m_dCollected.empty() )
 		return;
 
-	m_tHeader.AddBlock ( m_tWriter.GetPos() );
-
-	WriteToFile ( ChoosePacking() );
+	BoolPacking_e ePacking = ChoosePacking();
+	WriteToFile(ePacking);
+	CountPackedBlock ( to_underlying(ePacking), GetPackingName(ePacking) );
+	WriteBlock();
 
 	m_dCollected.resize(0);
 	m_bFirst = true;
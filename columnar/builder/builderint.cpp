@@ -17,9 +17,12 @@
 #include "builderint.h"
 #include "buildertraits.h"
 #include "builderminmax.h"
+#include "builderbloom.h"
 
 #include <unordered_map>
 #include <algorithm>
+#include <cfloat>
+#include <cmath>
 
 namespace columnar
 {
@@ -27,6 +30,61 @@ namespace columnar
 using namespace util;
 using namespace common;
 
+static const char * GetPackingName ( IntPacking_e ePacking )
+{
+	switch ( ePacking )
+	{
+	case IntPacking_e::CONST:	return "const";
+	case IntPacking_e::TABLE:	return "table";
+	case IntPacking_e::DELTA:	return "delta";
+	case IntPacking_e::GENERIC:	return "generic";
+	case IntPacking_e::HASH:	return "hash";
+	case IntPacking_e::FOR:		return "for";
+	case IntPacking_e::DICT:	return "dict";
+	case IntPacking_e::DECIMAL:	return "decimal";
+	case IntPacking_e::DELTA_DELTA:	return "deltadelta";
+	case IntPacking_e::RLE:		return "rle";
+	default:					return "unknown";
+	}
+}
+
+// relative per-value decoding cost used when trial-encoding blocks
+static float GetDecodeCost ( IntPacking_e ePacking )
+{
+	switch ( ePacking )
+	{
+	case IntPacking_e::CONST:	return 0.0f;
+	case IntPacking_e::HASH:	return 0.25f;	// raw values
+	case IntPacking_e::FOR:		return 0.25f;	// shift + mask
+	case IntPacking_e::TABLE:	return 0.5f;	// bitunpack + table lookup
+	case IntPacking_e::DICT:	return 0.5f;	// bitunpack + dictionary lookup
+	case IntPacking_e::DECIMAL:	return 0.5f;	// shift + mask + int-to-float
+	case IntPacking_e::GENERIC:	return 1.0f;	// pfor
+	case IntPacking_e::DELTA:	return 1.5f;	// pfor + prefix sum
+	case IntPacking_e::DELTA_DELTA:	return 2.0f;	// pfor + zigzag + two prefix sums
+	case IntPacking_e::RLE:		return 0.25f;	// run lookup
+	default:					return 1.0f;
+	}
+}
+
+// rough size estimate (in bits) of PFOR-encoded values given a histogram of their bit widths
+static int64_t EstimatePFORBits ( const int * pBitWidths, int iMaxBits, int iNumValues )
+{
+	const int EXCEPTION_OVERHEAD_BITS = 8;
+
+	int64_t iBest = INT64_MAX;
+	int iExceptions = 0;
+	for ( int iBits = iMaxBits; iBits>=0; iBits-- )
+	{
+		iBest = std::min ( iBest, int64_t(iBits)*iNumValues + int64_t(iExceptions)*( iMaxBits-iBits+EXCEPTION_OVERHEAD_BITS ) );
+		iExceptions += pBitWidths[iBits];
+	}
+
+	return iBest;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 template <typename T>
 class AttributeHeaderBuilder_Int_T : public AttributeHeaderBuilder_c
 {
@@ -34,25 +92,32 @@ class AttributeHeaderBuilder_Int_T : public AttributeHeaderBuilder_c
 
 public:
 	MinMaxBuilder_T<T>	m_tMinMax;
+	std::vector<uint64_t> m_dDictionary;
+	BloomFilterBuilder_c m_tBloom;
 
 			AttributeHeaderBuilder_Int_T ( const Settings_t & tSettings, const std::string & sName, AttrType_e eType );
 
-	bool	Save ( FileWriter_c & tWriter, int64_t & tBaseOffset, std::string & sError );
+	bool	Save ( FileWriter_c & tWriter, std::string & sError );
 };
 
 template <typename T>
 AttributeHeaderBuilder_Int_T<T>::AttributeHeaderBuilder_Int_T ( const Settings_t & tSettings, const std::string & sName, AttrType_e eType )
 	: BASE ( tSettings, sName, eType )
 	, m_tMinMax ( tSettings )
+	, m_tBloom ( tSettings )
 {}
 
 template <typename T>
-bool AttributeHeaderBuilder_Int_T<T>::Save ( FileWriter_c & tWriter, int64_t & tBaseOffset, std::string & sError )
+bool AttributeHeaderBuilder_Int_T<T>::Save ( FileWriter_c & tWriter, std::string & sError )
 {
-	if ( !BASE::Save ( tWriter, tBaseOffset, sError ) )
+	if ( !BASE::Save ( tWriter, sError ) )
+		return false;
+
+	if ( !m_tMinMax.Save ( tWriter, sError ) )
 		return false;
 
-	return m_tMinMax.Save ( tWriter, sError );
+	WriteVectorPacked ( m_dDictionary, tWriter );
+	return m_tBloom.Save ( tWriter, sError );
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -63,25 +128,32 @@ class AttributeHeaderBuilder_Float_c : public AttributeHeaderBuilder_c
 
 public:
 	MinMaxBuilder_T<float>	m_tMinMax;
+	std::vector<uint64_t>	m_dDictionary;
+	BloomFilterBuilder_c	m_tBloom;
 
 			AttributeHeaderBuilder_Float_c ( const Settings_t & tSettings, const std::string & sName, AttrType_e eType );
 
-	bool	Save ( FileWriter_c & tWriter, int64_t & tBaseOffset, std::string & sError );
+	bool	Save ( FileWriter_c & tWriter, std::string & sError );
 };
 
 
 AttributeHeaderBuilder_Float_c::AttributeHeaderBuilder_Float_c ( const Settings_t & tSettings, const std::string & sName, AttrType_e eType )
 	: BASE ( tSettings, sName, eType )
 	, m_tMinMax ( tSettings )
+	, m_tBloom ( tSettings )
 {}
 
 
-bool AttributeHeaderBuilder_Float_c::Save ( FileWriter_c & tWriter, int64_t & tBaseOffset, std::string & sError )
+bool AttributeHeaderBuilder_Float_c::Save ( FileWriter_c & tWriter, std::string & sError )
 {
-	if ( !BASE::Save ( tWriter, tBaseOffset, sError ) )
+	if ( !BASE::Save ( tWriter, sError ) )
 		return false;
 
-	return m_tMinMax.Save ( tWriter, sError );
+	if ( !m_tMinMax.Save ( tWriter, sError ) )
+		return false;
+
+	WriteVectorPacked ( m_dDictionary, tWriter );
+	return m_tBloom.Save ( tWriter, sError );
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -99,13 +171,23 @@ public:
 	void				AddDoc ( int64_t tAttr ) override;
 	void				AddDoc ( const uint8_t * pData, int iLength ) override;
 	void				AddDoc ( const int64_t * pData, int iLength ) override;
+	void				AddDocs ( const Span_T<int64_t> & dValues ) override;
 	void				Flush() override;
 
+	void				AddPackingStats ( std::vector<PackingStats_t> & dStats ) const override;
+
 	void				OverridePacking ( IntPacking_e eSrc, IntPacking_e eDst );
+	void				EnableBloomFilter() { m_tHeader.m_tBloom.Enable(); }
 
-private:
+protected:
 	T						m_tMin = T(0);
 	T						m_tMax = T(0);
+	std::vector<T>			m_dCollected;
+
+	virtual IntPacking_e ChoosePacking();
+	virtual void		WriteToFile ( IntPacking_e ePacking );
+
+private:
 	T						m_tPrevValue = T(0);
 
 	std::unordered_map<T,int> m_hUnique { DOCS_PER_BLOCK };
@@ -114,10 +196,13 @@ private:
 	std::vector<uint32_t>	m_dTableIndexes;
 	std::vector<uint32_t>	m_dTablePacked;
 
+	int						m_iRuns = 0;
+	std::vector<uint32_t>	m_dRunEnds;
+	std::vector<T>			m_dRunValues;
+
 	bool					m_bMonoAsc = true;
 	bool					m_bMonoDesc = true;
 	std::vector<uint8_t>	m_dTmpBuffer;
-	std::vector<T>			m_dCollected;
 
 	std::unique_ptr<IntCodec_i>	m_pCodec;
 	std::vector<uint32_t>	m_dCompressed;
@@ -125,19 +210,40 @@ private:
 	std::vector<uint32_t>	m_dUncompressed32;
 	std::vector<uint8_t>	m_dTmpBuffer2;
 	std::vector<uint32_t>	m_dSubblockSizes;
+	std::vector<uint64_t>	m_dFORPacked;
+
+	std::unordered_map<T,uint32_t> m_hDictionary;
+	bool					m_bDictionary = true;
+	int						m_iDictFailures = 0;	// consecutive blocks that didn't fit the dictionary
+	std::vector<uint32_t>	m_dOrdinals;
+	std::vector<uint32_t>	m_dHashOrdinals;
+	int						m_iDictBits = -1;
 
 	IntPacking_e			m_dPackingOverrides[to_underlying(IntPacking_e::TOTAL)];
+	std::vector<uint8_t>	m_dBestBlock;
+	std::pair<int,int64_t>	m_dPackingStats[to_underlying(IntPacking_e::TOTAL)];
 
 	void				AnalyzeCollected ( int64_t tAttr );
-	IntPacking_e		ChoosePacking() const;
-	void				WriteToFile ( IntPacking_e ePacking );
+	bool				BuildDictOrdinals();
+	void				RollbackDictionary ( size_t tSize );
+	void				EstimatePackedBits ( int64_t & iFORBits, int64_t & iPFORBits, int64_t & iDeltaDeltaBits ) const;
+	bool				IsSubblockSorted ( const Span_T<T> & dSubblockValues ) const;
+	IntPacking_e		TrialEncode ( IntPacking_e eChosen );
 
 	void				WritePacked_Const();
 	void				WritePacked_Table();
+	void				WritePacked_FOR();
+	void				WritePacked_Dict();
+	void				WritePacked_Hash();
+	void				WritePacked_RLE();
+	bool				BuildHashTable();
+	void				WriteOrdinals ( const std::vector<uint32_t> & dOrdinals, int iBits );
 
 	template <typename U, typename WRITER>
 	void				WriteSubblock_Delta ( const Span_T<U> & dSubblockValues, WRITER & tWriter, std::vector<U> & dTmp, bool bWriteFlag );
 
+	void				WriteSubblock_DeltaDelta ( const Span_T<T> & dSubblockValues, MemWriter_c & tWriter );
+
 	template <typename U>
 	bool				WriteNullMap ( const Span_T<U> & dSubblockValues, MemWriter_c & tWriter );
 
@@ -157,7 +263,10 @@ Packer_Int_T<T,HEADER>::Packer_Int_T ( const Settings_t & tSettings, const std::
 	m_dTableIndexes.resize ( tSettings.m_iSubblockSize );
 
 	for ( auto i = to_underlying(IntPacking_e::CONST); i < to_underlying(IntPacking_e::TOTAL); i++ )
+	{
 		m_dPackingOverrides[i] = IntPacking_e(i);
+		m_dPackingStats[i] = { 0, 0 };
+	}
 }
 
 template <typename T, typename HEADER>
@@ -182,11 +291,33 @@ void Packer_Int_T<T,HEADER>::AddDoc ( const int64_t * pData, int iLength )
 	assert ( 0 && "INTERNAL ERROR: sending MVA to integer packer" );
 }
 
+template <typename T, typename HEADER>
+void Packer_Int_T<T,HEADER>::AddDocs ( const Span_T<int64_t> & dValues )
+{
+	size_t tDoc = 0;
+	while ( tDoc < dValues.size() )
+	{
+		if ( m_dCollected.size()==DOCS_PER_BLOCK )
+			Flush();
+
+		size_t tChunkEnd = std::min ( dValues.size(), tDoc + DOCS_PER_BLOCK - m_dCollected.size() );
+		for ( ; tDoc < tChunkEnd; tDoc++ )
+		{
+			int64_t tAttr = dValues[tDoc];
+			AnalyzeCollected(tAttr);
+			m_dCollected.push_back ( (T)tAttr );
+		}
+	}
+}
+
 template <typename T, typename HEADER>
 void Packer_Int_T<T,HEADER>::AnalyzeCollected ( int64_t tAttr )
 {
 	T tValue = (T)tAttr;
 
+	if ( !m_iUniques || tValue!=m_tPrevValue )
+		m_iRuns++;
+
 	if ( !m_iUniques )
 	{
 		m_tMin = tValue;
@@ -209,18 +340,48 @@ void Packer_Int_T<T,HEADER>::AnalyzeCollected ( int64_t tAttr )
 	}
 
 	m_tHeader.m_tMinMax.Add(tValue);
+	m_tHeader.m_tBloom.Add ( (uint64_t)tValue );
 
 	m_tPrevValue = tValue;
 }
 
 template <typename T, typename HEADER>
-IntPacking_e Packer_Int_T<T,HEADER>::ChoosePacking() const
+IntPacking_e Packer_Int_T<T,HEADER>::ChoosePacking()
 {
 	if ( m_iUniques==1 )
 		return m_dPackingOverrides[to_underlying(IntPacking_e::CONST)];
 
+	int64_t iNumValues = (int64_t)m_dCollected.size();
+	int64_t iRLEBits = int64_t(m_iRuns)*( CalcNumBits ( uint64_t ( T ( m_tMax-m_tMin ) ) ) + RLE_RUN_BITS );
+
 	if ( m_iUniques<256 )
-		return m_dPackingOverrides[to_underlying(IntPacking_e::TABLE)];
+	{
+		bool bRLE = iRLEBits < CalcNumBits(m_iUniques)*iNumValues;
+		return m_dPackingOverrides[to_underlying ( bRLE ? IntPacking_e::RLE : IntPacking_e::TABLE )];
+	}
+
+	if ( m_iDictBits>=0 )
+	{
+		bool bRLE = iRLEBits < m_iDictBits*iNumValues;
+		return m_dPackingOverrides[to_underlying ( bRLE ? IntPacking_e::RLE : IntPacking_e::DICT )];
+	}
+
+	// max average bit width increase (compared to PFOR/delta PFOR) that we accept
+	const int MAX_FOR_BIT_PENALTY = 1;
+
+	int64_t iFORBits, iPFORBits, iDeltaDeltaBits;
+	EstimatePackedBits ( iFORBits, iPFORBits, iDeltaDeltaBits );
+
+	if ( iRLEBits < std::min ( { iFORBits, iPFORBits, iDeltaDeltaBits } ) )
+		return m_dPackingOverrides[to_underlying(IntPacking_e::RLE)];
+
+	// near-regular sequences (e.g. timestamps) that are not necessarily monotonic; decoding is slower, so require a solid gain
+	if ( iDeltaDeltaBits*2 < std::min ( iFORBits, iPFORBits ) )
+		return m_dPackingOverrides[to_underlying(IntPacking_e::DELTA_DELTA)];
+
+	// fixed-width values are a bit larger, but don't need to decode the whole subblock on random access
+	if ( iFORBits <= iPFORBits + MAX_FOR_BIT_PENALTY*iNumValues )
+		return m_dPackingOverrides[to_underlying(IntPacking_e::FOR)];
 
 	if ( m_bMonoAsc || m_bMonoDesc )
 		return m_dPackingOverrides[to_underlying(IntPacking_e::DELTA)];
@@ -228,6 +389,192 @@ IntPacking_e Packer_Int_T<T,HEADER>::ChoosePacking() const
 	return m_dPackingOverrides[to_underlying(IntPacking_e::GENERIC)];
 }
 
+template <typename T, typename HEADER>
+bool Packer_Int_T<T,HEADER>::BuildDictOrdinals()
+{
+	m_iDictBits = -1;
+
+	// low-cardinality blocks go to TABLE, monotonic blocks are better off with DELTA
+	if ( !m_bDictionary || m_iUniques<256 || m_bMonoAsc || m_bMonoDesc )
+		return false;
+
+	auto & dDictionary = m_tHeader.m_dDictionary;
+	size_t tDictSize = dDictionary.size();
+	int64_t iNumValues = (int64_t)m_dCollected.size();
+	int64_t iFORBits = CalcNumBits ( uint64_t ( T ( m_tMax-m_tMin ) ) )*iNumValues;
+	int64_t iNewValuesBits = 0;
+
+	m_dOrdinals.resize(0);
+	uint32_t uMaxOrdinal = 0;
+	for ( auto i : m_dCollected )
+	{
+		uint32_t uOrdinal = 0;
+		auto tFound = m_hDictionary.find(i);
+		if ( tFound!=m_hDictionary.end() )
+			uOrdinal = tFound->second;
+		else
+		{
+			// new dictionary values are stored in the header; give up if ordinals+new values won't beat plain FOR
+			iNewValuesBits += ByteCodec_c::CalcPackedLen(i)*8;
+			if ( dDictionary.size()==MAX_DICTIONARY_SIZE || iNewValuesBits + CalcNumBits ( dDictionary.size() )*iNumValues >= iFORBits )
+			{
+				RollbackDictionary(tDictSize);
+
+				// a single burst of new values doesn't make the attribute high-cardinality; give up only after several such blocks in a row
+				if ( ++m_iDictFailures>=MAX_DICT_FAILURES )
+				{
+					std::unordered_map<T,uint32_t>().swap(m_hDictionary);
+					m_bDictionary = false;
+				}
+
+				return false;
+			}
+
+			uOrdinal = (uint32_t)dDictionary.size();
+			m_hDictionary.insert ( { i, uOrdinal } );
+			dDictionary.push_back ( (uint64_t)i );
+		}
+
+		m_dOrdinals.push_back(uOrdinal);
+		uMaxOrdinal = std::max ( uMaxOrdinal, uOrdinal );
+	}
+
+	m_iDictBits = CalcNumBits(uMaxOrdinal);
+	m_iDictFailures = 0;
+	return true;
+}
+
+template <typename T, typename HEADER>
+void Packer_Int_T<T,HEADER>::RollbackDictionary ( size_t tSize )
+{
+	auto & dDictionary = m_tHeader.m_dDictionary;
+	for ( size_t i = tSize; i < dDictionary.size(); i++ )
+		m_hDictionary.erase ( (T)dDictionary[i] );
+
+	dDictionary.resize(tSize);
+}
+
+template <typename T, typename HEADER>
+void Packer_Int_T<T,HEADER>::EstimatePackedBits ( int64_t & iFORBits, int64_t & iPFORBits, int64_t & iDeltaDeltaBits ) const
+{
+	const int MAX_BITS = sizeof(T)*8;
+	int dWidths[MAX_BITS+1] = {};
+	int dDeltaDeltaWidths[MAX_BITS+1] = {};
+	int iMaxWidth = 0;
+	int iMaxPFORWidth = 0;
+	int iMaxDeltaDeltaWidth = 0;
+	bool bMono = m_bMonoAsc || m_bMonoDesc;
+
+	// generic PFOR subtracts subblock min; delta PFOR encodes deltas; delta-of-delta encodes zigzagged delta changes
+	int iSubblockSize = m_tHeader.GetSettings().m_iSubblockSize;
+	for ( size_t tStart = 0; tStart < m_dCollected.size(); tStart += iSubblockSize )
+	{
+		auto tBegin = m_dCollected.begin()+tStart;
+		auto tEnd = m_dCollected.begin() + std::min ( m_dCollected.size(), tStart+iSubblockSize );
+		T tSubblockMin = *std::min_element ( tBegin, tEnd );
+		T tPrev = *tBegin;
+		T tPrevDelta = 0;
+		for ( auto tIt = tBegin; tIt!=tEnd; ++tIt )
+		{
+			T tValue = *tIt;
+			iMaxWidth = std::max ( iMaxWidth, CalcNumBits ( uint64_t ( T ( tValue-m_tMin ) ) ) );
+
+			T tEncoded = tValue-tSubblockMin;
+			if ( bMono )
+				tEncoded = m_bMonoAsc ? T ( tValue-tPrev ) : T ( tPrev-tValue );
+
+			int iWidth = CalcNumBits ( uint64_t(tEncoded) );
+			dWidths[iWidth]++;
+			iMaxPFORWidth = std::max ( iMaxPFORWidth, iWidth );
+
+			T tDelta = tValue-tPrev;
+			T tDeltaDelta = tDelta-tPrevDelta;
+			ZigzagEncode ( &tDeltaDelta, 1 );
+			int iDeltaDeltaWidth = CalcNumBits ( uint64_t(tDeltaDelta) );
+			dDeltaDeltaWidths[iDeltaDeltaWidth]++;
+			iMaxDeltaDeltaWidth = std::max ( iMaxDeltaDeltaWidth, iDeltaDeltaWidth );
+
+			tPrevDelta = tDelta;
+			tPrev = tValue;
+		}
+	}
+
+	int iNumValues = (int)m_dCollected.size();
+	iFORBits = int64_t(iMaxWidth)*iNumValues;
+	iPFORBits = EstimatePFORBits ( dWidths, iMaxPFORWidth, iNumValues );
+	iDeltaDeltaBits = EstimatePFORBits ( dDeltaDeltaWidths, iMaxDeltaDeltaWidth, iNumValues );
+}
+
+template <typename T, typename HEADER>
+bool Packer_Int_T<T,HEADER>::IsSubblockSorted ( const Span_T<T> & dSubblockValues ) const
+{
+	switch ( m_tHeader.GetType() )
+	{
+	case AttrType_e::FLOAT:
+		return false;	// bit patterns of negative floats are in reverse order
+
+	case AttrType_e::INT64:
+		return std::is_sorted ( dSubblockValues.begin(), dSubblockValues.end(), []( T a, T b ){ return (int64_t)a < (int64_t)b; } );
+
+	default:
+		return std::is_sorted ( dSubblockValues.begin(), dSubblockValues.end() );
+	}
+}
+
+template <typename T, typename HEADER>
+IntPacking_e Packer_Int_T<T,HEADER>::TrialEncode ( IntPacking_e eChosen )
+{
+	IntPacking_e dCandidates[to_underlying(IntPacking_e::TOTAL)];
+	int iNumCandidates = 0;
+	auto AddCandidate = [this, &dCandidates, &iNumCandidates]( IntPacking_e ePacking )
+	{
+		ePacking = m_dPackingOverrides[to_underlying(ePacking)];
+		if ( std::find ( dCandidates, dCandidates+iNumCandidates, ePacking )==dCandidates+iNumCandidates )
+			dCandidates[iNumCandidates++] = ePacking;
+	};
+
+	// packings that only derived packers know about come in through ChoosePacking
+	AddCandidate(eChosen);
+
+	if ( m_iUniques<256 )
+		AddCandidate ( IntPacking_e::TABLE );
+
+	if ( m_bMonoAsc || m_bMonoDesc )
+		AddCandidate ( IntPacking_e::DELTA );
+
+	AddCandidate ( IntPacking_e::GENERIC );
+	AddCandidate ( IntPacking_e::FOR );
+	AddCandidate ( IntPacking_e::DELTA_DELTA );
+
+	if ( (size_t)m_iRuns*4 < m_dCollected.size() )
+		AddCandidate ( IntPacking_e::RLE );
+
+	if ( m_iDictBits>=0 )
+		AddCandidate ( IntPacking_e::DICT );
+
+	const float fWeight = m_tHeader.GetSettings().m_fDecodeCostWeight;
+	auto & dBlockData = BASE::m_dBlockData;
+
+	IntPacking_e eBest = dCandidates[0];
+	float fBestCost = FLT_MAX;
+	for ( int i = 0; i < iNumCandidates; i++ )
+	{
+		dBlockData.resize(0);
+		WriteToFile ( dCandidates[i] );
+
+		float fCost = float ( dBlockData.size() ) + fWeight*float ( m_dCollected.size() )*GetDecodeCost ( dCandidates[i] );
+		if ( fCost < fBestCost )
+		{
+			fBestCost = fCost;
+			eBest = dCandidates[i];
+			dBlockData.swap(m_dBestBlock);
+		}
+	}
+
+	dBlockData.swap(m_dBestBlock);
+	return eBest;
+}
+
 template <typename T, typename HEADER>
 void Packer_Int_T<T,HEADER>::WriteToFile ( IntPacking_e ePacking )
 {
@@ -256,11 +603,27 @@ void Packer_Int_T<T,HEADER>::WriteToFile ( IntPacking_e ePacking )
 		break;
 
 	case IntPacking_e::HASH:
+		WritePacked_Hash();
+		break;
+
+	case IntPacking_e::FOR:
+		WritePacked_FOR();
+		break;
+
+	case IntPacking_e::DICT:
+		WritePacked_Dict();
+		break;
+
+	case IntPacking_e::DELTA_DELTA:
 		WritePackedSubblocks ( ePacking, [this]( const Span_T<T> & dSubblockValues, MemWriter_c & tWriter )
-			{ WriteSubblock_Hash ( dSubblockValues, tWriter ); }
+			{ WriteSubblock_DeltaDelta ( dSubblockValues, tWriter ); }
 		);
 		break;
 
+	case IntPacking_e::RLE:
+		WritePacked_RLE();
+		break;
+
 	default:
 		assert ( 0 && "Unknown packing" );
 		break;
@@ -273,17 +636,50 @@ void Packer_Int_T<T,HEADER>::Flush()
 	if ( m_dCollected.empty() )
 		return;
 
-	m_tHeader.AddBlock ( m_tWriter.GetPos() );
+	size_t tDictSize = m_tHeader.m_dDictionary.size();
+	BuildDictOrdinals();
+
+	IntPacking_e ePacking = ChoosePacking();
+	if ( m_tHeader.GetSettings().m_bTrialPacking && ePacking!=IntPacking_e::CONST )
+		ePacking = TrialEncode(ePacking);
+	else
+		WriteToFile(ePacking);
+
+	// don't keep dictionary values that are not referenced by any block
+	if ( ePacking!=IntPacking_e::DICT && m_iDictBits>=0 )
+		RollbackDictionary(tDictSize);
 
-	WriteToFile ( ChoosePacking() );
+	auto & tStats = m_dPackingStats[to_underlying(ePacking)];
+	tStats.first++;
+	tStats.second += (int64_t)BASE::m_dBlockData.size();
+
+	BASE::WriteBlock();
 
 	m_dCollected.resize(0);
 	m_hUnique.clear();
 	m_tPrevValue = 0;
 	m_iUniques = 0;
+	m_iRuns = 0;
 	m_bMonoAsc = m_bMonoDesc = true;
 }
 
+template <typename T, typename HEADER>
+void Packer_Int_T<T,HEADER>::AddPackingStats ( std::vector<PackingStats_t> & dStats ) const
+{
+	for ( auto i = to_underlying(IntPacking_e::CONST); i < to_underlying(IntPacking_e::TOTAL); i++ )
+	{
+		if ( !m_dPackingStats[i].first )
+			continue;
+
+		PackingStats_t tStats;
+		tStats.m_sAttr = m_tHeader.GetName();
+		tStats.m_sPacking = GetPackingName ( IntPacking_e(i) );
+		tStats.m_iBlocks = m_dPackingStats[i].first;
+		tStats.m_iSize = m_dPackingStats[i].second;
+		dStats.push_back(tStats);
+	}
+}
+
 template <typename T, typename HEADER>
 void Packer_Int_T<T,HEADER>::OverridePacking ( IntPacking_e eSrc, IntPacking_e eDst )
 {
@@ -320,6 +716,106 @@ void Packer_Int_T<T,HEADER>::WritePacked_Table()
 	WriteTableOrdinals ( m_dUniques, m_hUnique, m_dCollected, m_dTableIndexes, m_dTablePacked, m_tHeader.GetSettings().m_iSubblockSize, m_tWriter );
 }
 
+template <typename T, typename HEADER>
+void Packer_Int_T<T,HEADER>::WritePacked_FOR()
+{
+	int iBits = CalcNumBits ( uint64_t ( T ( m_tMax-m_tMin ) ) );
+	m_tWriter.Pack_uint64 ( (uint64_t)m_tMin );
+	m_tWriter.Write_uint8 ( (uint8_t)iBits );
+
+	// subblock sizes are multiples of 128, so every subblock starts at a word boundary
+	PackFOR ( Span_T<T>(m_dCollected), m_tMin, iBits, m_dFORPacked );
+	m_tWriter.Write ( (uint8_t*)m_dFORPacked.data(), m_dFORPacked.size()*sizeof ( m_dFORPacked[0] ) );
+}
+
+template <typename T, typename HEADER>
+void Packer_Int_T<T,HEADER>::WritePacked_RLE()
+{
+	m_dRunEnds.resize(0);
+	m_dRunValues.resize(0);
+	for ( size_t i = 1; i < m_dCollected.size(); i++ )
+		if ( m_dCollected[i]!=m_dCollected[i-1] )
+		{
+			m_dRunEnds.push_back ( (uint32_t)i );
+			m_dRunValues.push_back ( m_dCollected[i-1] );
+		}
+
+	m_dRunEnds.push_back ( (uint32_t)m_dCollected.size() );
+	m_dRunValues.push_back ( m_dCollected.back() );
+
+	// exclusive run ends (relative to block start), then run values
+	WriteValues_Delta_PFOR ( Span_T<uint32_t>(m_dRunEnds), m_dUncompressed32, m_dCompressed, m_tWriter, m_pCodec.get() );
+	WriteValues_PFOR ( Span_T<T>(m_dRunValues), m_dUncompressed, m_dCompressed, m_tWriter, m_pCodec.get(), true );
+}
+
+template <typename T, typename HEADER>
+void Packer_Int_T<T,HEADER>::WritePacked_Dict()
+{
+	assert ( m_iDictBits>0 && m_dOrdinals.size()==m_dCollected.size() );
+	WriteOrdinals ( m_dOrdinals, m_iDictBits );
+}
+
+template <typename T, typename HEADER>
+void Packer_Int_T<T,HEADER>::WritePacked_Hash()
+{
+	if ( !BuildHashTable() )
+	{
+		m_tWriter.Write_uint8 ( to_underlying ( IntHashPacking_e::RAW ) );
+		WritePackedSubblocks ( IntPacking_e::HASH, [this]( const Span_T<T> & dSubblockValues, MemWriter_c & tWriter )
+			{ WriteSubblock_Hash ( dSubblockValues, tWriter ); }
+		);
+		return;
+	}
+
+	m_tWriter.Write_uint8 ( to_underlying ( IntHashPacking_e::TABLE ) );
+	m_tWriter.Pack_uint32 ( (uint32_t)m_dUniques.size() );
+	WriteValues_Delta_PFOR ( Span_T<T>(m_dUniques), m_dUncompressed, m_dCompressed, m_tWriter, m_pCodec.get() );
+	WriteOrdinals ( m_dHashOrdinals, CalcNumBits ( m_dUniques.size()-1 ) );
+}
+
+// sorted table of unique hashes + ordinals; only used when it is smaller than raw hashes
+template <typename T, typename HEADER>
+bool Packer_Int_T<T,HEADER>::BuildHashTable()
+{
+	m_dUniques.resize ( m_dCollected.size() );
+	memcpy ( m_dUniques.data(), m_dCollected.data(), m_dCollected.size()*sizeof(m_dCollected[0]) );
+	std::sort ( m_dUniques.begin(), m_dUniques.end() );
+	m_dUniques.erase ( std::unique ( m_dUniques.begin(), m_dUniques.end() ), m_dUniques.end() );
+
+	int64_t iNumValues = (int64_t)m_dCollected.size();
+	int64_t iNumEmpty = std::count ( m_dCollected.begin(), m_dCollected.end(), T(0) );
+	int64_t iRawBits = ( iNumValues-iNumEmpty )*64 + ( iNumEmpty ? iNumValues : 0 );
+	int64_t iTableBits = (int64_t)m_dUniques.size()*64 + CalcNumBits ( m_dUniques.size()-1 )*iNumValues;
+	if ( iTableBits>=iRawBits )
+		return false;
+
+	m_dHashOrdinals.resize(0);
+	for ( auto i : m_dCollected )
+		m_dHashOrdinals.push_back ( uint32_t ( std::lower_bound ( m_dUniques.begin(), m_dUniques.end(), i ) - m_dUniques.begin() ) );
+
+	return true;
+}
+
+template <typename T, typename HEADER>
+void Packer_Int_T<T,HEADER>::WriteOrdinals ( const std::vector<uint32_t> & dOrdinals, int iBits )
+{
+	m_tWriter.Write_uint8 ( (uint8_t)iBits );
+
+	// ordinals are stored the same way as table ordinals: bitpacked subblocks of fixed size
+	size_t tSubblockSize = m_dTableIndexes.size();
+	m_dTablePacked.resize ( ( tSubblockSize*iBits + 31 ) >> 5 );
+	for ( size_t tStart = 0; tStart < dOrdinals.size(); tStart += tSubblockSize )
+	{
+		size_t tValues = std::min ( tSubblockSize, dOrdinals.size()-tStart );
+		memcpy ( m_dTableIndexes.data(), &dOrdinals[tStart], tValues*sizeof(dOrdinals[0]) );
+		if ( tValues<tSubblockSize )
+			memset ( m_dTableIndexes.data()+tValues, 0, (tSubblockSize-tValues)*sizeof(m_dTableIndexes[0]) );
+
+		BitPack ( m_dTableIndexes, m_dTablePacked, iBits );
+		m_tWriter.Write ( (uint8_t*)m_dTablePacked.data(), m_dTablePacked.size()*sizeof(m_dTablePacked[0]) );
+	}
+}
+
 template <typename T, typename HEADER>
 template <typename U, typename WRITER>
 void Packer_Int_T<T,HEADER>::WriteSubblock_Delta ( const Span_T<U> & dSubblockValues, WRITER & tWriter, std::vector<U> & dTmp, bool bWriteFlag )
@@ -339,6 +835,30 @@ void Packer_Int_T<T,HEADER>::WriteSubblock_Delta ( const Span_T<U> & dSubblockVa
 	tWriter.Write ( (uint8_t*)m_dCompressed.data(), m_dCompressed.size()*sizeof ( m_dCompressed[0] ) );
 }
 
+template <typename T, typename HEADER>
+void Packer_Int_T<T,HEADER>::WriteSubblock_DeltaDelta ( const Span_T<T> & dSubblockValues, MemWriter_c & tWriter )
+{
+	tWriter.Write_uint8 ( IsSubblockSorted(dSubblockValues) ? DELTA_DELTA_SORTED : 0 );
+
+	size_t tLength = dSubblockValues.size();
+	m_dUncompressed.resize(tLength);
+	memcpy ( m_dUncompressed.data(), dSubblockValues.data(), tLength*sizeof(dSubblockValues[0]) );
+
+	// deltas of deltas; the first value goes to the subblock header
+	ComputeDeltas ( m_dUncompressed.data(), (int)tLength, true );
+	if ( tLength>1 )
+	{
+		ComputeDeltas ( m_dUncompressed.data()+1, int(tLength-1), true );
+		ZigzagEncode ( m_dUncompressed.data()+1, tLength-1 );
+	}
+
+	tWriter.Pack_uint64 ( m_dUncompressed[0] );
+	m_dUncompressed[0] = 0;
+
+	m_pCodec->Encode ( m_dUncompressed, m_dCompressed );
+	tWriter.Write ( (uint8_t*)m_dCompressed.data(), m_dCompressed.size()*sizeof ( m_dCompressed[0] ) );
+}
+
 template <typename T, typename HEADER>
 template <typename U>
 bool Packer_Int_T<T,HEADER>::WriteNullMap ( const Span_T<U> & dSubblockValues, MemWriter_c & tWriter )
@@ -382,7 +902,6 @@ void Packer_Int_T<T,HEADER>::WriteSubblock_Hash ( const Span_T<U> & dSubblockVal
 {
 	bool bHaveNullMap = WriteNullMap ( dSubblockValues, tWriter );
 
-	// fixme: maybe try compressing the hashes?
 	for ( const auto i : dSubblockValues )
 		if ( !bHaveNullMap || i ) // skip empty hashes if we have a null map
 			tWriter.Write_uint64(i);
@@ -437,8 +956,168 @@ class Packer_Float_c : public Packer_Int_T<uint32_t, AttributeHeaderBuilder_Floa
 
 public:
 	Packer_Float_c ( const Settings_t & tSettings, const std::string & sName ) : BASE ( tSettings, sName, AttrType_e::FLOAT ) {}
+
+protected:
+	IntPacking_e		ChoosePacking() override;
+	void				WriteToFile ( IntPacking_e ePacking ) override;
+
+private:
+	int					m_iExponent = 0;
+	int64_t				m_iDecimalMin = 0;
+	int					m_iDecimalBits = 0;
+	std::vector<int64_t> m_dDecimals;
+	std::vector<uint32_t> m_dExceptions;
+	std::vector<uint64_t> m_dDecimalsPacked;
+
+	int64_t				EstimateDecimalBits ( int iExponent ) const;
+	int64_t				EncodeDecimals();
+	void				WritePacked_Decimal();
 };
 
+// fractional part of most real-world floats is a few decimal digits; such floats are stored (ALP-style)
+// as integers scaled by 10^exponent, packed FOR-style; values that don't survive the round trip are stored as exceptions
+static bool FloatToDecimal ( uint32_t uValue, int iExponent, int64_t & iDecimal )
+{
+	const double MAX_DECIMAL = double ( 1ULL << 52 );
+
+	// powers of 10 up to 10^22 are exact doubles
+	double dPow10 = 1.0;
+	for ( int i = 0; i < iExponent; i++ )
+		dPow10 *= 10.0;
+
+	double dScaled = double ( UintToFloat(uValue) )*dPow10;
+
+	// also filters out NaNs
+	if ( !( std::fabs(dScaled) < MAX_DECIMAL ) )
+		return false;
+
+	iDecimal = (int64_t)std::llround(dScaled);
+	return FloatToUint ( DecimalToFloat ( iDecimal, iExponent ) )==uValue;
+}
+
+// an exception costs its position and its raw value
+static const int DECIMAL_EXCEPTION_BITS = 48;
+
+
+int64_t Packer_Float_c::EstimateDecimalBits ( int iExponent ) const
+{
+	// estimate on a sample, that's enough to pick the exponent
+	const size_t MAX_SAMPLES = 1024;
+	size_t tStep = std::max ( (size_t)1, m_dCollected.size()/MAX_SAMPLES );
+
+	int64_t iMin = INT64_MAX;
+	int64_t iMax = INT64_MIN;
+	int64_t iSamples = 0;
+	int64_t iExceptions = 0;
+	for ( size_t i = 0; i < m_dCollected.size(); i += tStep )
+	{
+		iSamples++;
+		int64_t iDecimal = 0;
+		if ( FloatToDecimal ( m_dCollected[i], iExponent, iDecimal ) )
+		{
+			iMin = std::min ( iMin, iDecimal );
+			iMax = std::max ( iMax, iDecimal );
+		}
+		else
+			iExceptions++;
+	}
+
+	int iBits = iMin<=iMax ? CalcNumBits ( uint64_t ( iMax-iMin ) ) : 0;
+	return ( int64_t(iBits)*iSamples + iExceptions*DECIMAL_EXCEPTION_BITS ) * int64_t ( m_dCollected.size() ) / iSamples;
+}
+
+
+int64_t Packer_Float_c::EncodeDecimals()
+{
+	m_iExponent = 0;
+	int64_t iBest = INT64_MAX;
+	for ( int i = 0; i<=MAX_DECIMAL_EXPONENT; i++ )
+	{
+		int64_t iBits = EstimateDecimalBits(i);
+		if ( iBits < iBest )
+		{
+			iBest = iBits;
+			m_iExponent = i;
+		}
+	}
+
+	m_dDecimals.resize ( m_dCollected.size() );
+	m_dExceptions.resize(0);
+	int64_t iMin = INT64_MAX;
+	int64_t iMax = INT64_MIN;
+	for ( size_t i = 0; i < m_dCollected.size(); i++ )
+	{
+		int64_t & iDecimal = m_dDecimals[i];
+		if ( FloatToDecimal ( m_dCollected[i], m_iExponent, iDecimal ) )
+		{
+			iMin = std::min ( iMin, iDecimal );
+			iMax = std::max ( iMax, iDecimal );
+		}
+		else
+			m_dExceptions.push_back ( (uint32_t)i );
+	}
+
+	if ( iMin>iMax )
+		iMin = iMax = 0;
+
+	// exceptions get a placeholder value that doesn't widen the range
+	for ( auto i : m_dExceptions )
+		m_dDecimals[i] = iMin;
+
+	m_iDecimalMin = iMin;
+	m_iDecimalBits = CalcNumBits ( uint64_t ( iMax-iMin ) );
+	return int64_t(m_iDecimalBits)*m_dDecimals.size() + int64_t ( m_dExceptions.size() )*DECIMAL_EXCEPTION_BITS;
+}
+
+
+IntPacking_e Packer_Float_c::ChoosePacking()
+{
+	IntPacking_e ePacking = BASE::ChoosePacking();
+	if ( ePacking==IntPacking_e::CONST || ePacking==IntPacking_e::TABLE || ePacking==IntPacking_e::DICT || ePacking==IntPacking_e::RLE )
+		return ePacking;
+
+	// raw float bits are poorly compressible; compare against plain FOR over them
+	int64_t iFORBits = int64_t ( CalcNumBits ( m_tMax-m_tMin ) )*m_dCollected.size();
+	return EncodeDecimals() < iFORBits ? IntPacking_e::DECIMAL : ePacking;
+}
+
+
+void Packer_Float_c::WriteToFile ( IntPacking_e ePacking )
+{
+	if ( ePacking!=IntPacking_e::DECIMAL )
+	{
+		BASE::WriteToFile(ePacking);
+		return;
+	}
+
+	m_tWriter.Pack_uint32 ( to_underlying(ePacking) );
+	WritePacked_Decimal();
+}
+
+
+void Packer_Float_c::WritePacked_Decimal()
+{
+	m_tWriter.Write_uint8 ( (uint8_t)m_iExponent );
+
+	// exceptions: delta-encoded row ids and raw values
+	m_tWriter.Pack_uint32 ( (uint32_t)m_dExceptions.size() );
+	uint32_t uPrev = 0;
+	for ( auto i : m_dExceptions )
+	{
+		m_tWriter.Pack_uint32 ( i-uPrev );
+		uPrev = i;
+	}
+
+	for ( auto i : m_dExceptions )
+		m_tWriter.Write_uint32 ( m_dCollected[i] );
+
+	// the rest is laid out the same way as FOR packing
+	m_tWriter.Pack_uint64 ( (uint64_t)m_iDecimalMin );
+	m_tWriter.Write_uint8 ( (uint8_t)m_iDecimalBits );
+	PackFOR ( Span_T<int64_t>(m_dDecimals), m_iDecimalMin, m_iDecimalBits, m_dDecimalsPacked );
+	m_tWriter.Write ( (uint8_t*)m_dDecimalsPacked.data(), m_dDecimalsPacked.size()*sizeof ( m_dDecimalsPacked[0] ) );
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 class Packer_Hash_c : public Packer_Int_T<uint64_t,AttributeHeaderBuilder_Int_T<uint64_t>>
@@ -450,6 +1129,8 @@ public:
 
 	void	AddDoc ( int64_t tAttr ) override { assert ( 0 && "INTERNAL ERROR: sending int to string hash packer" ); }
 	void	AddDoc ( const uint8_t * pData, int iLength ) override;
+	void	AddDocs ( const Span_T<int64_t> & dValues ) override { assert ( 0 && "INTERNAL ERROR: sending int to string hash packer" ); }
+	void	AddDocs ( const Span_T<int64_t> & dOffsets, const uint8_t * pData ) override;
 
 private:
 	StringHash_fn m_fnCalcHash = nullptr;
@@ -462,6 +1143,7 @@ Packer_Hash_c::Packer_Hash_c ( const Settings_t & tSettings, const std::string &
 {
 	assert(fnCalcHash);
 	OverridePacking ( IntPacking_e::GENERIC, IntPacking_e::HASH );
+	OverridePacking ( IntPacking_e::FOR, IntPacking_e::HASH );
 }
 
 
@@ -470,29 +1152,55 @@ void Packer_Hash_c::AddDoc ( const uint8_t * pData, int iLength )
 	BASE::AddDoc ( iLength ? m_fnCalcHash ( pData, iLength, STR_HASH_SEED ) : 0 );
 }
 
+
+void Packer_Hash_c::AddDocs ( const Span_T<int64_t> & dOffsets, const uint8_t * pData )
+{
+	for ( size_t i = 1; i < dOffsets.size(); i++ )
+	{
+		int iLength = int ( dOffsets[i]-dOffsets[i-1] );
+		BASE::AddDoc ( iLength ? m_fnCalcHash ( pData+dOffsets[i-1], iLength, STR_HASH_SEED ) : 0 );
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////
 
-Packer_i * CreatePackerUint32 ( const Settings_t & tSettings, const std::string & sName )
+Packer_i * CreatePackerUint32 ( const Settings_t & tSettings, const std::string & sName, bool bBloomFilter )
 {
-	return new Packer_Int_T<uint32_t,AttributeHeaderBuilder_Int_T<uint32_t>> ( tSettings, sName, AttrType_e::UINT32 );
+	auto pPacker = new Packer_Int_T<uint32_t,AttributeHeaderBuilder_Int_T<uint32_t>> ( tSettings, sName, AttrType_e::UINT32 );
+	if ( bBloomFilter )
+		pPacker->EnableBloomFilter();
+
+	return pPacker;
 }
 
 
-Packer_i * CreatePackerInt64 ( const Settings_t & tSettings, const std::string & sName )
+Packer_i * CreatePackerInt64 ( const Settings_t & tSettings, const std::string & sName, bool bBloomFilter )
 {
-	return new Packer_Int_T<uint64_t,AttributeHeaderBuilder_Int_T<int64_t>> ( tSettings, sName, AttrType_e::INT64 );
+	auto pPacker = new Packer_Int_T<uint64_t,AttributeHeaderBuilder_Int_T<int64_t>> ( tSettings, sName, AttrType_e::INT64 );
+	if ( bBloomFilter )
+		pPacker->EnableBloomFilter();
+
+	return pPacker;
 }
 
 
-Packer_i * CreatePackerHash ( const Settings_t & tSettings, const std::string & sName, StringHash_fn fnCalcHash )
+Packer_i * CreatePackerHash ( const Settings_t & tSettings, const std::string & sName, StringHash_fn fnCalcHash, bool bBloomFilter )
 {
-	return new Packer_Hash_c ( tSettings, sName, fnCalcHash );
+	auto pPacker = new Packer_Hash_c ( tSettings, sName, fnCalcHash );
+	if ( bBloomFilter )
+		pPacker->EnableBloomFilter();
+
+	return pPacker;
 }
 
 
-Packer_i * CreatePackerFloat ( const Settings_t & tSettings, const std::string & sName )
+Packer_i * CreatePackerFloat ( const Settings_t & tSettings, const std::string & sName, bool bBloomFilter )
 {
-	return new Packer_Float_c ( tSettings, sName );
+	auto pPacker = new Packer_Float_c ( tSettings, sName );
+	if ( bBloomFilter )
+		pPacker->EnableBloomFilter();
+
+	return pPacker;
 }
 
 } // namespace columnar
\ No newline at end of file
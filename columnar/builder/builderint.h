@@ -28,6 +28,13 @@ enum class IntDeltaPacking_e : uint8_t
 };
 
 
+enum class IntHashPacking_e : uint8_t
+{
+	RAW,
+	TABLE
+};
+
+
 enum class IntPacking_e : uint32_t
 {
 	CONST,
@@ -35,16 +42,30 @@ enum class IntPacking_e : uint32_t
 	DELTA,
 	GENERIC,
 	HASH,
+	FOR,
+	DICT,
+	DECIMAL,
+	DELTA_DELTA,
+	RLE,
 
 	TOTAL
 };
 
+// delta-of-delta subblock flags
+static const uint8_t DELTA_DELTA_SORTED = 1;	// subblock values are sorted (in attribute value order)
+
+// max number of values in attribute-level dictionary
+static const int MAX_DICTIONARY_SIZE = 65536;
+
+// dictionary packing is turned off after this many consecutive blocks that can't use it
+static const int MAX_DICT_FAILURES = 4;
+
 class Packer_i;
 struct Settings_t;
 
-Packer_i * CreatePackerUint32 ( const Settings_t & tSettings, const std::string & sName );
-Packer_i * CreatePackerInt64 ( const Settings_t & tSettings, const std::string & sName );
-Packer_i * CreatePackerHash ( const Settings_t & tSettings, const std::string & sName, common::StringHash_fn fnCalcHash );
-Packer_i * CreatePackerFloat ( const Settings_t & tSettings, const std::string & sName );
+Packer_i * CreatePackerUint32 ( const Settings_t & tSettings, const std::string & sName, bool bBloomFilter );
+Packer_i * CreatePackerInt64 ( const Settings_t & tSettings, const std::string & sName, bool bBloomFilter );
+Packer_i * CreatePackerHash ( const Settings_t & tSettings, const std::string & sName, common::StringHash_fn fnCalcHash, bool bBloomFilter );
+Packer_i * CreatePackerFloat ( const Settings_t & tSettings, const std::string & sName, bool bBloomFilter );
 
 } // namespace columnar
@@ -174,7 +174,14 @@ bool MinMaxBuilder_T<T>::Save ( util::FileWriter_c & tWriter, std::string & sErr
 	for ( int i = (int)m_dTreeLevels.size()-1; i>=0; i-- )
 		tWriter.Pack_uint32 ( (uint32_t)m_dTreeLevels[i].size() );
 
-	return SaveTreeLevels(tWriter);
+	// tree size goes first so that the reader can skip the tree and load it later
+	int64_t iSizePos = tWriter.GetPos();
+	tWriter.Write_uint64(0);
+	if ( !SaveTreeLevels(tWriter) )
+		return false;
+
+	tWriter.SeekAndWrite ( iSizePos, uint64_t ( tWriter.GetPos()-iSizePos-sizeof(uint64_t) ) );
+	return !tWriter.IsError();
 }
 
 template<typename T>
@@ -26,6 +26,19 @@ namespace columnar
 using namespace util;
 using namespace common;
 
+static const char * GetPackingName ( MvaPacking_e ePacking )
+{
+	switch ( ePacking )
+	{
+	case MvaPacking_e::CONST:		return "const";
+	case MvaPacking_e::CONSTLEN:	return "constlen";
+	case MvaPacking_e::TABLE:		return "table";
+	case MvaPacking_e::DELTA_PFOR:	return "deltapfor";
+	case MvaPacking_e::RLE:			return "rle";
+	default:						return "unknown";
+	}
+}
+
 
 template <typename T>
 class AttributeHeaderBuilder_MVA_T : public AttributeHeaderBuilder_c
@@ -37,7 +50,7 @@ public:
 
 			AttributeHeaderBuilder_MVA_T ( const Settings_t & tSettings, const std::string & sName, AttrType_e eType );
 
-	bool	Save ( FileWriter_c & tWriter, int64_t & tBaseOffset, std::string & sError );
+	bool	Save ( FileWriter_c & tWriter, std::string & sError );
 };
 
 template <typename T>
@@ -47,9 +60,9 @@ AttributeHeaderBuilder_MVA_T<T>::AttributeHeaderBuilder_MVA_T ( const Settings_t
 {}
 
 template <typename T>
-bool AttributeHeaderBuilder_MVA_T<T>::Save ( FileWriter_c & tWriter, int64_t & tBaseOffset, std::string & sError )
+bool AttributeHeaderBuilder_MVA_T<T>::Save ( FileWriter_c & tWriter, std::string & sError )
 {
-	if ( !BASE::Save ( tWriter, tBaseOffset, sError ) )
+	if ( !BASE::Save ( tWriter, sError ) )
 		return false;
 
 	return m_tMinMax.Save ( tWriter, sError );
@@ -83,6 +96,7 @@ protected:
 	void			AddDoc ( int64_t tAttr ) final						{ assert ( 0 && "INTERNAL ERROR: sending integers to MVA packer" ); }
 	void			AddDoc ( const uint8_t * pData, int iLength ) final	{ assert ( 0 && "INTERNAL ERROR: sending strings to MVA packer" ); }
 	void			AddDoc ( const int64_t * pData, int iLength ) final;
+	void			AddDocs ( const Span_T<int64_t> & dOffsets, const int64_t * pData ) final;
 	void			Flush() final;
 
 	void			AnalyzeCollected ( const int64_t * pData, int iLength );
@@ -108,14 +122,19 @@ private:
 	std::vector<uint32_t>		m_dTableIndexes;
 	std::vector<uint32_t>		m_dTablePacked;
 
+	// temp arrays for rle encoding
+	std::vector<uint32_t>		m_dRunEnds;
+
 	std::unordered_map<std::vector<T>, int, HashFunc_Vec_T<T>> m_hUnique;
 	int				m_iUniques = 0;
 	int				m_iConstLength = -1;
+	int				m_iRuns = 0;
 
 	void			WritePacked_Const();
 	void			WritePacked_ConstLen();
 	void			WritePacked_Table();
 	void			WritePacked_DeltaPFOR ( bool bWriteLengths );
+	void			WritePacked_RLE();
 
 	void			WriteSubblockSizes();
 	void			PrepareValues ( Span_T<T> & dValues, const Span_T<uint32_t> & dLengths );
@@ -145,6 +164,31 @@ void Packer_MVA_T<T,HEADER_T>::AddDoc ( const int64_t * pData, int iLength )
 	BASE::m_tHeader.m_tMinMax.Add ( pData, iLength );
 }
 
+template <typename T, typename HEADER_T>
+void Packer_MVA_T<T,HEADER_T>::AddDocs ( const Span_T<int64_t> & dOffsets, const int64_t * pData )
+{
+	size_t tDoc = 1;
+	while ( tDoc < dOffsets.size() )
+	{
+		if ( m_dCollectedLengths.size()==DOCS_PER_BLOCK )
+			Flush();
+
+		size_t tChunkEnd = std::min ( dOffsets.size(), tDoc + DOCS_PER_BLOCK - m_dCollectedLengths.size() );
+		for ( ; tDoc < tChunkEnd; tDoc++ )
+		{
+			const int64_t * pValues = pData + dOffsets[tDoc-1];
+			int iLength = int ( dOffsets[tDoc]-dOffsets[tDoc-1] );
+			AnalyzeCollected ( pValues, iLength );
+
+			m_dCollectedLengths.push_back(iLength);
+			for ( int i = 0; i < iLength; i++ )
+				m_dCollectedValues.push_back ( to_type<T> ( pValues[i] ) );
+
+			BASE::m_tHeader.m_tMinMax.Add ( pValues, iLength );
+		}
+	}
+}
+
 template <typename T, typename HEADER_T>
 void Packer_MVA_T<T,HEADER_T>::AnalyzeCollected ( const int64_t * pData, int iLength )
 {
@@ -154,6 +198,17 @@ void Packer_MVA_T<T,HEADER_T>::AnalyzeCollected ( const int64_t * pData, int iLe
 	if ( iLength!=m_iConstLength )
 		m_iConstLength = -1;
 
+	bool bNewRun = m_dCollectedLengths.empty() || m_dCollectedLengths.back()!=(uint32_t)iLength;
+	if ( !bNewRun )
+	{
+		const T * pPrev = m_dCollectedValues.data() + m_dCollectedValues.size() - iLength;
+		for ( int i = 0; i < iLength && !bNewRun; i++ )
+			bNewRun = pPrev[i]!=to_type<T> ( pData[i] );
+	}
+
+	if ( bNewRun )
+		m_iRuns++;
+
 	// if we've got over 256 uniques, no point in further checks
 	if ( m_iUniques<256 )
 	{
@@ -175,8 +230,16 @@ MvaPacking_e Packer_MVA_T<T,HEADER_T>::ChoosePacking() const
 	if ( m_iUniques==1 )
 		return MvaPacking_e::CONST;
 
+	// each run stores its value once (plus its length and run end); use raw value size as a rough estimate of a stored value
+	int64_t iNumDocs = (int64_t)m_dCollectedLengths.size();
+	int64_t iAvgBits = int64_t ( m_dCollectedValues.size()*sizeof(T)*8 ) / iNumDocs;
+	int64_t iRLEBits = int64_t(m_iRuns)*( iAvgBits + RLE_RUN_BITS );
+
 	if ( m_iUniques<256 )
-		return MvaPacking_e::TABLE;
+		return iRLEBits < CalcNumBits(m_iUniques)*iNumDocs ? MvaPacking_e::RLE : MvaPacking_e::TABLE;
+
+	if ( iRLEBits < iAvgBits*iNumDocs )
+		return MvaPacking_e::RLE;
 
 	if ( m_iConstLength!=-1 )
 		return MvaPacking_e::CONSTLEN;
@@ -190,15 +253,17 @@ void Packer_MVA_T<T,HEADER_T>::Flush()
 	if ( m_dCollectedLengths.empty() )
 		return;
 
-	BASE::m_tHeader.AddBlock ( BASE::m_tWriter.GetPos() );
-
-	WriteToFile ( ChoosePacking() );
+	MvaPacking_e ePacking = ChoosePacking();
+	WriteToFile(ePacking);
+	BASE::CountPackedBlock ( to_underlying(ePacking), GetPackingName(ePacking) );
+	BASE::WriteBlock();
 
 	m_dCollectedLengths.resize(0);
 	m_dCollectedValues.resize(0);
 
 	m_iConstLength = -1;
 	m_iUniques = 0;
+	m_iRuns = 0;
 	m_hUnique.clear();
 }
 
@@ -225,6 +290,10 @@ void Packer_MVA_T<T,HEADER_T>::WriteToFile ( MvaPacking_e ePacking )
 		WritePacked_DeltaPFOR(true);
 		break;
 
+	case MvaPacking_e::RLE:
+		WritePacked_RLE();
+		break;
+
 	default:
 		assert ( 0 && "Unknown packing" );
 		break;
@@ -360,6 +429,43 @@ void Packer_MVA_T<T,HEADER_T>::WritePacked_DeltaPFOR ( bool bWriteLengths )
 	BASE::m_tWriter.Write ( m_dTmpBuffer.data(), m_dTmpBuffer.size()*sizeof ( m_dTmpBuffer[0] ) );
 }
 
+template <typename T, typename HEADER_T>
+void Packer_MVA_T<T,HEADER_T>::WritePacked_RLE()
+{
+	m_dRunEnds.resize(0);
+	m_dTableLengths.resize(0);
+	m_dTableValues.resize(0);
+
+	uint32_t uOffset = 0;
+	uint32_t uPrevOffset = 0;
+	for ( size_t i = 0; i < m_dCollectedLengths.size(); i++ )
+	{
+		uint32_t uLength = m_dCollectedLengths[i];
+		bool bNewRun = !i || uLength!=m_dCollectedLengths[i-1] || memcmp ( m_dCollectedValues.data()+uPrevOffset, m_dCollectedValues.data()+uOffset, uLength*sizeof(T) );
+		if ( bNewRun )
+		{
+			if ( i )
+				m_dRunEnds.push_back ( (uint32_t)i );
+
+			m_dTableLengths.push_back(uLength);
+			m_dTableValues.insert ( m_dTableValues.end(), m_dCollectedValues.begin()+uOffset, m_dCollectedValues.begin()+uOffset+uLength );
+		}
+
+		uPrevOffset = uOffset;
+		uOffset += uLength;
+	}
+
+	m_dRunEnds.push_back ( (uint32_t)m_dCollectedLengths.size() );
+
+	// exclusive run ends (relative to block start), then run values stored the same way as table values
+	WriteValues_Delta_PFOR ( Span_T<uint32_t>(m_dRunEnds), m_dUncompressed32, m_dCompressed, BASE::m_tWriter, m_pCodec.get() );
+	WriteValues_PFOR ( Span_T<uint32_t>(m_dTableLengths), m_dUncompressed32, m_dCompressed, BASE::m_tWriter, m_pCodec.get(), true );
+
+	Span_T<T> dRunValues ( m_dTableValues );
+	PrepareValues ( dRunValues, m_dTableLengths );
+	WriteValues_PFOR ( dRunValues, m_dUncompressed, m_dCompressed, BASE::m_tWriter, m_pCodec.get(), true );
+}
+
 template <typename T, typename HEADER_T>
 void Packer_MVA_T<T,HEADER_T>::PrepareValues ( Span_T<T> & dValues, const Span_T<uint32_t> & dLengths )
 {
@@ -27,6 +27,7 @@ enum class MvaPacking_e : uint32_t
 	CONSTLEN,
 	TABLE,
 	DELTA_PFOR,
+	RLE,
 
 	TOTAL
 };
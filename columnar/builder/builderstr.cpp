@@ -28,6 +28,19 @@ namespace columnar
 using namespace util;
 using namespace common;
 
+static const char * GetPackingName ( StrPacking_e ePacking )
+{
+	switch ( ePacking )
+	{
+	case StrPacking_e::CONST:		return "const";
+	case StrPacking_e::CONSTLEN:	return "constlen";
+	case StrPacking_e::TABLE:		return "table";
+	case StrPacking_e::GENERIC:		return "generic";
+	case StrPacking_e::RLE:			return "rle";
+	default:						return "unknown";
+	}
+}
+
 
 class AttributeHeaderBuilder_String_c : public AttributeHeaderBuilder_c
 {
@@ -38,7 +51,7 @@ public:
 
 			AttributeHeaderBuilder_String_c ( const Settings_t & tSettings, const std::string & sName, AttrType_e eType );
 
-	bool	Save ( FileWriter_c & tWriter, int64_t & tBaseOffset, std::string & sError );
+	bool	Save ( FileWriter_c & tWriter, std::string & sError );
 };
 
 
@@ -48,9 +61,9 @@ AttributeHeaderBuilder_String_c::AttributeHeaderBuilder_String_c ( const Setting
 {}
 
 
-bool AttributeHeaderBuilder_String_c::Save ( FileWriter_c & tWriter, int64_t & tBaseOffset, std::string & sError )
+bool AttributeHeaderBuilder_String_c::Save ( FileWriter_c & tWriter, std::string & sError )
 {
-	if ( !BASE::Save ( tWriter, tBaseOffset, sError ) )
+	if ( !BASE::Save ( tWriter, sError ) )
 		return false;
 
 	if ( !m_tMinMax.Save ( tWriter, sError ) )
@@ -70,6 +83,7 @@ public:
 	void					AddDoc ( int64_t tAttr ) final;
 	void					AddDoc ( const uint8_t * pData, int iLength ) final;
 	void					AddDoc ( const int64_t * pData, int iLength ) final;
+	void					AddDocs ( const Span_T<int64_t> & dOffsets, const uint8_t * pData ) final;
 
 protected:
 	std::unique_ptr<IntCodec_i>	m_pCodec;
@@ -83,12 +97,17 @@ protected:
 	std::vector<uint32_t>	m_dTableLengths;
 	std::vector<uint32_t>	m_dTableIndexes;
 
+	// used by rle encoding
+	std::vector<uint32_t>	m_dRunEnds;
+
 	std::vector<uint32_t>	m_dUncompressed32;
 	std::vector<uint64_t>	m_dUncompressed;
 	std::vector<uint32_t>	m_dCompressed;
 
 	int						m_iUniques = 0;
 	int						m_iConstLength = -1;
+	int						m_iRuns = 0;
+	int64_t					m_iTotalLength = 0;
 
 	std::vector<uint8_t>	m_dTmpBuffer;
 	std::vector<uint8_t>	m_dTmpBuffer2;
@@ -103,6 +122,7 @@ protected:
 	void					WritePacked_ConstLen();
 	void					WritePacked_Table();
 	void					WritePacked_Generic();
+	void					WritePacked_RLE();
 
 	void					WriteOffsets();
 };
@@ -138,20 +158,43 @@ void Packer_String_c::AddDoc ( const int64_t * pData, int iLength )
 }
 
 
+void Packer_String_c::AddDocs ( const Span_T<int64_t> & dOffsets, const uint8_t * pData )
+{
+	size_t tDoc = 1;
+	while ( tDoc < dOffsets.size() )
+	{
+		if ( m_dCollected.size()==DOCS_PER_BLOCK )
+			Flush();
+
+		size_t tChunkEnd = std::min ( dOffsets.size(), tDoc + DOCS_PER_BLOCK - m_dCollected.size() );
+		for ( ; tDoc < tChunkEnd; tDoc++ )
+		{
+			const uint8_t * pStr = pData + dOffsets[tDoc-1];
+			int iLength = int ( dOffsets[tDoc]-dOffsets[tDoc-1] );
+			AnalyzeCollected ( pStr, iLength );
+			m_dCollected.emplace_back ( (const char*)pStr, iLength );
+		}
+	}
+}
+
+
 void Packer_String_c::Flush()
 {
 	if ( m_dCollected.empty() )
 		return;
 
-	m_tHeader.AddBlock ( m_tWriter.GetPos() );
-
-	WriteToFile ( ChoosePacking() );
+	StrPacking_e ePacking = ChoosePacking();
+	WriteToFile(ePacking);
+	CountPackedBlock ( to_underlying(ePacking), GetPackingName(ePacking) );
+	WriteBlock();
 
 	m_dCollected.resize(0);
 
 	m_iUniques = 0;
 	m_hUnique.clear();
 	m_iConstLength = -1;
+	m_iRuns = 0;
+	m_iTotalLength = 0;
 }
 
 
@@ -163,6 +206,11 @@ void Packer_String_c::AnalyzeCollected ( const uint8_t * pData, int iLength )
 	if ( iLength!=m_iConstLength )
 		m_iConstLength = -1;
 
+	if ( m_dCollected.empty() || m_dCollected.back().length()!=(size_t)iLength || memcmp ( m_dCollected.back().data(), pData, iLength ) )
+		m_iRuns++;
+
+	m_iTotalLength += iLength;
+
 	// if we've got over 256 uniques, no point in further checks
 	if ( m_iUniques<256 )
 	{
@@ -184,8 +232,15 @@ StrPacking_e Packer_String_c::ChoosePacking() const
 	if ( m_iUniques==1 )
 		return StrPacking_e::CONST;
 
+	// each run stores its value once (plus its length and run end)
+	int64_t iNumValues = (int64_t)m_dCollected.size();
+	int64_t iRLEBits = int64_t(m_iRuns)*( m_iTotalLength*8/iNumValues + RLE_RUN_BITS );
+
 	if ( m_iUniques<256 )
-		return StrPacking_e::TABLE;
+		return iRLEBits < CalcNumBits(m_iUniques)*iNumValues ? StrPacking_e::RLE : StrPacking_e::TABLE;
+
+	if ( iRLEBits < m_iTotalLength*8 )
+		return StrPacking_e::RLE;
 
 	if ( m_iConstLength!=-1 )
 		return StrPacking_e::CONSTLEN;
@@ -216,6 +271,10 @@ void Packer_String_c::WriteToFile ( StrPacking_e ePacking )
 		WritePacked_Generic();
 		break;
 
+	case StrPacking_e::RLE:
+		WritePacked_RLE();
+		break;
+
 	default:
 		assert ( 0 && "Unknown packing" );
 		break;
@@ -313,6 +372,34 @@ void Packer_String_c::WritePacked_Generic()
 }
 
 
+void Packer_String_c::WritePacked_RLE()
+{
+	m_dRunEnds.resize(0);
+	m_dTableLengths.resize(0);
+	for ( size_t i = 1; i < m_dCollected.size(); i++ )
+		if ( m_dCollected[i]!=m_dCollected[i-1] )
+		{
+			m_dRunEnds.push_back ( (uint32_t)i );
+			m_dTableLengths.push_back ( (uint32_t)m_dCollected[i-1].length() );
+		}
+
+	m_dRunEnds.push_back ( (uint32_t)m_dCollected.size() );
+	m_dTableLengths.push_back ( (uint32_t)m_dCollected.back().length() );
+
+	// exclusive run ends (relative to block start), then lengths and bodies of run values
+	WriteValues_Delta_PFOR ( Span_T<uint32_t>(m_dRunEnds), m_dUncompressed32, m_dCompressed, m_tWriter, m_pCodec.get() );
+	WriteValues_PFOR ( Span_T<uint32_t>(m_dTableLengths), m_dUncompressed32, m_dCompressed, m_tWriter, m_pCodec.get(), true );
+
+	uint32_t uRunStart = 0;
+	for ( auto i : m_dRunEnds )
+	{
+		const std::string & sValue = m_dCollected[uRunStart];
+		m_tWriter.Write ( (const uint8_t*)sValue.c_str(), sValue.length() );
+		uRunStart = i;
+	}
+}
+
+
 void Packer_String_c::WriteOffsets()
 {
 	assert ( !m_dOffsets[0] );
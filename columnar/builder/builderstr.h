@@ -27,6 +27,7 @@ enum class StrPacking_e : uint32_t
 	CONSTLEN,
 	TABLE,
 	GENERIC,
+	RLE,
 
 	TOTAL
 };
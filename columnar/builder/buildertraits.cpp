@@ -30,18 +30,16 @@ AttributeHeaderBuilder_c::AttributeHeaderBuilder_c ( const Settings_t & tSetting
 {}
 
 
-bool AttributeHeaderBuilder_c::Save ( FileWriter_c & tWriter, int64_t & tBaseOffset, std::string & sError )
+bool AttributeHeaderBuilder_c::Save ( FileWriter_c & tWriter, std::string & sError )
 {
 	m_tSettings.Save(tWriter);
 
 	tWriter.Write_string(m_sName);
 
-	// store base offset to correct it later
-	tBaseOffset = tWriter.GetPos();
-
-	tWriter.Write_uint64 ( 0 ); // stub
+	// blocks are already written, so we store absolute offsets
+	int64_t tPrevOffset = m_dBlocks.empty() ? 0 : m_dBlocks[0];
+	tWriter.Write_uint64 ( tPrevOffset );
 	tWriter.Pack_uint32 ( (uint32_t)m_dBlocks.size() );
-	int64_t tPrevOffset = 0;
 
 	// no offset for 1st block
 	for ( size_t i=1; i < m_dBlocks.size(); i++ )
@@ -50,7 +48,27 @@ bool AttributeHeaderBuilder_c::Save ( FileWriter_c & tWriter, int64_t & tBaseOff
 		tPrevOffset = m_dBlocks[i];
 	}
 
+	for ( auto i : m_dBlockSizes )
+		tWriter.Pack_uint64(i);
+
 	return !tWriter.IsError();
 }
 
+//////////////////////////////////////////////////////////////////////////
+
+bool BlockWriter_c::Open ( const std::string & sFile, std::string & sError )
+{
+	return m_tWriter.Open ( sFile, sError );
+}
+
+
+int64_t BlockWriter_c::WriteBlock ( const std::vector<uint8_t> & dData )
+{
+	// blocks may be flushed from several threads
+	std::unique_lock<std::mutex> tLock(m_tLock);
+	int64_t iOffset = m_tWriter.GetPos();
+	m_tWriter.Write ( dData.data(), dData.size() );
+	return iOffset;
+}
+
 } // namespace columnar
\ No newline at end of file
@@ -21,6 +21,7 @@
 #include "delta.h"
 #include "codec.h"
 #include <cassert>
+#include <mutex>
 
 namespace columnar
 {
@@ -33,10 +34,11 @@ class AttributeHeaderBuilder_c
 public:
 				AttributeHeaderBuilder_c ( const Settings_t & tSettings, const std::string & sName, common::AttrType_e eType );
 
+	const std::string & GetName() const { return m_sName; }
 	common::AttrType_e	GetType() const { return m_eType; }
 	const		Settings_t & GetSettings() const { return m_tSettings; }
-	void		AddBlock ( uint64_t tOffset ) { m_dBlocks.push_back(tOffset); }
-	bool		Save ( util::FileWriter_c & tWriter, int64_t & tBaseOffset, std::string & sError );
+	void		AddBlock ( uint64_t tOffset, uint64_t tSize ) { m_dBlocks.push_back(tOffset); m_dBlockSizes.push_back(tSize); }
+	bool		Save ( util::FileWriter_c & tWriter, std::string & sError );
 
 private:
 	std::string				m_sName;
@@ -44,6 +46,20 @@ private:
 	Settings_t				m_tSettings;
 
 	std::vector<int64_t>	m_dBlocks;
+	std::vector<uint64_t>	m_dBlockSizes;	// blocks of different attributes are interleaved, so sizes can't be derived from offsets
+};
+
+// all packers append their encoded blocks to the same file
+class BlockWriter_c
+{
+public:
+	bool				Open ( const std::string & sFile, std::string & sError );
+	int64_t				WriteBlock ( const std::vector<uint8_t> & dData );
+	util::FileWriter_c & GetWriter() { return m_tWriter; }
+
+private:
+	util::FileWriter_c	m_tWriter;
+	std::mutex			m_tLock;
 };
 
 class Packer_i
@@ -51,17 +67,20 @@ class Packer_i
 public:
 	virtual				~Packer_i(){}
 
-	virtual bool		Setup ( const std::string & sFilename, std::string & sError ) = 0;
+	virtual void		Setup ( BlockWriter_c & tWriter ) = 0;
 	virtual void		AddDoc ( int64_t tAttr ) = 0;
 	virtual void		AddDoc ( const uint8_t * pData, int iLength ) = 0;
 	virtual void		AddDoc ( const int64_t * pData, int iLength ) = 0;
-	virtual void		CorrectOffset ( util::FileWriter_c & tWriter, int64_t tBodyOffset ) = 0;
-	virtual int64_t		GetBodySize() const = 0;
+	virtual void		AddDocs ( const util::Span_T<int64_t> & dValues ) = 0;
+	virtual void		AddDocs ( const util::Span_T<int64_t> & dOffsets, const uint8_t * pData ) = 0;
+	virtual void		AddDocs ( const util::Span_T<int64_t> & dOffsets, const int64_t * pData ) = 0;
+	virtual void		Flush() = 0;
 	virtual void		Done() = 0;
-	virtual void		Cleanup() = 0;
 
 	virtual bool		WriteHeader ( util::FileWriter_c & tWriter, std::string & sError ) = 0;
-	virtual bool		WriteBody ( const std::string & sDest, std::string & sError ) const = 0;
+	virtual const std::string & GetName() const = 0;
+	virtual common::AttrType_e GetType() const = 0;
+	virtual void		AddPackingStats ( std::vector<PackingStats_t> & dStats ) const = 0;
 };
 
 template <typename HEADER>
@@ -70,66 +89,97 @@ class PackerTraits_T : public Packer_i
 public:
 					PackerTraits_T ( const Settings_t & tSettings, const std::string & sName, common::AttrType_e eType );
 
-	bool			Setup ( const std::string & sFilename, std::string & sError ) override;
-	void			CorrectOffset ( util::FileWriter_c & tWriter, int64_t tBodyOffset ) override;
-	int64_t			GetBodySize() const override { return m_iBodySize; }
-	void			Done() override;
+	void			Setup ( BlockWriter_c & tWriter ) override { m_pBlockWriter = &tWriter; }
+	void			AddDocs ( const util::Span_T<int64_t> & dValues ) override;
+	void			AddDocs ( const util::Span_T<int64_t> & dOffsets, const uint8_t * pData ) override;
+	void			AddDocs ( const util::Span_T<int64_t> & dOffsets, const int64_t * pData ) override;
+	void			Done() override { Flush(); }
 	bool			WriteHeader ( util::FileWriter_c & tWriter, std::string & sError ) override;
-	bool			WriteBody ( const std::string & sDest, std::string & sError ) const override;
-	void			Cleanup() override;
-
-	virtual void	Flush() = 0;
+	const std::string & GetName() const override { return m_tHeader.GetName(); }
+	common::AttrType_e GetType() const override { return m_tHeader.GetType(); }
+	void			AddPackingStats ( std::vector<PackingStats_t> & dStats ) const override;
 
 protected:
-	util::FileWriter_c	m_tWriter;
-	int64_t				m_iBaseOffset = 0;
-	int64_t				m_iBodySize = 0;
+	std::vector<uint8_t> m_dBlockData;
+	util::MemWriter_c	m_tWriter;
+	BlockWriter_c *		m_pBlockWriter = nullptr;
 
 	HEADER				m_tHeader;
+
+	void			WriteBlock();
+	void			CountPackedBlock ( int iPacking, const char * szPacking );
+
+private:
+	std::vector<PackingStats_t> m_dBlockStats;	// indexed by packing
 };
 
 template <typename HEADER>
 PackerTraits_T<HEADER>::PackerTraits_T ( const Settings_t & tSettings, const std::string & sName, common::AttrType_e eType )
-	: m_tHeader ( tSettings, sName, eType )
+	: m_tWriter ( m_dBlockData )
+	, m_tHeader ( tSettings, sName, eType )
 {}
 
+// generic (per-value) batch handlers; packers override the ones they accept with tight loops
 template <typename HEADER>
-bool PackerTraits_T<HEADER>::Setup ( const std::string & sFilename, std::string & sError )
+void PackerTraits_T<HEADER>::AddDocs ( const util::Span_T<int64_t> & dValues )
 {
-	return m_tWriter.Open ( sFilename, sError );
+	for ( auto i : dValues )
+		AddDoc(i);
 }
 
 template <typename HEADER>
-void PackerTraits_T<HEADER>::CorrectOffset ( util::FileWriter_c & tWriter, int64_t iBodyOffset )
+void PackerTraits_T<HEADER>::AddDocs ( const util::Span_T<int64_t> & dOffsets, const uint8_t * pData )
 {
-	tWriter.SeekAndWrite ( m_iBaseOffset, iBodyOffset );
+	for ( size_t i = 1; i < dOffsets.size(); i++ )
+		AddDoc ( pData+dOffsets[i-1], int ( dOffsets[i]-dOffsets[i-1] ) );
 }
 
 template <typename HEADER>
-void PackerTraits_T<HEADER>::Done()
+void PackerTraits_T<HEADER>::AddDocs ( const util::Span_T<int64_t> & dOffsets, const int64_t * pData )
 {
-	Flush();
-	m_iBodySize = m_tWriter.GetPos();
-	m_tWriter.Close();
+	for ( size_t i = 1; i < dOffsets.size(); i++ )
+		AddDoc ( pData+dOffsets[i-1], int ( dOffsets[i]-dOffsets[i-1] ) );
 }
 
 template <typename HEADER>
 bool PackerTraits_T<HEADER>::WriteHeader ( util::FileWriter_c & tWriter, std::string & sError )
 {
 	tWriter.Write_uint32 ( util::to_underlying ( m_tHeader.GetType() ) );
-	return m_tHeader.Save ( tWriter, m_iBaseOffset, sError );
+	return m_tHeader.Save ( tWriter, sError );
 }
 
 template <typename HEADER>
-bool PackerTraits_T<HEADER>::WriteBody ( const std::string & sDest, std::string & sError ) const
+void PackerTraits_T<HEADER>::AddPackingStats ( std::vector<PackingStats_t> & dStats ) const
 {
-	return util::CopySingleFile ( m_tWriter.GetFilename(), sDest, sError, O_CREAT | O_RDWR | O_APPEND | O_BINARY );
+	for ( const auto & i : m_dBlockStats )
+		if ( i.m_iBlocks )
+			dStats.push_back(i);
 }
 
+// should be called before WriteBlock, while the packed block is still in m_dBlockData
 template <typename HEADER>
-void PackerTraits_T<HEADER>::Cleanup()
+void PackerTraits_T<HEADER>::CountPackedBlock ( int iPacking, const char * szPacking )
 {
-	m_tWriter.Unlink();
+	if ( iPacking>=(int)m_dBlockStats.size() )
+		m_dBlockStats.resize ( iPacking+1 );
+
+	auto & tStats = m_dBlockStats[iPacking];
+	if ( !tStats.m_iBlocks )
+	{
+		tStats.m_sAttr = m_tHeader.GetName();
+		tStats.m_sPacking = szPacking;
+	}
+
+	tStats.m_iBlocks++;
+	tStats.m_iSize += (int64_t)m_dBlockData.size();
+}
+
+template <typename HEADER>
+void PackerTraits_T<HEADER>::WriteBlock()
+{
+	assert ( m_pBlockWriter );
+	m_tHeader.AddBlock ( m_pBlockWriter->WriteBlock(m_dBlockData), m_dBlockData.size() );
+	m_dBlockData.resize(0);
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -145,6 +195,16 @@ FORCE_INLINE int GetSubblockSize ( int iSubblock, int iNumSubblocks, int iNumVal
 	return iSubblockSize;
 }
 
+// decimal float packing stores floats as integers scaled by 10^exponent
+static const int MAX_DECIMAL_EXPONENT = 10;
+
+FORCE_INLINE float DecimalToFloat ( int64_t iDecimal, int iExponent )
+{
+	static const double dPow10[MAX_DECIMAL_EXPONENT+1] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10 };
+	assert ( iExponent>=0 && iExponent<=MAX_DECIMAL_EXPONENT );
+	return float ( double(iDecimal) / dPow10[iExponent] );
+}
+
 template <typename T, typename WRITER>
 static void WriteValues_Delta_PFOR ( const util::Span_T<T> & dValues, std::vector<T> & dTmpUncompressed, std::vector<uint32_t> & dTmpCompressed, WRITER & tWriter, util::IntCodec_i * pCodec )
 {
@@ -185,8 +245,11 @@ static void WriteValues_PFOR ( const util::Span_T<T> & dValues, std::vector<T> &
 	tWriter.Write ( (const uint8_t*)dTmpCompressed.data(), dTmpCompressed.size()*sizeof ( dTmpCompressed[0] ) );
 }
 
-template <typename UNIQ_VEC, typename UNIQ_HASH, typename COLLECTED>
-void WriteTableOrdinals ( UNIQ_VEC & dUniques, UNIQ_HASH & hUnique, COLLECTED & dCollected, std::vector<uint32_t> & dTableIndexes, std::vector<uint32_t> & dCompressed, int iSubblockSize, util::FileWriter_c & tWriter )
+// estimated per-run overhead (in bits) of RLE packings
+static const int RLE_RUN_BITS = 16;
+
+template <typename UNIQ_VEC, typename UNIQ_HASH, typename COLLECTED, typename WRITER>
+void WriteTableOrdinals ( UNIQ_VEC & dUniques, UNIQ_HASH & hUnique, COLLECTED & dCollected, std::vector<uint32_t> & dTableIndexes, std::vector<uint32_t> & dCompressed, int iSubblockSize, WRITER & tWriter )
 {
 	// write the ordinals
 	int iBits = util::CalcNumBits ( dUniques.size() );
@@ -20,11 +20,17 @@
 #include "accessorint.h"
 #include "accessorstr.h"
 #include "accessormva.h"
+#include "accessorfused.h"
 #include "check.h"
+#include "subblockcache.h"
 #include "reader.h"
 
 #include <unordered_map>
 #include <algorithm>
+#include <atomic>
+#include <climits>
+#include <mutex>
+#include <shared_mutex>
 
 namespace columnar
 {
@@ -297,27 +303,16 @@ void BlockIterator_c::AddDesc ( std::vector<IteratorDesc_t> & dDesc ) const
 
 bool BlockIterator_c::HintRowID ( uint32_t tRowID )
 {
-	int iNextBlock = m_iBlock;
-	int iNumBlocks = m_pMatchingBlocks->GetNumBlocks();
-
-	// we assume that we are only advancing forward
-	while ( iNextBlock<iNumBlocks )
-	{
-		uint32_t tSubblockStart = MinMaxBlockId2RowId ( m_pMatchingBlocks->GetBlock(iNextBlock) );
-		uint32_t tSubblockEnd = tSubblockStart + m_iDocsPerBlock;
-
-		if ( tRowID<tSubblockStart || ( tRowID>=tSubblockStart && tRowID<tSubblockEnd ) )
-		{
-			if ( iNextBlock!=m_iBlock )
-				SetCurBlock(iNextBlock);
+	// the first matching block that ends after tRowID; we assume that we are only advancing forward
+	int iBlockId = m_pMatchingBlocks->FindNext ( tRowID >> m_iMinMaxLeafShift );
+	if ( iBlockId<0 )
+		return false;
 
-			return true;
-		}
+	int iNextBlock = m_pMatchingBlocks->GetIndex(iBlockId);
+	if ( iNextBlock>m_iBlock )
+		SetCurBlock(iNextBlock);
 
-		iNextBlock++;
-	}
-
-	return false;
+	return true;
 }
 
 
@@ -390,43 +385,68 @@ uint32_t BlockIterator_c::MinMaxBlockId2RowId ( int iBlockId ) const
 
 //////////////////////////////////////////////////////////////////////////
 
+// directory entry; the header itself is loaded on first use
+struct LazyHeader_t
+{
+	std::string							m_sName;
+	AttrType_e							m_eType = AttrType_e::NONE;
+	int64_t								m_iOffset = 0;
+	std::unique_ptr<AttributeHeader_i>	m_pHeader;
+	std::atomic<bool>					m_bLoaded{false};
+	std::atomic<bool>					m_bMinMaxLoaded{false};
+	std::atomic<bool>					m_bMinMaxUsed{false};
+};
+
 class Columnar_c final : public Columnar_i
 {
 public:
-										Columnar_c ( const std::string & sFilename, uint32_t uTotalDocs );
+										Columnar_c ( const std::string & sFilename, uint32_t uTotalDocs, const ReaderSettings_t & tSettings );
 
 	bool								Setup ( std::string & sError );
 
 	Iterator_i *						CreateIterator ( const std::string & sName, const IteratorHints_t & tHints, columnar::IteratorCapabilities_t * pCapabilities, std::string & sError ) const final;
-	std::vector<BlockIterator_i *>		CreateAnalyzerOrPrefilter ( const std::vector<Filter_t> & dFilters, std::vector<int> & dDeletedFilters, const BlockTester_i & tBlockTester ) const final;
+	std::vector<BlockIterator_i *>		CreateAnalyzerOrPrefilter ( const std::vector<Filter_t> & dFilters, std::vector<int> & dDeletedFilters, const BlockTester_i & tBlockTester, const AnalyzerLimits_t & tLimits ) const final;
 	int									GetAttributeId ( const std::string & sName ) const final;
 	AttrType_e							GetType ( const std::string & sName ) const final;
 
 	bool								EarlyReject ( const std::vector<Filter_t> & dFilters, const BlockTester_i & tBlockTester ) const final;
 	bool								IsFilterDegenerate ( const Filter_t & tFilter ) const final;
+	void								UnloadColdMinMax() final;
 
 private:
 	std::string							m_sFilename;
 	uint32_t							m_uTotalDocs;
-	std::vector<std::unique_ptr<AttributeHeader_i>>	m_dHeaders;
-	std::unordered_map<std::string, HeaderWithLocator_t> m_hHeaders;
+	ReaderSettings_t					m_tSettings;
+	std::vector<std::unique_ptr<LazyHeader_t>>	m_dHeaders;
+	std::unordered_map<std::string, int> m_hHeaders;
 	FileReader_c						m_tReader;
+	MappedBuffer_T<uint8_t>				m_tMapped;
+	mutable std::mutex					m_tLoadLock;	// serializes loading of headers and minmax trees
+	mutable std::shared_timed_mutex		m_tMinMaxLock;	// shared while minmax trees are evaluated; exclusive while unloading them
 
 	const AttributeHeader_i *			GetHeader ( const std::string & sName ) const;
-	bool								LoadHeaders ( FileReader_c & tReader, int iNumAttrs, std::string & sError );
+	const AttributeHeader_i *			GetHeader ( int iAttr, std::string & sError ) const;
+	bool								LoadHeader ( LazyHeader_t & tHeader, std::string & sError ) const;
+	bool								LoadMinMax ( LazyHeader_t & tHeader ) const;
+	bool								LoadDirectory ( FileReader_c & tReader, int iNumAttrs, std::string & sError );
 	FileReader_c *						CreateFileReader() const;
 	std::vector<HeaderWithLocator_t>	GetHeadersForMinMax ( const std::vector<Filter_t> & dFilters ) const;
+	bool								FilterMinMaxLeaves ( const std::vector<Filter_t> & dFilters, const std::vector<HeaderWithLocator_t> & dHeaders, const BlockTester_i & tBlockTester, uint32_t uMinRowID, uint32_t uMaxRowID, MatchingBlocks_c & tMatchingBlocks ) const;
+	void								ApplyBloomFilters ( const std::vector<Filter_t> & dFilters, SharedBlocks_c & pMatchingBlocks ) const;
 
 	Analyzer_i *						CreateAnalyzer ( const Filter_t & tSettings, bool bHaveMatchingBlocks ) const;
+	int									EstimateMatchingLeaves ( const Filter_t & tFilter, const AttributeHeader_i & tHeader ) const;
+	Analyzer_i *						TryToCreateFusedAnalyzer ( const std::vector<Filter_t> & dFilters, std::vector<int> & dFused, SharedBlocks_c & pMatchingBlocks ) const;
 	std::vector<BlockIterator_i *>		TryToCreatePrefilter ( const std::vector<HeaderWithLocator_t> & dHeaders, SharedBlocks_c pMatchingBlocks ) const;
-	std::vector<BlockIterator_i *>		TryToCreateAnalyzers ( const std::vector<Filter_t> & dFilters, std::vector<int> & dDeletedFilters, SharedBlocks_c & pMatchingBlocks ) const;
+	std::vector<BlockIterator_i *>		TryToCreateAnalyzers ( const std::vector<Filter_t> & dFilters, std::vector<int> & dDeletedFilters, SharedBlocks_c & pMatchingBlocks, const AnalyzerLimits_t & tLimits ) const;
 };
 
 //////////////////////////////////////////////////////////////////////////
 
-Columnar_c::Columnar_c ( const std::string & sFilename, uint32_t uTotalDocs )
+Columnar_c::Columnar_c ( const std::string & sFilename, uint32_t uTotalDocs, const ReaderSettings_t & tSettings )
 	: m_sFilename ( sFilename )
 	, m_uTotalDocs ( uTotalDocs )
+	, m_tSettings ( tSettings )
 {}
 
 
@@ -435,6 +455,9 @@ bool Columnar_c::Setup ( std::string & sError )
 	if ( !m_tReader.Open ( m_sFilename, sError ) )
 		return false;
 
+	if ( m_tSettings.m_bMmap && !m_tMapped.Open ( m_sFilename, sError ) )
+		return false;
+
 	uint32_t uStorageVersion = m_tReader.Read_uint32();
 	if ( uStorageVersion!=STORAGE_VERSION )
 	{
@@ -442,11 +465,37 @@ bool Columnar_c::Setup ( std::string & sError )
 		return false;
 	}
 
+	// header directory is stored after all attribute blocks and headers; its offset is at the end of the file
+	int64_t iFileSize = m_tReader.GetFileSize();
+	int64_t iDirEnd = iFileSize-(int64_t)sizeof(uint64_t);
+	if ( iFileSize < int64_t ( sizeof(uint32_t)+sizeof(uint64_t) ) )
+	{
+		sError = FormatStr ( "Unable to load columnar storage: %s is truncated", m_sFilename.c_str() );
+		return false;
+	}
+
+	m_tReader.Seek(iDirEnd);
+	int64_t iDirOffset = (int64_t)m_tReader.Read_uint64();
+	if ( iDirOffset<(int64_t)sizeof(uint32_t) || iDirOffset+(int64_t)sizeof(uint32_t)>iDirEnd )
+	{
+		sError = FormatStr ( "Unable to load columnar storage: header directory offset in %s points beyond EOF", m_sFilename.c_str() );
+		return false;
+	}
+
+	m_tReader.Seek(iDirOffset);
 	int iNumAttrs = (int)m_tReader.Read_uint32();
 	if ( !iNumAttrs )
 		return true;
 
-	if ( !LoadHeaders ( m_tReader, iNumAttrs, sError ) )
+	// every directory entry holds at least a name length, a type and a header offset
+	const int64_t MIN_ENTRY_SIZE = sizeof(uint32_t) + sizeof(uint32_t) + sizeof(uint64_t);
+	if ( iNumAttrs<0 || (int64_t)iNumAttrs*MIN_ENTRY_SIZE > iDirEnd-iDirOffset-(int64_t)sizeof(uint32_t) )
+	{
+		sError = FormatStr ( "Unable to load columnar storage: %s has a corrupted header directory (%d attributes)", m_sFilename.c_str(), iNumAttrs );
+		return false;
+	}
+
+	if ( !LoadDirectory ( m_tReader, iNumAttrs, sError ) )
 		return false;
 
 	if ( m_tReader.IsError() )
@@ -461,7 +510,7 @@ bool Columnar_c::Setup ( std::string & sError )
 
 Iterator_i * Columnar_c::CreateIterator ( const std::string & sName, const IteratorHints_t & tHints, columnar::IteratorCapabilities_t * pCapabilities, std::string & sError ) const
 {
-	const AttributeHeader_i * pHeader = GetHeader(sName);
+	const AttributeHeader_i * pHeader = GetHeader ( GetAttributeId(sName), sError );
 	if ( !pHeader )
 		return nullptr;
 
@@ -505,6 +554,9 @@ Iterator_i * Columnar_c::CreateIterator ( const std::string & sName, const Itera
 
 FileReader_c * Columnar_c::CreateFileReader() const
 {
+	if ( m_tSettings.m_bMmap )
+		return new FileReader_c ( m_tMapped.begin(), m_tMapped.size() );
+
 	return new FileReader_c ( m_tReader.GetFD() );
 }
 
@@ -565,6 +617,9 @@ std::vector<HeaderWithLocator_t> Columnar_c::GetHeadersForMinMax ( const std::ve
 		if ( !pHeader || !pHeader->GetNumMinMaxLevels() )
 			continue;
 
+		if ( !LoadMinMax ( *m_dHeaders[iAttrIndex] ) )
+			continue;
+
 		dHeaders.push_back ( { pHeader, iAttrIndex } );
 		iBlocks = dHeaders.back().first->GetNumBlocks();
 	}
@@ -576,6 +631,139 @@ std::vector<HeaderWithLocator_t> Columnar_c::GetHeadersForMinMax ( const std::ve
 }
 
 
+static void ClearBits ( std::vector<uint64_t> & dBits, int iStart, int iEnd )
+{
+	for ( int i = iStart; i < iEnd; )
+	{
+		if ( !( i & 63 ) && i+64<=iEnd )
+		{
+			dBits[i>>6] = 0;
+			i += 64;
+		}
+		else
+		{
+			dBits[i>>6] &= ~( 1ULL << ( i & 63 ) );
+			i++;
+		}
+	}
+}
+
+// all leaves are set
+static std::vector<uint64_t> CreateLeafBitmap ( int iNumLeaves )
+{
+	std::vector<uint64_t> dLeaves ( ( iNumLeaves+63 ) >> 6, UINT64_MAX );
+	if ( iNumLeaves & 63 )
+		dLeaves.back() = ( 1ULL << ( iNumLeaves & 63 ) ) - 1;
+
+	return dLeaves;
+}
+
+// evaluates filters on minmax tree leaves directly (no tree walk and no block tester calls)
+// filters are ANDed; returns false if any of the filters with minmax can't be evaluated this way
+bool Columnar_c::FilterMinMaxLeaves ( const std::vector<Filter_t> & dFilters, const std::vector<HeaderWithLocator_t> & dHeaders, const BlockTester_i & tBlockTester, uint32_t uMinRowID, uint32_t uMaxRowID, MatchingBlocks_c & tMatchingBlocks ) const
+{
+	assert ( !dHeaders.empty() );
+	const AttributeHeader_i & tFirst = *dHeaders[0].first;
+	int iNumLeaves = tFirst.GetNumMinMaxBlocks ( tFirst.GetNumMinMaxLevels()-1 );
+	std::vector<uint64_t> dLeaves = CreateLeafBitmap(iNumLeaves);
+
+	Span_T<uint64_t> dLeavesSpan(dLeaves);
+	for ( const auto & tFilter : dFilters )
+	{
+		int iAttr = GetAttributeId ( tFilter.m_sName );
+		auto tFound = std::find_if ( dHeaders.begin(), dHeaders.end(), [iAttr]( auto & tHeader ){ return tHeader.second==iAttr; } );
+		if ( tFound==dHeaders.end() )
+			continue;
+
+		if ( !tFound->first->FilterMinMaxLeaves ( tFilter, dLeavesSpan ) )
+			return false;
+	}
+
+	int iLeafShift = CalcNumBits ( tFirst.GetSettings().m_iSubblockSize ) - 1;
+	int iFirstLeaf = std::min ( int ( uMinRowID >> iLeafShift ), iNumLeaves );
+	int iLastLeaf = std::min ( int ( uMaxRowID >> iLeafShift ), iNumLeaves-1 );
+	ClearBits ( dLeaves, 0, iFirstLeaf );
+	ClearBits ( dLeaves, iLastLeaf+1, iNumLeaves );
+
+	// the block tester may reject more than our filters do, so it still gets the surviving leaves
+	int iLeafLevel = tFirst.GetNumMinMaxLevels()-1;
+	int iMaxLocator = 0;
+	for ( const auto & i : dHeaders )
+		iMaxLocator = std::max ( i.second, iMaxLocator );
+
+	MinMaxVec_t dMinMax ( iMaxLocator+1, {0,0} );
+	for ( size_t iWord = 0; iWord < dLeaves.size(); iWord++ )
+	{
+		uint64_t uBits = dLeaves[iWord];
+		while ( uBits )
+		{
+			int iBit = BitScanForward(uBits);
+			uBits &= uBits-1;
+
+			int iLeaf = int(iWord<<6) + iBit;
+			for ( const auto & tHeader : dHeaders )
+				dMinMax[tHeader.second] = tHeader.first->GetMinMax ( iLeafLevel, iLeaf );
+
+			if ( !tBlockTester.Test(dMinMax) )
+				dLeaves[iWord] &= ~( 1ULL << iBit );
+		}
+	}
+
+	tMatchingBlocks.SetBits ( std::move(dLeaves) );
+	return true;
+}
+
+// drops subblocks that can't contain any of the values of equality filters (according to per-subblock bloom filters)
+void Columnar_c::ApplyBloomFilters ( const std::vector<Filter_t> & dFilters, SharedBlocks_c & pMatchingBlocks ) const
+{
+	const size_t MAX_BLOOM_VALUES = 64;
+
+	std::vector<std::pair<const AttributeHeader_i *, std::vector<int64_t>>> dBloomFilters;
+	for ( const auto & i : dFilters )
+	{
+		if ( i.m_bExclude )
+			continue;
+
+		if ( i.m_eType==FilterType_e::VALUES && !i.m_dValues.empty() && i.m_dValues.size()<=MAX_BLOOM_VALUES )
+		{
+			const AttributeHeader_i * pHeader = GetHeader ( i.m_sName );
+			if ( pHeader && pHeader->HaveBloomFilter() )
+				dBloomFilters.push_back ( { pHeader, i.m_dValues } );
+		}
+		else if ( i.m_eType==FilterType_e::STRINGS && i.m_fnCalcStrHash && !i.m_dStringValues.empty() && i.m_dStringValues.size()<=MAX_BLOOM_VALUES )
+		{
+			const AttributeHeader_i * pHashHeader = GetHeader ( GenerateHashAttrName ( i.m_sName ) );
+			if ( pHashHeader && pHashHeader->HaveBloomFilter() )
+				dBloomFilters.push_back ( { pHashHeader, StringFilterToHashFilter ( i, false ).m_dValues } );
+		}
+		else if ( i.m_eType==FilterType_e::FLOATRANGE && i.m_fMinValue==i.m_fMaxValue && i.m_fMinValue!=0.0f && i.m_bLeftClosed && i.m_bRightClosed && !i.m_bLeftUnbounded && !i.m_bRightUnbounded )
+		{
+			// float bloom filters hold raw float bits; zero is skipped because -0.0 and 0.0 have different bits
+			const AttributeHeader_i * pHeader = GetHeader ( i.m_sName );
+			if ( pHeader && pHeader->GetType()==AttrType_e::FLOAT && pHeader->HaveBloomFilter() )
+				dBloomFilters.push_back ( { pHeader, { (int64_t)FloatToUint ( i.m_fMinValue ) } } );
+		}
+	}
+
+	if ( dBloomFilters.empty() )
+		return;
+
+	// each filter only tests the blocks that survived the previous ones
+	for ( const auto & tFilter : dBloomFilters )
+	{
+		MatchingBlocks_c tPassed;
+		for ( int i = 0; i < pMatchingBlocks->GetNumBlocks(); i++ )
+		{
+			int iBlock = pMatchingBlocks->GetBlock(i);
+			if ( std::any_of ( tFilter.second.begin(), tFilter.second.end(), [iBlock, &tFilter]( int64_t iValue ){ return tFilter.first->BloomFilterTest ( iBlock, iValue ); } ) )
+				tPassed.Add(iBlock);
+		}
+
+		pMatchingBlocks->And(tPassed);
+	}
+}
+
+
 static void FetchRowIdLimits ( const Filter_t & tFilter, uint32_t uNumDocs, uint32_t & uMinRowID, uint32_t & uMaxRowID )
 {
 	uint32_t uMin = (uint32_t)tFilter.m_iMinValue;
@@ -595,8 +783,14 @@ static void PopulateMatchingBlocks ( MatchingBlocks_c & tBlocks, int iBlockSize,
 }
 
 
-std::vector<BlockIterator_i *> Columnar_c::CreateAnalyzerOrPrefilter ( const std::vector<Filter_t> & dFilters, std::vector<int> & dDeletedFilters, const BlockTester_i & tBlockTester ) const
+std::vector<BlockIterator_i *> Columnar_c::CreateAnalyzerOrPrefilter ( const std::vector<Filter_t> & dFilters, std::vector<int> & dDeletedFilters, const BlockTester_i & tBlockTester, const AnalyzerLimits_t & tLimits ) const
 {
+	std::string sError;
+	const AttributeHeader_i * pFirstHeader = GetHeader ( 0, sError );
+	if ( !pFirstHeader )
+		return {};
+
+	std::shared_lock<std::shared_timed_mutex> tMinMaxLock(m_tMinMaxLock);
 	std::vector<HeaderWithLocator_t> dHeaders = GetHeadersForMinMax(dFilters);
 	SharedBlocks_c pMatchingBlocks ( dHeaders.empty() ? nullptr : new MatchingBlocks_c );
 
@@ -611,29 +805,39 @@ std::vector<BlockIterator_i *> Columnar_c::CreateAnalyzerOrPrefilter ( const std
 	uint32_t uMinRowID = 0;
 	uint32_t uMaxRowID = INVALID_ROW_ID;
 	if ( pRowIdFilter )
-		FetchRowIdLimits ( *pRowIdFilter, m_dHeaders[0]->GetNumDocs(), uMinRowID, uMaxRowID );
+		FetchRowIdLimits ( *pRowIdFilter, pFirstHeader->GetNumDocs(), uMinRowID, uMaxRowID );
 
 	bool bMinMaxBlocks = !!pMatchingBlocks;
 	if ( bMinMaxBlocks )
 	{
-		if ( pRowIdFilter )
+		// fall back to walking the tree with the block tester if some filters can't be evaluated on the leaves
+		if ( !FilterMinMaxLeaves ( dFilters, dHeaders, tBlockTester, uMinRowID, uMaxRowID, *pMatchingBlocks ) )
 		{
-			MinMaxEval_T<true> tMinMaxEval ( dHeaders, tBlockTester, pMatchingBlocks, uMinRowID, uMaxRowID );
-			tMinMaxEval.Eval();
-		}
-		else
-		{
-			MinMaxEval_T<false> tMinMaxEval ( dHeaders, tBlockTester, pMatchingBlocks, uMinRowID, uMaxRowID );
-			tMinMaxEval.Eval();
+			if ( pRowIdFilter )
+			{
+				MinMaxEval_T<true> tMinMaxEval ( dHeaders, tBlockTester, pMatchingBlocks, uMinRowID, uMaxRowID );
+				tMinMaxEval.Eval();
+			}
+			else
+			{
+				MinMaxEval_T<false> tMinMaxEval ( dHeaders, tBlockTester, pMatchingBlocks, uMinRowID, uMaxRowID );
+				tMinMaxEval.Eval();
+			}
 		}
 	}
 	else
 	{
+		// no minmax; start with all subblocks that exist (bloom filters are only stored for those)
+		uint32_t uNumDocs = pFirstHeader->GetNumDocs();
 		pMatchingBlocks = SharedBlocks_c ( new MatchingBlocks_c );
-		PopulateMatchingBlocks ( *pMatchingBlocks, m_dHeaders[0]->GetSettings().m_iSubblockSize, uMinRowID, uMaxRowID );
+		if ( uNumDocs )
+			PopulateMatchingBlocks ( *pMatchingBlocks, pFirstHeader->GetSettings().m_iSubblockSize, uMinRowID, std::min ( uMaxRowID, uNumDocs-1 ) );
 	}
 
-	std::vector<BlockIterator_i *> dAnalyzers = TryToCreateAnalyzers ( dFilters, dDeletedFilters, pMatchingBlocks );
+	// bloom filters don't need minmax; they also work for attributes that don't have it (e.g. string hashes)
+	ApplyBloomFilters ( dFilters, pMatchingBlocks );
+
+	std::vector<BlockIterator_i *> dAnalyzers = TryToCreateAnalyzers ( dFilters, dDeletedFilters, pMatchingBlocks, tLimits );
 	if ( !dAnalyzers.empty() )
 		return dAnalyzers;
 
@@ -647,19 +851,20 @@ std::vector<BlockIterator_i *> Columnar_c::CreateAnalyzerOrPrefilter ( const std
 int Columnar_c::GetAttributeId ( const std::string & sName ) const
 {
 	const auto & tFound = m_hHeaders.find(sName);
-	return tFound==m_hHeaders.end() ? -1 : tFound->second.second;
+	return tFound==m_hHeaders.end() ? -1 : tFound->second;
 }
 
 
 AttrType_e Columnar_c::GetType ( const std::string & sName ) const
 {
 	const auto & tFound = m_hHeaders.find(sName);
-	return tFound==m_hHeaders.end() ? AttrType_e::NONE : tFound->second.first->GetType();
+	return tFound==m_hHeaders.end() ? AttrType_e::NONE : m_dHeaders[tFound->second]->m_eType;
 }
 
 
 bool Columnar_c::EarlyReject ( const std::vector<Filter_t> & dFilters, const BlockTester_i & tBlockTester ) const
 {
+	std::shared_lock<std::shared_timed_mutex> tMinMaxLock(m_tMinMaxLock);
 	std::vector<HeaderWithLocator_t> dHeaders = GetHeadersForMinMax(dFilters);
 	if ( dHeaders.empty() )
 		return false;
@@ -684,12 +889,108 @@ bool Columnar_c::IsFilterDegenerate ( const Filter_t & tFilter ) const
 }
 
 
-std::vector<BlockIterator_i *> Columnar_c::TryToCreateAnalyzers ( const std::vector<Filter_t> & dFilters, std::vector<int> & dDeletedFilters, SharedBlocks_c & pMatchingBlocks ) const
+int Columnar_c::EstimateMatchingLeaves ( const Filter_t & tFilter, const AttributeHeader_i & tHeader ) const
+{
+	if ( !tHeader.GetNumMinMaxLevels() || !tHeader.IsMinMaxLoaded() )
+		return INT_MAX;
+
+	int iNumLeaves = tHeader.GetNumMinMaxBlocks ( tHeader.GetNumMinMaxLevels()-1 );
+	std::vector<uint64_t> dLeaves = CreateLeafBitmap(iNumLeaves);
+	Span_T<uint64_t> dLeavesSpan(dLeaves);
+	if ( !tHeader.FilterMinMaxLeaves ( tFilter, dLeavesSpan ) )
+		return iNumLeaves;
+
+	int iMatching = 0;
+	for ( auto i : dLeaves )
+		iMatching += PopCount(i);
+
+	return iMatching;
+}
+
+// one analyzer for the most selective filter; other filters on scalar attributes are evaluated on its output
+Analyzer_i * Columnar_c::TryToCreateFusedAnalyzer ( const std::vector<Filter_t> & dFilters, std::vector<int> & dFused, SharedBlocks_c & pMatchingBlocks ) const
+{
+	struct FusedCandidate_t
+	{
+		int					m_iFilter;
+		AttrType_e			m_eType;
+		int					m_iMatchingLeaves;
+	};
+
+	std::vector<FusedCandidate_t> dCandidates;
+	for ( size_t i = 0; i<dFilters.size(); i++ )
+	{
+		const auto & tFilter = dFilters[i];
+		const AttributeHeader_i * pHeader = GetHeader ( tFilter.m_sName );
+		if ( pHeader && IsFilterFusable ( tFilter, pHeader->GetType() ) )
+			dCandidates.push_back ( { (int)i, pHeader->GetType(), EstimateMatchingLeaves ( tFilter, *pHeader ) } );
+	}
+
+	if ( dCandidates.size()<2 )
+		return nullptr;
+
+	// most selective first; equality filters are cheaper to evaluate than ranges
+	std::stable_sort ( dCandidates.begin(), dCandidates.end(), [&dFilters]( const auto & tA, const auto & tB )
+		{
+			if ( tA.m_iMatchingLeaves!=tB.m_iMatchingLeaves )
+				return tA.m_iMatchingLeaves<tB.m_iMatchingLeaves;
+
+			bool bValuesA = dFilters[tA.m_iFilter].m_eType==FilterType_e::VALUES;
+			bool bValuesB = dFilters[tB.m_iFilter].m_eType==FilterType_e::VALUES;
+			return bValuesA && !bValuesB;
+		} );
+
+	std::vector<FusedProbe_t> dProbes;
+	auto fnDeleteProbes = [&dProbes]{ for ( auto & i : dProbes ) delete i.m_pIterator; };
+
+	for ( size_t i = 1; i<dCandidates.size(); i++ )
+	{
+		const auto & tCandidate = dCandidates[i];
+		const Filter_t & tFilter = dFilters[tCandidate.m_iFilter];
+
+		std::string sError;
+		Iterator_i * pIterator = CreateIterator ( tFilter.m_sName, IteratorHints_t(), nullptr, sError );
+		if ( !pIterator )
+		{
+			fnDeleteProbes();
+			return nullptr;
+		}
+
+		dProbes.push_back ( { pIterator, tFilter, tCandidate.m_eType } );
+	}
+
+	Analyzer_i * pLead = CreateAnalyzer ( dFilters[dCandidates[0].m_iFilter], !!pMatchingBlocks );
+	if ( !pLead )
+	{
+		fnDeleteProbes();
+		return nullptr;
+	}
+
+	for ( const auto & i : dCandidates )
+		dFused.push_back ( i.m_iFilter );
+
+	return CreateAnalyzerFused ( pLead, dProbes );
+}
+
+
+std::vector<BlockIterator_i *> Columnar_c::TryToCreateAnalyzers ( const std::vector<Filter_t> & dFilters, std::vector<int> & dDeletedFilters, SharedBlocks_c & pMatchingBlocks, const AnalyzerLimits_t & tLimits ) const
 {
 	std::vector<BlockIterator_i*> dAnalyzers;
 
+	std::vector<int> dFused;
+	Analyzer_i * pFused = TryToCreateFusedAnalyzer ( dFilters, dFused, pMatchingBlocks );
+	if ( pFused )
+	{
+		pFused->Setup ( pMatchingBlocks, m_uTotalDocs );
+		pFused->SetLimits(tLimits);
+		dAnalyzers.push_back(pFused);
+	}
+
 	for ( size_t i = 0; i<dFilters.size(); i++ )
 	{
+		if ( std::find ( dFused.begin(), dFused.end(), (int)i )!=dFused.end() )
+			continue;
+
 		const auto & tFilter = dFilters[i];
 
 		int iAttrIndex = GetAttributeId ( tFilter.m_sName );
@@ -703,12 +1004,19 @@ std::vector<BlockIterator_i *> Columnar_c::TryToCreateAnalyzers ( const std::vec
 			if ( pAnalyzer )
 			{
 				pAnalyzer->Setup ( pMatchingBlocks, pHeader->GetNumDocs() );
+				pAnalyzer->SetLimits(tLimits);
 				dAnalyzers.push_back(pAnalyzer);
 				dDeletedFilters.push_back ( (int)i );
 			}
 		}
 	}
 
+	if ( !dFused.empty() )
+	{
+		dDeletedFilters.insert ( dDeletedFilters.end(), dFused.begin(), dFused.end() );
+		std::sort ( dDeletedFilters.begin(), dDeletedFilters.end() );
+	}
+
 	return dAnalyzers;
 }
 
@@ -726,30 +1034,118 @@ std::vector<BlockIterator_i *> Columnar_c::TryToCreatePrefilter ( const std::vec
 }
 
 
+void Columnar_c::UnloadColdMinMax()
+{
+	std::unique_lock<std::shared_timed_mutex> tMinMaxLock(m_tMinMaxLock);
+	std::unique_lock<std::mutex> tLoadLock(m_tLoadLock);
+
+	// trees used since the previous call get a second chance
+	for ( auto & i : m_dHeaders )
+	{
+		if ( !i->m_bMinMaxLoaded.load(std::memory_order_relaxed) )
+			continue;
+
+		if ( i->m_bMinMaxUsed.exchange ( false, std::memory_order_relaxed ) )
+			continue;
+
+		i->m_pHeader->UnloadMinMax();
+		i->m_bMinMaxLoaded.store ( false, std::memory_order_relaxed );
+	}
+}
+
+
 const AttributeHeader_i * Columnar_c::GetHeader ( const std::string & sName ) const
 {
-	const auto & tFound = m_hHeaders.find(sName);
-	return tFound==m_hHeaders.end() ? nullptr : tFound->second.first;
+	std::string sError;
+	return GetHeader ( GetAttributeId(sName), sError );
 }
 
 
-bool Columnar_c::LoadHeaders ( FileReader_c & tReader, int iNumAttrs, std::string & sError )
+const AttributeHeader_i * Columnar_c::GetHeader ( int iAttr, std::string & sError ) const
 {
+	if ( iAttr<0 || iAttr>=(int)m_dHeaders.size() )
+		return nullptr;
+
+	LazyHeader_t & tHeader = *m_dHeaders[iAttr];
+	if ( tHeader.m_bLoaded.load(std::memory_order_acquire) )
+		return tHeader.m_pHeader.get();
+
+	std::unique_lock<std::mutex> tLock(m_tLoadLock);
+	if ( !tHeader.m_bLoaded.load(std::memory_order_relaxed) && !LoadHeader ( tHeader, sError ) )
+		return nullptr;
+
+	return tHeader.m_pHeader.get();
+}
+
+
+bool Columnar_c::LoadHeader ( LazyHeader_t & tHeader, std::string & sError ) const
+{
+	std::unique_ptr<FileReader_c> pReader ( CreateFileReader() );
+	pReader->Seek ( tHeader.m_iOffset );
+
+	AttrType_e eType = AttrType_e ( pReader->Read_uint32() );
+	if ( eType!=tHeader.m_eType )
+	{
+		sError = FormatStr ( "Header type mismatch for attribute '%s'", tHeader.m_sName.c_str() );
+		return false;
+	}
+
+	std::unique_ptr<AttributeHeader_i> pHeader ( CreateAttributeHeader ( eType, m_uTotalDocs, sError ) );
+	if ( !pHeader )
+		return false;
+
+	if ( !pHeader->Load ( *pReader, sError ) )
+		return false;
+
+	tHeader.m_pHeader = std::move(pHeader);
+	tHeader.m_bMinMaxLoaded.store ( tHeader.m_pHeader->IsMinMaxLoaded(), std::memory_order_relaxed );
+	tHeader.m_bLoaded.store ( true, std::memory_order_release );
+	return true;
+}
+
+
+// must be called under a shared lock of m_tMinMaxLock; the tree stays loaded until that lock is released
+bool Columnar_c::LoadMinMax ( LazyHeader_t & tHeader ) const
+{
+	assert ( tHeader.m_bLoaded );
+	tHeader.m_bMinMaxUsed.store ( true, std::memory_order_relaxed );
+	if ( tHeader.m_bMinMaxLoaded.load(std::memory_order_acquire) )
+		return true;
+
+	std::unique_lock<std::mutex> tLock(m_tLoadLock);
+	if ( tHeader.m_bMinMaxLoaded.load(std::memory_order_relaxed) )
+		return true;
+
+	std::string sError;
+	std::unique_ptr<FileReader_c> pReader ( CreateFileReader() );
+	if ( !tHeader.m_pHeader->LoadMinMax ( *pReader, sError ) )
+		return false;
+
+	tHeader.m_bMinMaxLoaded.store ( true, std::memory_order_release );
+	return true;
+}
+
+
+bool Columnar_c::LoadDirectory ( FileReader_c & tReader, int iNumAttrs, std::string & sError )
+{
+	int64_t iFileSize = tReader.GetFileSize();
 	m_dHeaders.resize(iNumAttrs);
 
 	for ( size_t i = 0; i < m_dHeaders.size(); i++ )
 	{
-		AttrType_e eType = AttrType_e ( tReader.Read_uint32() );
-		std::unique_ptr<AttributeHeader_i> pHeader ( CreateAttributeHeader ( eType, m_uTotalDocs, sError ) );
-		if ( !pHeader )
-			return false;
+		auto & pHeader = m_dHeaders[i];
+		pHeader = std::unique_ptr<LazyHeader_t> ( new LazyHeader_t );
+		pHeader->m_sName = tReader.Read_string();
+		pHeader->m_eType = AttrType_e ( tReader.Read_uint32() );
+		pHeader->m_iOffset = (int64_t)tReader.Read_uint64();
 
-		if ( !pHeader->Load ( tReader, sError ) )
+		if ( pHeader->m_iOffset<(int64_t)sizeof(uint32_t) || pHeader->m_iOffset>=iFileSize )
+		{
+			sError = FormatStr ( "Header offset of attribute '%s' points beyond EOF", pHeader->m_sName.c_str() );
 			return false;
+		}
 
-		m_dHeaders[i] = std::move(pHeader);
-		m_hHeaders.insert ( { m_dHeaders[i]->GetName(), { m_dHeaders[i].get(), (int)i } } );
-		tReader.Seek ( tReader.Read_uint64() );
+		m_hHeaders.insert ( { pHeader->m_sName, (int)i } );
 	}
 
 	return true;
@@ -758,9 +1154,9 @@ bool Columnar_c::LoadHeaders ( FileReader_c & tReader, int iNumAttrs, std::strin
 } // namespace columnar
 
 
-columnar::Columnar_i * CreateColumnarStorageReader ( const std::string & sFilename, uint32_t uTotalDocs, std::string & sError )
+columnar::Columnar_i * CreateColumnarStorageReader ( const std::string & sFilename, uint32_t uTotalDocs, const columnar::ReaderSettings_t & tSettings, std::string & sError )
 {
-	std::unique_ptr<columnar::Columnar_c> pColumnar ( new columnar::Columnar_c ( sFilename, uTotalDocs ) );
+	std::unique_ptr<columnar::Columnar_c> pColumnar ( new columnar::Columnar_c ( sFilename, uTotalDocs, tSettings ) );
 	if ( !pColumnar->Setup(sError) )
 		return nullptr;
 
@@ -791,3 +1187,15 @@ int GetColumnarStorageVersion()
 {
 	return columnar::STORAGE_VERSION;
 }
+
+
+void SetColumnarSubblockCacheLimit ( uint64_t uMaxBytes )
+{
+	columnar::SetSubblockCacheLimit(uMaxBytes);
+}
+
+
+void GetColumnarSubblockCacheStats ( columnar::SubblockCacheStats_t & tStats )
+{
+	columnar::GetSubblockCacheStats(tStats);
+}
@@ -21,6 +21,7 @@
 #include "common/filter.h"
 #include "common/schema.h"
 #include <functional>
+#include <atomic>
 
 namespace util
 {
@@ -30,7 +31,7 @@ namespace util
 namespace columnar
 {
 
-static const int LIB_VERSION = 16;
+static const int LIB_VERSION = 25;
 
 class Iterator_i
 {
@@ -43,6 +44,9 @@ public:
 
 	virtual	void		Fetch ( const util::Span_T<uint32_t> & dRowIDs, util::Span_T<int64_t> & dValues ) = 0;
 
+	// batched string/MVA fetch: appends values to dData and stores dRowIDs.size()+1 offsets (value i is [dOffsets[i],dOffsets[i+1]) in dData)
+	virtual	void		Fetch ( const util::Span_T<uint32_t> & dRowIDs, util::Span_T<int64_t> & dOffsets, std::vector<uint8_t> & dData ) = 0;
+
 	virtual	int			Get ( const uint8_t * & pData ) = 0;
 	virtual	uint8_t *	GetPacked() = 0;
 	virtual	int			GetLength() = 0;
@@ -68,6 +72,18 @@ struct IteratorHints_t
 };
 
 
+// bounds the amount of work analyzers do in one GetNextRowIdBlock call
+// with any of the budgets set, an analyzer may return an empty block (that is not the end of the results; call it again)
+struct AnalyzerLimits_t
+{
+	int							m_iMaxSubblocks = 0;		// return after scanning this many subblocks; 0 means no limit
+	int64_t						m_iMaxTimeUs = 0;			// return after spending this much time; 0 means no limit
+	const std::atomic<bool> *	m_pCancel = nullptr;		// checked between subblocks; once it is set, analyzers report the end of results
+
+	bool	IsBounded() const { return m_iMaxSubblocks>0 || m_iMaxTimeUs>0; }
+};
+
+
 struct IteratorCapabilities_t
 {
 	bool	m_bStringHashes = false;
@@ -80,12 +96,31 @@ struct Settings_t
 	int			m_iSubblockSize = 1024;
 	std::string	m_sCompressionUINT32 = "streamvbyte";
 	std::string	m_sCompressionUINT64 = "fastpfor128";
+	int			m_iBuildThreads = 1;	// builder-only, not stored in the file
+	bool		m_bTrialPacking = false;	// builder-only; encode int blocks with all suitable packings and keep the cheapest one
+	float		m_fDecodeCostWeight = 0.0f;	// builder-only; packing cost is size + weight*values*decode cost; 0 means 'smallest wins'
 
 	void		Load ( util::FileReader_c & tReader );
 	void		Save ( util::FileWriter_c & tWriter );
 	bool		Check ( util::FileReader_c & tReader, Reporter_fn & fnError );
 };
 
+struct ReaderSettings_t
+{
+	bool		m_bMmap = false;	// map the whole file once; iterators and analyzers read from the mapping instead of using their own buffers
+};
+
+
+struct SubblockCacheStats_t
+{
+	uint64_t	m_uMemUsed = 0;
+	uint64_t	m_uMemLimit = 0;
+	uint64_t	m_uEntries = 0;
+	uint64_t	m_uHits = 0;
+	uint64_t	m_uMisses = 0;
+	uint64_t	m_uEvictions = 0;
+};
+
 
 class Columnar_i
 {
@@ -93,12 +128,15 @@ public:
 	virtual					~Columnar_i() = default;
 
 	virtual Iterator_i *	CreateIterator ( const std::string & sName, const IteratorHints_t & tHints, columnar::IteratorCapabilities_t * pCapabilities, std::string & sError ) const = 0;
-	virtual std::vector<common::BlockIterator_i *> CreateAnalyzerOrPrefilter ( const std::vector<common::Filter_t> & dFilters, std::vector<int> & dDeletedFilters, const BlockTester_i & tBlockTester ) const = 0;
+	virtual std::vector<common::BlockIterator_i *> CreateAnalyzerOrPrefilter ( const std::vector<common::Filter_t> & dFilters, std::vector<int> & dDeletedFilters, const BlockTester_i & tBlockTester, const AnalyzerLimits_t & tLimits ) const = 0;
 	virtual int				GetAttributeId ( const std::string & sName ) const = 0;
 	virtual common::AttrType_e GetType ( const std::string & sName ) const = 0;
 
 	virtual bool			EarlyReject ( const std::vector<common::Filter_t> & dFilters, const BlockTester_i & tBlockTester ) const = 0;
 	virtual bool			IsFilterDegenerate ( const common::Filter_t & tFilter ) const = 0;
+
+	// unloads minmax trees that were not used since the previous call; they are reloaded on demand
+	virtual void			UnloadColdMinMax() = 0;
 };
 
 } // namespace columnar
@@ -106,9 +144,11 @@ public:
 
 extern "C"
 {
-	DLLEXPORT columnar::Columnar_i *	CreateColumnarStorageReader ( const std::string & sFilename, uint32_t uTotalDocs, std::string & sError );
+	DLLEXPORT columnar::Columnar_i *	CreateColumnarStorageReader ( const std::string & sFilename, uint32_t uTotalDocs, const columnar::ReaderSettings_t & tSettings, std::string & sError );
 	DLLEXPORT void						CheckColumnarStorage ( const std::string & sFilename, uint32_t uNumRows, columnar::Reporter_fn & fnError, columnar::Reporter_fn & fnProgress );
 	DLLEXPORT int						GetColumnarLibVersion();
 	DLLEXPORT const char *				GetColumnarLibVersionStr();
 	DLLEXPORT int						GetColumnarStorageVersion();
+	DLLEXPORT void						SetColumnarSubblockCacheLimit ( uint64_t uMaxBytes );	// 0 disables the cache of decoded subblocks
+	DLLEXPORT void						GetColumnarSubblockCacheStats ( columnar::SubblockCacheStats_t & tStats );
 }
@@ -45,6 +45,7 @@ struct SchemaAttr_t
 	std::string		m_sName;
 	AttrType_e		m_eType = AttrType_e::NONE;
 	StringHash_fn	m_fnCalcHash = nullptr;
+	bool			m_bBloomFilter = false;	// columnar-only; build per-subblock bloom filters (strings need m_fnCalcHash)
 };
 
 using Schema_t = std::vector<SchemaAttr_t>;
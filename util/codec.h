@@ -18,6 +18,8 @@
 
 #include "util.h"
 
+#include <algorithm>
+
 namespace util
 {
 
@@ -37,6 +39,59 @@ void BitPack ( const std::vector<uint32_t> & dValues, std::vector<uint32_t> & dP
 void BitUnpack ( const std::vector<uint32_t> & dPacked, std::vector<uint32_t> & dValues, int iBits );
 void BitUnpack ( const util::Span_T<uint32_t> & dPacked, util::Span_T<uint32_t> & dValues, int iBits );
 
+// frame-of-reference packing: (value-min) stored with a fixed bit width in sequential (non-interleaved) 64-bit words
+// value N starts at bit N*iBits, so any single value can be unpacked with a shift and a mask
+FORCE_INLINE uint64_t UnpackValueFOR ( uint64_t uLo, uint64_t uHi, int iShift, int iBits )
+{
+	uint64_t uValue = uLo >> iShift;
+	if ( iShift+iBits > 64 )
+		uValue |= uHi << ( 64-iShift );
+
+	return iBits==64 ? uValue : uValue & ( ( (uint64_t)1 << iBits ) - 1 );
+}
+
+template <typename T>
+void PackFOR ( const util::Span_T<T> & dValues, T tMin, int iBits, std::vector<uint64_t> & dPacked )
+{
+	dPacked.resize ( ( dValues.size()*iBits + 63 ) >> 6 );
+	std::fill ( dPacked.begin(), dPacked.end(), 0 );
+	if ( !iBits )
+		return;
+
+	uint64_t uBit = 0;
+	for ( auto i : dValues )
+	{
+		uint64_t uValue = uint64_t ( T ( i-tMin ) );
+		size_t tWord = size_t ( uBit>>6 );
+		int iShift = int ( uBit & 63 );
+		dPacked[tWord] |= uValue << iShift;
+		if ( iShift+iBits > 64 )
+			dPacked[tWord+1] |= uValue >> ( 64-iShift );
+
+		uBit += iBits;
+	}
+}
+
+template <typename T>
+void UnpackFOR ( const uint64_t * pPacked, util::Span_T<T> & dValues, int iBits, T tMin )
+{
+	if ( !iBits )
+	{
+		std::fill ( dValues.begin(), dValues.end(), tMin );
+		return;
+	}
+
+	uint64_t uBit = 0;
+	for ( auto & i : dValues )
+	{
+		size_t tWord = size_t ( uBit>>6 );
+		int iShift = int ( uBit & 63 );
+		uint64_t uHi = iShift+iBits > 64 ? pPacked[tWord+1] : 0;
+		i = tMin + (T)UnpackValueFOR ( pPacked[tWord], uHi, iShift, iBits );
+		uBit += iBits;
+	}
+}
+
 IntCodec_i * CreateIntCodec ( const std::string & sCodec32, const std::string & sCodec64 );
 
 } // namespace util
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "util.h"
+#include <type_traits>
 
 namespace util
 {
@@ -28,4 +29,20 @@ void	ComputeInverseDeltas ( util::Span_T<uint64_t> & dData, bool bAsc );
 void	ComputeInverseDeltas ( std::vector<uint32_t> & dData, bool bAsc );
 void	ComputeInverseDeltas ( std::vector<uint64_t> & dData, bool bAsc );
 
+// maps signed deltas (stored as unsigned) to small unsigned values: 0, -1, 1, -2, 2...
+template <typename T>
+inline void ZigzagEncode ( T * pData, size_t tLength )
+{
+	using SIGNED = typename std::make_signed<T>::type;
+	for ( size_t i = 0; i < tLength; i++ )
+		pData[i] = T ( pData[i] << 1 ) ^ T ( SIGNED(pData[i]) >> ( sizeof(T)*8-1 ) );
+}
+
+template <typename T>
+inline void ZigzagDecode ( T * pData, size_t tLength )
+{
+	for ( size_t i = 0; i < tLength; i++ )
+		pData[i] = ( pData[i] >> 1 ) ^ ( T(0) - ( pData[i] & 1 ) );
+}
+
 } // namespace util
@@ -86,6 +86,16 @@ FileReader_c::FileReader_c ( int iFD, size_t tBufferSize )
 }
 
 
+FileReader_c::FileReader_c ( const uint8_t * pMapped, size_t tSize )
+	: m_pData ( const_cast<uint8_t*>(pMapped) )
+	, m_tSize ( tSize )
+	, m_tUsed ( tSize )
+	, m_bMapped ( true )
+{
+	assert ( pMapped );
+}
+
+
 bool FileReader_c::Open ( const std::string & sName, std::string & sError )
 {
 	return Open ( sName, DEFAULT_SIZE, sError );
@@ -141,11 +151,41 @@ void FileReader_c::Read ( uint8_t * pData, size_t tLen )
 			return;
 	}
 
-	memcpy ( pDst, m_pData.get()+m_tPtr, tLen );
+	if ( m_bMapped && m_tPtr+tLen > m_tUsed )
+	{
+		m_bError = true;
+		m_sError = "read past the end of mapped file";
+		return;
+	}
+
+	memcpy ( pDst, m_pData+m_tPtr, tLen );
 	m_tPtr += tLen;
 }
 
 
+void FileReader_c::Prefetch ( int64_t iOffset, int64_t iSize ) const
+{
+	if ( iSize<=0 )
+		return;
+
+#ifndef _MSC_VER
+	if ( m_bMapped )
+	{
+		// the mapping starts at a page boundary; madvise needs page-aligned addresses
+		static const int64_t iPageSize = sysconf(_SC_PAGESIZE);
+		int64_t iStart = iOffset & ~( iPageSize-1 );
+		int64_t iEnd = std::min ( iOffset+iSize, (int64_t)m_tSize );
+		if ( iStart<iEnd )
+			madvise ( m_pData+iStart, iEnd-iStart, MADV_WILLNEED );
+	}
+#if HAVE_POSIX_FADVISE
+	else if ( m_iFD>=0 )
+		posix_fadvise ( m_iFD, iOffset, iSize, POSIX_FADV_WILLNEED );
+#endif
+#endif
+}
+
+
 std::string FileReader_c::Read_string()
 {
 	uint32_t uLen = Read_uint32();
@@ -173,12 +213,30 @@ uint64_t FileReader_c::Unpack_uint64()
 
 bool FileReader_c::ReadToBuffer()
 {
+	int64_t iNewFilePos = m_iFilePos + std::min ( m_tPtr, m_tUsed );
+
+	// the whole mapped file is the buffer; just point it back to the whole file after a seek
+	if ( m_bMapped )
+	{
+		if ( iNewFilePos>=(int64_t)m_tSize )
+		{
+			m_tPtr = m_tUsed = 0;
+			m_bError = true;
+			m_sError = "read past the end of mapped file";
+			return false;
+		}
+
+		m_iFilePos = 0;
+		m_tUsed = m_tSize;
+		m_tPtr = (size_t)iNewFilePos;
+		return true;
+	}
+
 	assert ( m_iFD>=0 );
 
 	CreateBuffer();
 
-	int64_t iNewFilePos = m_iFilePos + std::min ( m_tPtr, m_tUsed );
-	int iRead = PreadWrapper ( m_iFD, m_pData.get(), m_tSize, iNewFilePos );
+	int iRead = PreadWrapper ( m_iFD, m_pData, m_tSize, iNewFilePos );
 	if ( iRead<0 )
 	{
 		m_tPtr = m_tUsed = 0;
@@ -196,6 +254,9 @@ bool FileReader_c::ReadToBuffer()
 
 int64_t FileReader_c::GetFileSize()
 {
+	if ( m_bMapped )
+		return (int64_t)m_tSize;
+
 	return util::GetFileSize ( m_iFD, &m_sError );
 }
 
@@ -266,7 +327,10 @@ bool MMapOpen ( const std::string & sFile, std::string & sError, MappedBufferDat
 
 	int iFD = ::open ( sFile.c_str(), O_RDONLY | O_BINARY, 0644 );
 	if ( iFD<0 )
+	{
+		sError = FormatStr ( "failed to open file '%s': %s", sFile.c_str(), strerror(errno) );
 		return false;
+	}
 	tBuf.m_iFD = iFD;
 
 	tBuf.m_iBytesCount = GetFileSize ( iFD, &sError );
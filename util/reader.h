@@ -27,6 +27,7 @@ class FileReader_c
 public:
 							FileReader_c() = default;
 	explicit				FileReader_c ( int iFD, size_t tBufferSize = DEFAULT_SIZE );
+							FileReader_c ( const uint8_t * pMapped, size_t tSize );	// reads from a memory-mapped file; no buffer, no copying in ReadFromBuffer
 							~FileReader_c() { Close(); }
 
 	bool					Open ( const std::string & sName, std::string & sError );
@@ -39,6 +40,7 @@ public:
 	int64_t					GetFileSize();
 
 	void					Read ( uint8_t * pData, size_t tLen );
+	void					Prefetch ( int64_t iOffset, int64_t iSize ) const;	// async read-ahead hint; doesn't move the read position
 
 	FORCE_INLINE uint8_t	Read_uint8()
 	{
@@ -65,7 +67,7 @@ public:
 		if ( m_tPtr+tLen > m_tUsed )
 			return false;
 
-		pData = m_pData.get()+m_tPtr;
+		pData = m_pData+m_tPtr;
 		m_tPtr += tLen;
 		return true;
 	}
@@ -90,13 +92,15 @@ private:
 	bool        m_bOpened = false;
 	std::string m_sFile;
 
-	std::unique_ptr<uint8_t[]> m_pData;
+	uint8_t *   m_pData = nullptr;
+	std::unique_ptr<uint8_t[]> m_pBuffer;
 	size_t      m_tSize = DEFAULT_SIZE;
 	size_t      m_tUsed = 0;
 	size_t      m_tPtr = 0;
 
 	int64_t     m_iFilePos = 0;
 
+	bool        m_bMapped = false;
 	bool        m_bError = false;
 	std::string m_sError;
 
@@ -107,7 +111,8 @@ private:
 		if ( m_pData )
 			return;
 
-		m_pData = std::unique_ptr<uint8_t[]> ( new uint8_t[m_tSize] );
+		m_pBuffer = std::unique_ptr<uint8_t[]> ( new uint8_t[m_tSize] );
+		m_pData = m_pBuffer.get();
 	}
 
 	FORCE_INLINE void CopyTail ( uint8_t * & pDst, size_t & tLen )
@@ -116,7 +121,7 @@ private:
 			return;
 
 		int iToCopy = int ( m_tUsed-m_tPtr );
-		memcpy ( pDst, m_pData.get() + m_tPtr, iToCopy );
+		memcpy ( pDst, m_pData + m_tPtr, iToCopy );
 		m_tPtr += iToCopy;
 		pDst += iToCopy;
 		tLen -= iToCopy;
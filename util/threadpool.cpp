@@ -0,0 +1,129 @@
+// Copyright (c) 2020-2022, Manticore Software LTD (https://manticoresearch.com)
+// All rights reserved
+//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "threadpool.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <cassert>
+
+namespace util
+{
+
+class ThreadPool_c : public ThreadPool_i
+{
+public:
+					ThreadPool_c ( int iThreads );
+					~ThreadPool_c() override;
+
+	void			Enqueue ( std::function<void()> fnJob ) override;
+	void			Wait() override;
+	int				GetNumThreads() const override { return (int)m_dThreads.size(); }
+
+private:
+	std::vector<std::thread>			m_dThreads;
+	std::deque<std::function<void()>>	m_dJobs;
+	std::mutex							m_tLock;
+	std::condition_variable				m_tJobAdded;
+	std::condition_variable				m_tJobDone;
+	int									m_iPending = 0;
+	bool								m_bShutdown = false;
+
+	void			WorkerLoop();
+};
+
+
+ThreadPool_c::ThreadPool_c ( int iThreads )
+{
+	assert ( iThreads>0 );
+	m_dThreads.reserve(iThreads);
+	for ( int i = 0; i < iThreads; i++ )
+		m_dThreads.emplace_back ( [this]{ WorkerLoop(); } );
+}
+
+
+ThreadPool_c::~ThreadPool_c()
+{
+	{
+		std::unique_lock<std::mutex> tLock(m_tLock);
+		m_bShutdown = true;
+	}
+
+	m_tJobAdded.notify_all();
+	for ( auto & i : m_dThreads )
+		i.join();
+}
+
+
+void ThreadPool_c::Enqueue ( std::function<void()> fnJob )
+{
+	{
+		std::unique_lock<std::mutex> tLock(m_tLock);
+		m_dJobs.push_back ( std::move(fnJob) );
+		m_iPending++;
+	}
+
+	m_tJobAdded.notify_one();
+}
+
+
+void ThreadPool_c::Wait()
+{
+	std::unique_lock<std::mutex> tLock(m_tLock);
+	m_tJobDone.wait ( tLock, [this]{ return !m_iPending; } );
+}
+
+
+void ThreadPool_c::WorkerLoop()
+{
+	while ( true )
+	{
+		std::function<void()> fnJob;
+
+		{
+			std::unique_lock<std::mutex> tLock(m_tLock);
+			m_tJobAdded.wait ( tLock, [this]{ return m_bShutdown || !m_dJobs.empty(); } );
+			if ( m_dJobs.empty() )
+				return;
+
+			fnJob = std::move ( m_dJobs.front() );
+			m_dJobs.pop_front();
+		}
+
+		fnJob();
+
+		bool bAllDone = false;
+		{
+			std::unique_lock<std::mutex> tLock(m_tLock);
+			bAllDone = !--m_iPending;
+		}
+
+		if ( bAllDone )
+			m_tJobDone.notify_all();
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ThreadPool_i * CreateThreadPool ( int iThreads )
+{
+	return new ThreadPool_c(iThreads);
+}
+
+} // namespace util
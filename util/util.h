@@ -27,6 +27,10 @@
 #include <climits>
 #include <assert.h>
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 namespace util
 {
 
@@ -293,7 +297,7 @@ public:
 
 	void    Write_uint8 ( uint8_t uValue ) { m_dData.push_back(uValue); }
 	void    Write_uint16 ( uint16_t uValue ) { WriteValue(uValue); }
-	void    Write_uint32 ( uint64_t uValue ) { WriteValue(uValue); }
+	void    Write_uint32 ( uint32_t uValue ) { WriteValue(uValue); }
 	void    Write_uint64 ( uint64_t uValue ) { WriteValue(uValue); }
 
 	void    Pack_uint32 ( uint32_t uValue ) { PackValue(uValue); }
@@ -389,6 +393,29 @@ inline float to_type<float> ( int64_t iValue )
 }
 
 int     CalcNumBits ( uint64_t uNumber );
+
+// index of the lowest set bit; the value must be non-zero
+FORCE_INLINE int BitScanForward ( uint64_t uValue )
+{
+	assert ( uValue );
+#ifdef _MSC_VER
+	unsigned long uIndex = 0;
+	_BitScanForward64 ( &uIndex, uValue );
+	return (int)uIndex;
+#else
+	return __builtin_ctzll(uValue);
+#endif
+}
+
+FORCE_INLINE int PopCount ( uint64_t uValue )
+{
+#ifdef _MSC_VER
+	return (int)__popcnt64(uValue);
+#else
+	return __builtin_popcountll(uValue);
+#endif
+}
+
 bool    CopySingleFile ( const std::string & sSource, const std::string & sDest, std::string & sError, int iMode );
 
 template<typename VEC>